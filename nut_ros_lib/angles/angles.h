@@ -6,12 +6,14 @@
 **/
 #pragma once
 
-#include "./../nut_generic.h"
+#include "./../nut_generic_core.h"
 
 namespace nut_ros
 {
     /**
      * @brief 角度計算クラス
+     * @details 正規化はfmodを使わずfloorによる範囲縮小で求める（|angle| < 4*piではfmodによる実装と同等の精度で，それ以上でも誤差は丸め程度）
+     *          各関数には配列版（float, double）があり，fastSin(), fastCos(), fastAtan2()は誤差を許容できる場合の近似版
     **/
     class Angles
     {
@@ -44,10 +46,7 @@ namespace nut_ros
         **/
         static inline double normalizePositive(double angle)
         {
-            const double result = fmod(angle, 2.0 * M_PI);
-            if (result < 0)
-                return result + 2.0 * M_PI;
-            return result;
+            return normalizePositiveImpl(angle);
         }
 
         /**
@@ -57,10 +56,7 @@ namespace nut_ros
         **/
         static inline double normalize(double angle)
         {
-            const double result = fmod(angle + M_PI, 2.0 * M_PI);
-            if (result <= 0.0)
-                return result + M_PI;
-            return result - M_PI;
+            return normalizeImpl(angle);
         }
 
         /**
@@ -81,17 +77,258 @@ namespace nut_ros
         **/
         static inline double complement(double angle)
         {
-            //check input conditions
-            if (angle > 2 * M_PI || angle < -2.0 * M_PI)
-                angle = fmod(angle, 2.0 * M_PI);
-            if (angle < 0)
-                return (2 * M_PI + angle);
-            else if (angle > 0)
-                return (-2 * M_PI + angle);
+            return complementImpl(angle);
+        }
+
+        /**
+         * @brief sinの近似値を返す
+         * @details piの整数倍を引いて[-pi/2, pi/2]に縮小し，多項式（11次）で求める
+         *          縮小は加減算と乗算のみで行い（floor()などのライブラリ呼び出しも分岐も表もない），配列版は自動ベクトル化される
+         *          最大誤差は約6e-8（double），約2e-7（float）
+         * @param angle: 入力角度[rad]（|angle| < 1e6 程度まで）
+         * @return sin(angle)の近似値
+        **/
+        template <typename T>
+        static inline T fastSin(T angle)
+        {
+            // angle = k*pi + r（|r| <= pi/2）とすると sin(angle) = (-1)^k * sin(r)
+            const T k = roundToInteger(angle * (T)INV_PI);
+            const T r = (angle - k * (T)PI_HI) - k * (T)PI_LO;
+            return getParitySign(k) * sinPolynomial(r);
+        }
+
+        /**
+         * @brief cosの近似値を返す
+         * @details pi/2の奇数倍を引いて[-pi/2, pi/2]に縮小し，sinの多項式（11次）で求める（縮小の方法はfastSin()と同じ）
+         *          最大誤差は約6e-8（double），約2e-7（float）
+         * @param angle: 入力角度[rad]（|angle| < 1e6 程度まで）
+         * @return cos(angle)の近似値
+        **/
+        template <typename T>
+        static inline T fastCos(T angle)
+        {
+            // angle = (k + 1/2)*pi + r（|r| <= pi/2）とすると cos(angle) = -(-1)^k * sin(r)
+            const T k = roundToInteger(angle * (T)INV_PI - (T)0.5);
+            const T h = k + (T)0.5;
+            const T r = (angle - h * (T)PI_HI) - h * (T)PI_LO;
+            return -getParitySign(k) * sinPolynomial(r);
+        }
+
+        /**
+         * @brief atan2の近似値を返す
+         * @details [0, 1]の多項式（9次，Abramowitz and Stegun 4.4.49）で求める
+         *          最大誤差は約1.2e-5[rad]で，std::atan2()より数倍速い．y, xがともにゼロの場合はゼロを返す
+         * @param y: y座標
+         * @param x: x座標
+         * @return atan2(y, x)の近似値[rad]（-pi～+pi）
+        **/
+        template <typename T>
+        static inline T fastAtan2(T y, T x)
+        {
+            const T ax = std::abs(x);
+            const T ay = std::abs(y);
+            const T min = std::min(ax, ay);
+            const T max = std::max(ax, ay);
+            const T a = max > 0 ? min / max : 0;
+            const T s = a * a;
+            T r = a * ((T)0.9998660 + s * ((T)-0.3302995 + s * ((T)0.1801410 + s * ((T)-0.0851330 + s * (T)0.0208351))));
+            r = ay > ax ? (T)M_PI_2 - r : r;
+            r = x < 0 ? (T)M_PI - r : r;
+            return std::copysign(r, y);
+        }
+
+        /**
+         * @brief 配列の各要素を[deg]から[rad]へ
+         * @param degrees: 入力角度[deg]の配列
+         * @param out: 出力角度[rad]の出力先（degreesと同じでもよい）
+         * @param n: 要素数
+        **/
+        template <typename T>
+        static inline void radians(const T *degrees, T *out, size_t n)
+        {
+            const T k = (T)(M_PI / 180.0);
+            for (size_t i = 0; i < n; ++i)
+                out[i] = degrees[i] * k;
+        }
+
+        /**
+         * @brief 配列の各要素を[rad]から[deg]へ
+         * @param radians: 入力角度[rad]の配列
+         * @param out: 出力角度[deg]の出力先（radiansと同じでもよい）
+         * @param n: 要素数
+        **/
+        template <typename T>
+        static inline void degrees(const T *radians, T *out, size_t n)
+        {
+            const T k = (T)(180.0 / M_PI);
+            for (size_t i = 0; i < n; ++i)
+                out[i] = radians[i] * k;
+        }
+
+        /**
+         * @brief 配列の各要素を0～2*piに正規化
+         * @param angle: 入力角度[rad]の配列
+         * @param out: 0～2*piに正規化された角度[rad]の出力先（angleと同じでもよい）
+         * @param n: 要素数
+        **/
+        template <typename T>
+        static inline void normalizePositive(const T *angle, T *out, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                out[i] = normalizePositiveImpl(angle[i]);
+        }
+
+        /**
+         * @brief 配列の各要素を-piから+piに正規化する
+         * @param angle: 入力角度[rad]の配列
+         * @param out: -pi～+piに正規化された角度[rad]の出力先（angleと同じでもよい）
+         * @param n: 要素数
+        **/
+        template <typename T>
+        static inline void normalize(const T *angle, T *out, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                out[i] = normalizeImpl(angle[i]);
+        }
+
+        /**
+         * @brief 配列の各要素について2つの角度の最短角度を求める 範囲は-pi <= result <= pi
+         * @param from: 始点角度[rad]の配列
+         * @param to: 終点角度[rad]の配列
+         * @param out: 最短角度[rad]の出力先（from, toと同じでもよい）
+         * @param n: 要素数
+        **/
+        template <typename T>
+        static inline void getShortestAngle(const T *from, const T *to, T *out, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                out[i] = normalizeImpl(to[i] - from[i]);
+        }
+
+        /**
+         * @brief 配列の各要素について単位円に沿って逆方向への角度を求める
+         * @param angle: 入力角度[rad]の配列
+         * @param out: 単位円に沿って逆方向への角度[rad]の出力先（angleと同じでもよい）
+         * @param n: 要素数
+        **/
+        template <typename T>
+        static inline void complement(const T *angle, T *out, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                out[i] = complementImpl(angle[i]);
+        }
 
-            return (2 * M_PI);
+        /**
+         * @brief 配列の各要素のsinの近似値を求める（誤差はfastSin()と同じ）
+         * @param angle: 入力角度[rad]の配列
+         * @param out: sinの近似値の出力先（angleと同じでもよい）
+         * @param n: 要素数
+        **/
+        template <typename T>
+        static inline void fastSin(const T *angle, T *out, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                out[i] = fastSin(angle[i]);
+        }
+
+        /**
+         * @brief 配列の各要素のcosの近似値を求める（誤差はfastCos()と同じ）
+         * @param angle: 入力角度[rad]の配列
+         * @param out: cosの近似値の出力先（angleと同じでもよい）
+         * @param n: 要素数
+        **/
+        template <typename T>
+        static inline void fastCos(const T *angle, T *out, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                out[i] = fastCos(angle[i]);
+        }
+
+        /**
+         * @brief 配列の各要素のatan2の近似値を求める（誤差はfastAtan2()と同じ）
+         * @param y: y座標の配列
+         * @param x: x座標の配列
+         * @param out: atan2の近似値[rad]の出力先（y, xと同じでもよい）
+         * @param n: 要素数
+        **/
+        template <typename T>
+        static inline void fastAtan2(const T *y, const T *x, T *out, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                out[i] = fastAtan2(y[i], x[i]);
         }
 
     private:
+        // 2*piを上位（整数倍が誤差なく計算できる桁数）と下位に分けたもの（Cody-Waiteの範囲縮小）
+        static constexpr double TWO_PI_HI = 6.28125;
+        static constexpr double TWO_PI_LO = 2.0 * M_PI - 6.28125;
+        static constexpr double INV_TWO_PI = 0.5 / M_PI;
+
+        // piを上位（8bit）と下位に分けたもの（fastSin(), fastCos()の範囲縮小用）
+        static constexpr double PI_HI = 3.140625;
+        static constexpr double PI_LO = M_PI - 3.140625;
+        static constexpr double INV_PI = 1.0 / M_PI;
+
+        // 最も近い整数に丸める（1.5 * 2^52を足して引くと仮数部から小数部が押し出される．|x| < 2^51）
+        // 基本命令セットのSSE2ではfloor()やnearbyint()がライブラリ呼び出しになるため，加減算のみで丸める
+        // -ffast-mathでは足して引く演算が打ち消されるため使用できない
+        static inline double roundToInteger(double x)
+        {
+            return (x + 6755399441055744.0) - 6755399441055744.0;
+        }
+
+        // floatの場合は1.5 * 2^23（|x| < 2^22）
+        static inline float roundToInteger(float x)
+        {
+            return (x + 12582912.0f) - 12582912.0f;
+        }
+
+        // (-1)^k（kは整数値）
+        template <typename T>
+        static inline T getParitySign(T k)
+        {
+            // kが奇数ならk - 2 * round(k / 2)は±1，偶数なら0
+            const T odd = k - (T)2 * roundToInteger(k * (T)0.5);
+            return (T)1 - (T)2 * std::abs(odd);
+        }
+
+        // angle - 2*pi*k（|k| <= 2，つまり|angle| < 4*pi 程度では正しく丸めた値になる）
+        template <typename T>
+        static inline T subtractTwoPi(T angle, T k)
+        {
+            return (angle - k * (T)TWO_PI_HI) - k * (T)TWO_PI_LO;
+        }
+
+        // fmodを使わない正規化（floorは1命令になり，分岐は条件付きの選択になるため配列版は自動ベクトル化される）
+        template <typename T>
+        static inline T normalizePositiveImpl(T angle)
+        {
+            const T result = subtractTwoPi(angle, std::floor(angle * (T)INV_TWO_PI));
+            return result < 0 ? result + (T)(2.0 * M_PI) : (result >= (T)(2.0 * M_PI) ? result - (T)(2.0 * M_PI) : result);
+        }
+
+        template <typename T>
+        static inline T normalizeImpl(T angle)
+        {
+            const T result = subtractTwoPi(angle, std::ceil(angle * (T)INV_TWO_PI - (T)0.5));
+            return result <= (T)-M_PI ? result + (T)(2.0 * M_PI) : (result > (T)M_PI ? result - (T)(2.0 * M_PI) : result);
+        }
+
+        template <typename T>
+        static inline T complementImpl(T angle)
+        {
+            // |angle| > 2*piの場合はfmod(angle, 2*pi)と同じく0方向に丸めて縮小する
+            const T k = std::trunc(angle * (T)INV_TWO_PI);
+            angle = std::abs(angle) > (T)(2.0 * M_PI) ? subtractTwoPi(angle, k) : angle;
+            return angle < 0 ? (T)(2.0 * M_PI) + angle : (angle > 0 ? (T)(-2.0 * M_PI) + angle : (T)(2.0 * M_PI));
+        }
+
+        // [-pi/2, pi/2]でのsin（テイラー展開11次，打ち切り誤差は最大(pi/2)^13/13! < 6e-8）
+        template <typename T>
+        static inline T sinPolynomial(T x)
+        {
+            const T x2 = x * x;
+            return x * ((T)1 + x2 * ((T)(-1.0 / 6) + x2 * ((T)(1.0 / 120) + x2 * ((T)(-1.0 / 5040) + x2 * ((T)(1.0 / 362880) + x2 * (T)(-1.0 / 39916800))))));
+        }
     };
 } // namespace nut_ros
@@ -0,0 +1,59 @@
+/**
+ * @file alloc_counter.h
+ * @brief ベンチマーク中の動的確保の回数の計測
+**/
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nut_ros_benchmark {
+/**
+ * @brief プログラム開始からのoperator newの呼び出し回数を返す（alloc_counter.cppで置き換えたoperator newで数える）
+ * @return 呼び出し回数
+ */
+size_t getAllocationCount();
+
+/**
+ * @brief スコープ内の動的確保の回数を要素1個あたり（関数1回の呼び出しあたり）の値としてカウンタ"allocs"に記録する
+ * @details 処理した要素数（items_per_second）も同時に記録する．countersへの追加自体も確保を伴うため，
+ *          ループの後でSetItemsProcessed()などを呼ばずにこのクラスに任せること
+ * @code
+ * static void BM_Foo(benchmark::State &state)
+ * {
+ *     nut_ros_benchmark::AllocationCounter allocs(state, n);
+ *     for (auto _ : state)
+ *         benchmark::DoNotOptimize(foo(n));
+ * }
+ * @endcode
+**/
+class AllocationCounter
+{
+public:
+    /**
+     * @brief コンストラクタ（計測を開始する）
+     * @param state: ベンチマークの状態
+     * @param items_per_iteration: 1イテレーションで処理する要素数（計測する関数の呼び出し回数）
+     */
+    explicit AllocationCounter(benchmark::State &state, int64_t items_per_iteration = 1)
+        : _state(state), _items_per_iteration(items_per_iteration), _begin(getAllocationCount()) {}
+
+    ~AllocationCounter()
+    {
+        const size_t count = getAllocationCount() - _begin;
+        const int64_t items = _state.iterations() * _items_per_iteration;
+        _state.SetItemsProcessed(items);
+        _state.counters["allocs"] = items > 0 ? (double)count / (double)items : 0.0;
+    }
+
+    AllocationCounter(const AllocationCounter &) = delete;
+    AllocationCounter &operator=(const AllocationCounter &) = delete;
+
+private:
+    benchmark::State &_state;
+    int64_t _items_per_iteration;
+    size_t _begin;
+};
+}
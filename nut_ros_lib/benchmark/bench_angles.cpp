@@ -0,0 +1,136 @@
+/**
+ * @file bench_angles.cpp
+ * @brief Anglesのベンチマーク（fmodを使用した従来の実装，スカラ版，配列版，近似関数）
+**/
+#include "nut_ros_lib_core.h"
+#include "./alloc_counter.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace {
+const size_t N = 1024;
+
+// fmodを使用した従来の実装（比較用）
+namespace legacy {
+inline double normalizePositive(double angle)
+{
+    const double result = fmod(angle, 2.0 * M_PI);
+    if (result < 0)
+        return result + 2.0 * M_PI;
+    return result;
+}
+
+inline double normalize(double angle)
+{
+    const double result = fmod(angle + M_PI, 2.0 * M_PI);
+    if (result <= 0.0)
+        return result + M_PI;
+    return result - M_PI;
+}
+
+inline double getShortestAngle(double from, double to)
+{
+    return normalize(to - from);
+}
+}
+
+std::vector<double> makeAngles(unsigned int seed, double range)
+{
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> dist(-range, range);
+    std::vector<double> angles(N);
+    for (double &a : angles)
+        a = dist(engine);
+    return angles;
+}
+
+template <double (*F)(double)>
+void BM_Scalar(benchmark::State &state)
+{
+    const std::vector<double> in = makeAngles(1, 4 * M_PI);
+    std::vector<double> out(N);
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N; ++i)
+            out[i] = F(in[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+template <double (*F)(double, double)>
+void BM_Scalar2(benchmark::State &state)
+{
+    const std::vector<double> a = makeAngles(1, 4 * M_PI);
+    const std::vector<double> b = makeAngles(2, 4 * M_PI);
+    std::vector<double> out(N);
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N; ++i)
+            out[i] = F(a[i], b[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+template <void (*F)(const double *, double *, size_t)>
+void BM_Array(benchmark::State &state)
+{
+    const std::vector<double> in = makeAngles(1, 4 * M_PI);
+    std::vector<double> out(N);
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        F(in.data(), out.data(), N);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+template <void (*F)(const double *, const double *, double *, size_t)>
+void BM_Array2(benchmark::State &state)
+{
+    const std::vector<double> a = makeAngles(1, 4 * M_PI);
+    const std::vector<double> b = makeAngles(2, 4 * M_PI);
+    std::vector<double> out(N);
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        F(a.data(), b.data(), out.data(), N);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+double stdSin(double x) { return std::sin(x); }
+double stdCos(double x) { return std::cos(x); }
+double stdAtan2(double y, double x) { return std::atan2(y, x); }
+}
+
+using nut_ros::Angles;
+
+// 正規化
+BENCHMARK_TEMPLATE(BM_Scalar, legacy::normalize)->Name("Angles/normalize/legacy_fmod");
+BENCHMARK_TEMPLATE(BM_Scalar, Angles::normalize)->Name("Angles/normalize/scalar");
+BENCHMARK_TEMPLATE(BM_Array, Angles::normalize<double>)->Name("Angles/normalize/array");
+BENCHMARK_TEMPLATE(BM_Scalar, legacy::normalizePositive)->Name("Angles/normalizePositive/legacy_fmod");
+BENCHMARK_TEMPLATE(BM_Scalar, Angles::normalizePositive)->Name("Angles/normalizePositive/scalar");
+BENCHMARK_TEMPLATE(BM_Array, Angles::normalizePositive<double>)->Name("Angles/normalizePositive/array");
+BENCHMARK_TEMPLATE(BM_Scalar2, legacy::getShortestAngle)->Name("Angles/getShortestAngle/legacy_fmod");
+BENCHMARK_TEMPLATE(BM_Scalar2, Angles::getShortestAngle)->Name("Angles/getShortestAngle/scalar");
+BENCHMARK_TEMPLATE(BM_Array2, Angles::getShortestAngle<double>)->Name("Angles/getShortestAngle/array");
+
+// 三角関数の近似
+BENCHMARK_TEMPLATE(BM_Scalar, stdSin)->Name("Angles/sin/std");
+BENCHMARK_TEMPLATE(BM_Scalar, Angles::fastSin<double>)->Name("Angles/sin/fastSin");
+BENCHMARK_TEMPLATE(BM_Array, Angles::fastSin<double>)->Name("Angles/sin/fastSin_array");
+BENCHMARK_TEMPLATE(BM_Scalar, stdCos)->Name("Angles/cos/std");
+BENCHMARK_TEMPLATE(BM_Scalar, Angles::fastCos<double>)->Name("Angles/cos/fastCos");
+BENCHMARK_TEMPLATE(BM_Array, Angles::fastCos<double>)->Name("Angles/cos/fastCos_array");
+BENCHMARK_TEMPLATE(BM_Scalar2, stdAtan2)->Name("Angles/atan2/std");
+BENCHMARK_TEMPLATE(BM_Scalar2, Angles::fastAtan2<double>)->Name("Angles/atan2/fastAtan2");
+BENCHMARK_TEMPLATE(BM_Array2, Angles::fastAtan2<double>)->Name("Angles/atan2/fastAtan2_array");
@@ -0,0 +1,276 @@
+/**
+ * @file bench_msg.cpp
+ * @brief MsgDecoder, MsgGenerator, PolygonMsgGeneratorのベンチマーク（ROSのメッセージ型が必要）
+ * @details std::vectorを返す従来の関数と，std::array, Vector2, Pose2Dを返す関数や既存のメッセージに書き込むfill()を比較する
+**/
+#include "type_handler/msg_decoder.h"
+#include "type_handler/msg_generator.h"
+#include "type_handler/polygon_msg_generator.h"
+#include "./alloc_counter.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+using nut_ros::MsgDecoder;
+using nut_ros::MsgGenerator;
+using nut_ros::PolygonMsgGenerator;
+using nut_ros::Pose2D;
+
+const size_t N = 256;
+const std::string FRAME_ID = "base_footprint_with_long_name"; // 短い文字列の最適化（SSO）に収まらない長さ
+
+std::vector<geometry_msgs::PoseStamped> makePoses()
+{
+    std::vector<geometry_msgs::PoseStamped> poses(N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        const double t = 0.01 * (double)i;
+        MsgGenerator::fill(poses[i], "map", std::cos(t), std::sin(t), 0.0, 0.01 * t, -0.02 * t, t);
+    }
+    return poses;
+}
+
+std::vector<geometry_msgs::Twist> makeTwists()
+{
+    std::vector<geometry_msgs::Twist> twists(N);
+    for (size_t i = 0; i < N; ++i)
+        MsgGenerator::fill(twists[i], 0.5, 0.1 * (double)(i % 7), 0.01 * (double)i);
+    return twists;
+}
+
+// 並進成分：std::vector（従来）
+void BM_DecodeLinearVector(benchmark::State &state)
+{
+    const std::vector<geometry_msgs::PoseStamped> poses = makePoses();
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+        for (const auto &pose : poses)
+            benchmark::DoNotOptimize(MsgDecoder::getLinearVector(pose));
+}
+
+// 並進成分：std::array
+void BM_DecodeLinearArray(benchmark::State &state)
+{
+    const std::vector<geometry_msgs::PoseStamped> poses = makePoses();
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+        for (const auto &pose : poses)
+            benchmark::DoNotOptimize(MsgDecoder::getLinearArray(pose));
+}
+
+// 並進成分：Vector2
+void BM_DecodeLinearVector2(benchmark::State &state)
+{
+    const std::vector<geometry_msgs::PoseStamped> poses = makePoses();
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+        for (const auto &pose : poses)
+            benchmark::DoNotOptimize(MsgDecoder::getLinearVector2(pose));
+}
+
+// クォータニオンからRoll, Pitch, Yaw：std::vector（従来）
+void BM_DecodeAngularVector(benchmark::State &state)
+{
+    const std::vector<geometry_msgs::PoseStamped> poses = makePoses();
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+        for (const auto &pose : poses)
+            benchmark::DoNotOptimize(MsgDecoder::getAngularVector(pose));
+}
+
+// クォータニオンからRoll, Pitch, Yaw：std::array
+void BM_DecodeAngularArray(benchmark::State &state)
+{
+    const std::vector<geometry_msgs::PoseStamped> poses = makePoses();
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+        for (const auto &pose : poses)
+            benchmark::DoNotOptimize(MsgDecoder::getAngularArray(pose));
+}
+
+// クォータニオンからYawのみ
+void BM_DecodeYaw(benchmark::State &state)
+{
+    const std::vector<geometry_msgs::PoseStamped> poses = makePoses();
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+        for (const auto &pose : poses)
+            benchmark::DoNotOptimize(MsgDecoder::getYaw(pose));
+}
+
+// x, y, yaw：std::vector（従来）
+void BM_Decode2DVector(benchmark::State &state)
+{
+    const std::vector<geometry_msgs::PoseStamped> poses = makePoses();
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+        for (const auto &pose : poses)
+            benchmark::DoNotOptimize(MsgDecoder::get2DVector(pose));
+}
+
+// x, y, yaw：std::array
+void BM_Decode2DArray(benchmark::State &state)
+{
+    const std::vector<geometry_msgs::PoseStamped> poses = makePoses();
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+        for (const auto &pose : poses)
+            benchmark::DoNotOptimize(MsgDecoder::get2DArray(pose));
+}
+
+// x, y, yaw：Pose2D
+void BM_DecodePose2D(benchmark::State &state)
+{
+    const std::vector<geometry_msgs::PoseStamped> poses = makePoses();
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+        for (const auto &pose : poses)
+            benchmark::DoNotOptimize(MsgDecoder::getPose2D(pose));
+}
+
+// Twist：std::vector（従来）とPose2D
+void BM_DecodeTwistVector(benchmark::State &state)
+{
+    const std::vector<geometry_msgs::Twist> twists = makeTwists();
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+        for (const auto &twist : twists)
+            benchmark::DoNotOptimize(MsgDecoder::get2DVector(twist));
+}
+
+void BM_DecodeTwistPose2D(benchmark::State &state)
+{
+    const std::vector<geometry_msgs::Twist> twists = makeTwists();
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+        for (const auto &twist : twists)
+            benchmark::DoNotOptimize(MsgDecoder::getPose2D(twist));
+}
+
+// 経路：1点ずつPose2Dに変換するのとPose2DArrayへの一括変換
+void BM_DecodePathScalar(benchmark::State &state)
+{
+    nav_msgs::Path path;
+    path.poses = makePoses();
+    std::vector<Pose2D<double>> out(N);
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N; ++i)
+            out[i] = MsgDecoder::getPose2D(path.poses[i]);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_DecodePathBatch(benchmark::State &state)
+{
+    nav_msgs::Path path;
+    path.poses = makePoses();
+    nut_ros::Pose2DArray<double> out;
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        MsgDecoder::getPose2DArray(path, out);
+        benchmark::DoNotOptimize(out.x.data());
+    }
+}
+
+// Roll, Pitch, Yawからクォータニオン
+void BM_QuaternionRPY(benchmark::State &state)
+{
+    geometry_msgs::Quaternion q;
+    double yaw = 0;
+    nut_ros_benchmark::AllocationCounter allocs(state);
+    for (auto _ : state)
+    {
+        MsgGenerator::fill(q, 0.01, -0.02, yaw);
+        benchmark::DoNotOptimize(q);
+        yaw += 1e-3;
+    }
+}
+
+void BM_QuaternionYaw(benchmark::State &state)
+{
+    geometry_msgs::Quaternion q;
+    double yaw = 0;
+    nut_ros_benchmark::AllocationCounter allocs(state);
+    for (auto _ : state)
+    {
+        MsgGenerator::fill(q, yaw);
+        benchmark::DoNotOptimize(q);
+        yaw += 1e-3;
+    }
+}
+
+// PoseStampedの生成：毎回生成（frame_idの文字列を確保する）と既存のメッセージへの書き込み
+void BM_GeneratePoseStamped(benchmark::State &state)
+{
+    const Pose2D<double> pose(1.0, 2.0, 0.5);
+    nut_ros_benchmark::AllocationCounter allocs(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(MsgGenerator::toPoseStamped(FRAME_ID, pose.x, pose.y, pose.theta));
+}
+
+void BM_FillPoseStamped(benchmark::State &state)
+{
+    const Pose2D<double> pose(1.0, 2.0, 0.5);
+    geometry_msgs::PoseStamped msg;
+    nut_ros_benchmark::AllocationCounter allocs(state);
+    for (auto _ : state)
+    {
+        MsgGenerator::fill(msg, FRAME_ID, pose);
+        benchmark::DoNotOptimize(msg);
+    }
+}
+
+// Twistの生成
+void BM_GenerateTwist(benchmark::State &state)
+{
+    const Pose2D<double> velocity(0.5, 0.0, 0.3);
+    nut_ros_benchmark::AllocationCounter allocs(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(MsgGenerator::toTwist(velocity));
+}
+
+// 楕円のポリゴン：毎回生成と既存のメッセージへの書き込み
+void BM_ToEllipse(benchmark::State &state)
+{
+    const int resolution = (int)state.range(0);
+    nut_ros_benchmark::AllocationCounter allocs(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(PolygonMsgGenerator::toEllipse(0.1f, 0.2f, 0.6f, 0.4f, resolution));
+}
+
+void BM_FillEllipse(benchmark::State &state)
+{
+    const int resolution = (int)state.range(0);
+    geometry_msgs::Polygon polygon;
+    nut_ros_benchmark::AllocationCounter allocs(state);
+    for (auto _ : state)
+    {
+        PolygonMsgGenerator::fillEllipse(polygon, 0.1f, 0.2f, 0.6f, 0.4f, resolution);
+        benchmark::DoNotOptimize(polygon.points.data());
+    }
+}
+}
+
+BENCHMARK(BM_DecodeLinearVector)->Name("MsgDecoder/linear/std_vector");
+BENCHMARK(BM_DecodeLinearArray)->Name("MsgDecoder/linear/std_array");
+BENCHMARK(BM_DecodeLinearVector2)->Name("MsgDecoder/linear/Vector2");
+BENCHMARK(BM_DecodeAngularVector)->Name("MsgDecoder/angular/std_vector");
+BENCHMARK(BM_DecodeAngularArray)->Name("MsgDecoder/angular/std_array");
+BENCHMARK(BM_DecodeYaw)->Name("MsgDecoder/angular/getYaw");
+BENCHMARK(BM_Decode2DVector)->Name("MsgDecoder/2D/std_vector");
+BENCHMARK(BM_Decode2DArray)->Name("MsgDecoder/2D/std_array");
+BENCHMARK(BM_DecodePose2D)->Name("MsgDecoder/2D/Pose2D");
+BENCHMARK(BM_DecodeTwistVector)->Name("MsgDecoder/twist/std_vector");
+BENCHMARK(BM_DecodeTwistPose2D)->Name("MsgDecoder/twist/Pose2D");
+BENCHMARK(BM_DecodePathScalar)->Name("MsgDecoder/path/scalar");
+BENCHMARK(BM_DecodePathBatch)->Name("MsgDecoder/path/Pose2DArray");
+BENCHMARK(BM_QuaternionRPY)->Name("MsgGenerator/quaternion/rpy");
+BENCHMARK(BM_QuaternionYaw)->Name("MsgGenerator/quaternion/yaw");
+BENCHMARK(BM_GeneratePoseStamped)->Name("MsgGenerator/pose_stamped/to");
+BENCHMARK(BM_FillPoseStamped)->Name("MsgGenerator/pose_stamped/fill");
+BENCHMARK(BM_GenerateTwist)->Name("MsgGenerator/twist/to");
+BENCHMARK(BM_ToEllipse)->Name("PolygonMsgGenerator/ellipse/to")->ArgName("resolution")->Arg(16)->Arg(64);
+BENCHMARK(BM_FillEllipse)->Name("PolygonMsgGenerator/ellipse/fill")->ArgName("resolution")->Arg(16)->Arg(64);
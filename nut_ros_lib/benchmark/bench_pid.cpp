@@ -0,0 +1,125 @@
+/**
+ * @file bench_pid.cpp
+ * @brief PIDのベンチマーク（実行時のモード指定，テンプレート引数でのモード固定，PIDBankによる一括計算）
+**/
+#include "nut_ros_lib_core.h"
+#include "./alloc_counter.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+using nut_ros::PID;
+using nut_ros::PIDBank;
+using nut_ros::PIDMode;
+using nut_ros::PIDSaturation;
+using nut_ros::PIDStaticMode;
+
+const size_t SAMPLES = 256; // 現在値の系列の長さ（定数畳み込みを防ぐ）
+const size_t CHANNELS = 8;  // PIDBankのチャンネル数
+
+nut_ros::PIDParam<double> makeParam(PIDMode mode)
+{
+    nut_ros::PIDParam<double> param;
+    param.mode = mode;
+    param.gain = {1.2, 0.5, 0.05};
+    param.need_saturation = true;
+    param.output_min = -10;
+    param.output_max = 10;
+    return param;
+}
+
+std::vector<double> makeSamples()
+{
+    std::vector<double> samples(SAMPLES);
+    for (size_t i = 0; i < SAMPLES; ++i)
+        samples[i] = std::sin(0.05 * (double)i);
+    return samples;
+}
+
+// 1回のupdate()あたりの時間
+template <class Controller>
+void runPID(benchmark::State &state, Controller &pid)
+{
+    const std::vector<double> samples = makeSamples();
+    pid.reset();
+    size_t i = 0;
+    nut_ros_benchmark::AllocationCounter allocs(state);
+    for (auto _ : state)
+    {
+        pid.update(1.0, samples[i], 0.001);
+        benchmark::DoNotOptimize(pid.getControlValue());
+        i = (i + 1) % SAMPLES;
+    }
+}
+
+// モードを実行時に指定（PID<T>）
+void BM_PIDRuntime(benchmark::State &state)
+{
+    PID<double> pid(makeParam((PIDMode)state.range(0)));
+    runPID(state, pid);
+}
+
+// モードと出力制限をテンプレート引数で固定
+template <PIDStaticMode M>
+void BM_PIDFixed(benchmark::State &state)
+{
+    PID<double, M, PIDSaturation::Yes> pid(makeParam((PIDMode)M));
+    runPID(state, pid);
+}
+
+// CHANNELS個のPID<T>を個別に更新（1チャンネルあたりの時間）
+void BM_PIDScalarChannels(benchmark::State &state)
+{
+    const std::vector<double> samples = makeSamples();
+    std::vector<PID<double>> pids(CHANNELS, PID<double>(makeParam((PIDMode)state.range(0))));
+    for (auto &pid : pids)
+        pid.reset();
+    size_t i = 0;
+    nut_ros_benchmark::AllocationCounter allocs(state, CHANNELS);
+    for (auto _ : state)
+    {
+        for (size_t ch = 0; ch < CHANNELS; ++ch)
+        {
+            pids[ch].update(1.0, samples[(i + ch) % SAMPLES], 0.001);
+            benchmark::DoNotOptimize(pids[ch].getControlValue());
+        }
+        i = (i + 1) % SAMPLES;
+    }
+}
+
+// PIDBankでCHANNELS個を一括更新（1チャンネルあたりの時間）
+void BM_PIDBank(benchmark::State &state)
+{
+    const std::vector<double> samples = makeSamples();
+    PIDBank<double, CHANNELS> bank;
+    for (size_t ch = 0; ch < CHANNELS; ++ch)
+        bank.setParam(ch, makeParam((PIDMode)state.range(0)));
+    std::array<double, CHANNELS> target, now_val;
+    target.fill(1.0);
+    size_t i = 0;
+    nut_ros_benchmark::AllocationCounter allocs(state, CHANNELS);
+    for (auto _ : state)
+    {
+        for (size_t ch = 0; ch < CHANNELS; ++ch)
+            now_val[ch] = samples[(i + ch) % SAMPLES];
+        bank.update(target, now_val, 0.001);
+        benchmark::DoNotOptimize(bank.getControlValues().data());
+        i = (i + 1) % SAMPLES;
+    }
+}
+
+void modes(benchmark::internal::Benchmark *b)
+{
+    b->ArgName("mode");
+    for (PIDMode mode : {PIDMode::pPID, PIDMode::sPID, PIDMode::PI_D, PIDMode::I_PD})
+        b->Arg((int64_t)mode);
+}
+}
+
+BENCHMARK(BM_PIDRuntime)->Name("PID/update/runtime")->Apply(modes);
+BENCHMARK_TEMPLATE(BM_PIDFixed, PIDStaticMode::pPID)->Name("PID/update/fixed/mode:0");
+BENCHMARK_TEMPLATE(BM_PIDFixed, PIDStaticMode::sPID)->Name("PID/update/fixed/mode:1");
+BENCHMARK_TEMPLATE(BM_PIDFixed, PIDStaticMode::PI_D)->Name("PID/update/fixed/mode:2");
+BENCHMARK_TEMPLATE(BM_PIDFixed, PIDStaticMode::I_PD)->Name("PID/update/fixed/mode:3");
+BENCHMARK(BM_PIDScalarChannels)->Name("PID/channels/scalar")->Apply(modes);
+BENCHMARK(BM_PIDBank)->Name("PID/channels/PIDBank")->Apply(modes);
@@ -0,0 +1,277 @@
+/**
+ * @file bench_vector.cpp
+ * @brief Vector2, Pose2D, Line2D, Line2DIndex, Vector2Array, ScanProjectorのベンチマーク（スカラ版と一括版の比較）
+**/
+#include "nut_ros_lib_core.h"
+#include "./alloc_counter.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace {
+using nut_ros::Line2D;
+using nut_ros::Line2DIndex;
+using nut_ros::Pose2D;
+using nut_ros::Vector2;
+using nut_ros::Vector2Array;
+
+const size_t N = 1024;
+
+std::vector<Vector2<double>> makeVectors(unsigned int seed)
+{
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> dist(-10, 10);
+    std::vector<Vector2<double>> v(N);
+    for (auto &p : v)
+        p.set(dist(engine), dist(engine));
+    return v;
+}
+
+std::vector<Pose2D<double>> makePoses(unsigned int seed, double range)
+{
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> dist(-range, range);
+    std::vector<Pose2D<double>> v(N);
+    for (auto &p : v)
+        p = Pose2D<double>(dist(engine), dist(engine), dist(engine));
+    return v;
+}
+
+// 短い線分を散らばらせた地図
+std::vector<Line2D<double>> makeMap(size_t count)
+{
+    std::mt19937 engine(3);
+    std::uniform_real_distribution<double> position(-10, 10), length(-0.5, 0.5);
+    std::vector<Line2D<double>> lines;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const double x = position(engine), y = position(engine);
+        lines.emplace_back(x, y, x + length(engine), y + length(engine));
+    }
+    return lines;
+}
+
+// Vector2の四則演算（a + b * s - c）
+void BM_Vector2Arithmetic(benchmark::State &state)
+{
+    const std::vector<Vector2<double>> a = makeVectors(1), b = makeVectors(2), c = makeVectors(3);
+    std::vector<Vector2<double>> out(N);
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N; ++i)
+            out[i] = a[i] + b[i] * 0.5 - c[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+// Vector2の長さと内積
+void BM_Vector2LengthDot(benchmark::State &state)
+{
+    const std::vector<Vector2<double>> a = makeVectors(1), b = makeVectors(2);
+    std::vector<double> out(N);
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N; ++i)
+            out[i] = a[i].length() + Vector2<double>::getDot(a[i], b[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+// Pose2Dの四則演算と距離
+void BM_Pose2DArithmetic(benchmark::State &state)
+{
+    const std::vector<Pose2D<double>> a = makePoses(1, 10), b = makePoses(2, 10);
+    std::vector<Pose2D<double>> out(N);
+    std::vector<double> distance(N);
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            out[i] = (a[i] + b[i]) / 2.0;
+            distance[i] = Pose2D<double>::getDistance(a[i], b[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::DoNotOptimize(distance.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+// 点群の回転と平行移動：Vector2ごと
+void BM_TransformScalar(benchmark::State &state)
+{
+    const std::vector<Vector2<double>> in = makeVectors(1);
+    std::vector<Vector2<double>> out(N);
+    const Vector2<double> offset(1.0, -2.0);
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            out[i] = in[i];
+            out[i].rotate(0.3);
+            out[i] += offset;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+// 点群の回転と平行移動：Vector2Arrayで一括
+void BM_TransformBatch(benchmark::State &state)
+{
+    const std::vector<Vector2<double>> in = makeVectors(1);
+    Vector2Array<double> points;
+    for (const auto &v : in)
+        points.push_back(v);
+    const Pose2D<double> pose(1.0, -2.0, 0.3);
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        points.transform(pose);
+        benchmark::DoNotOptimize(points.x.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+// Line2Dの交点
+void BM_Line2DIntersection(benchmark::State &state)
+{
+    const std::vector<Line2D<double>> a = makeMap(N), b = makeMap(N + 1);
+    size_t count = 0;
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            bool is_intersected;
+            Pose2D<double> p;
+            std::tie(is_intersected, p) = state.range(0) ? Line2D<double>::getIntersectionWithinRange(a[i], b[N - 1 - i])
+                                                         : Line2D<double>::getIntersection(a[i], b[N - 1 - i]);
+            count += is_intersected;
+            benchmark::DoNotOptimize(p);
+        }
+    }
+    benchmark::DoNotOptimize(count);
+}
+
+// Line2Dと点の距離
+void BM_Line2DDistance(benchmark::State &state)
+{
+    const std::vector<Line2D<double>> lines = makeMap(N);
+    const std::vector<Pose2D<double>> points = makePoses(4, 10);
+    std::vector<double> out(N);
+    nut_ros_benchmark::AllocationCounter allocs(state, N);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N; ++i)
+            out[i] = state.range(0) ? Line2D<double>::getDistanceFromPointToLineWithinRange(points[i], lines[i])
+                                    : Line2D<double>::getDistanceFromPointToLine(points[i], lines[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+// 最も近い線分：全線分を調べる（1点あたり）
+void BM_NearestLineScalar(benchmark::State &state)
+{
+    const std::vector<Line2D<double>> lines = makeMap((size_t)state.range(0));
+    const std::vector<Pose2D<double>> points = makePoses(5, 10);
+    size_t i = 0;
+    nut_ros_benchmark::AllocationCounter allocs(state);
+    for (auto _ : state)
+    {
+        size_t best = 0;
+        double best_distance = std::numeric_limits<double>::infinity();
+        for (size_t k = 0; k < lines.size(); ++k)
+        {
+            const double d = Line2D<double>::getDistanceFromPointToLineWithinRange(points[i], lines[k]);
+            if (d < best_distance)
+            {
+                best_distance = d;
+                best = k;
+            }
+        }
+        benchmark::DoNotOptimize(best);
+        i = (i + 1) % N;
+    }
+}
+
+// 最も近い線分：Line2DIndex（1点あたり）
+void BM_NearestLineIndex(benchmark::State &state)
+{
+    const Line2DIndex<double> index(makeMap((size_t)state.range(0)));
+    const std::vector<Pose2D<double>> points = makePoses(5, 10);
+    size_t i = 0;
+    nut_ros_benchmark::AllocationCounter allocs(state);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(index.getNearest(points[i]));
+        i = (i + 1) % N;
+    }
+}
+
+// レーザースキャンの点群への変換：ビームごとにcos, sinを計算
+void BM_ScanScalar(benchmark::State &state)
+{
+    const size_t beams = 1081;
+    const double angle_min = -3 * M_PI / 4, angle_increment = 1.5 * M_PI / (double)(beams - 1);
+    std::vector<float> ranges(beams);
+    for (size_t i = 0; i < beams; ++i)
+        ranges[i] = (float)(2.0 + std::sin(0.01 * (double)i));
+    const Pose2D<double> pose(0.2, 0.0, 0.1);
+    std::vector<Vector2<double>> points;
+    points.reserve(beams);
+    nut_ros_benchmark::AllocationCounter allocs(state, beams);
+    for (auto _ : state)
+    {
+        points.clear();
+        for (size_t i = 0; i < beams; ++i)
+        {
+            if (!(ranges[i] >= 0.1f && ranges[i] <= 30.0f))
+                continue;
+            const double angle = pose.theta + angle_min + angle_increment * (double)i;
+            points.emplace_back(pose.x + ranges[i] * std::cos(angle), pose.y + ranges[i] * std::sin(angle));
+        }
+        benchmark::DoNotOptimize(points.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+// レーザースキャンの点群への変換：ScanProjectorで一括
+void BM_ScanBatch(benchmark::State &state)
+{
+    const size_t beams = 1081;
+    const double angle_min = -3 * M_PI / 4, angle_increment = 1.5 * M_PI / (double)(beams - 1);
+    std::vector<float> ranges(beams);
+    for (size_t i = 0; i < beams; ++i)
+        ranges[i] = (float)(2.0 + std::sin(0.01 * (double)i));
+    const Pose2D<double> pose(0.2, 0.0, 0.1);
+    nut_ros::ScanProjector<double> projector(angle_min, angle_increment, beams);
+    Vector2Array<double> points;
+    nut_ros_benchmark::AllocationCounter allocs(state, beams);
+    for (auto _ : state)
+    {
+        projector.project(ranges.data(), beams, 0.1, 30.0, pose, points);
+        benchmark::DoNotOptimize(points.x.data());
+        benchmark::ClobberMemory();
+    }
+}
+}
+
+BENCHMARK(BM_Vector2Arithmetic)->Name("Vector2/arithmetic");
+BENCHMARK(BM_Vector2LengthDot)->Name("Vector2/length_dot");
+BENCHMARK(BM_Pose2DArithmetic)->Name("Pose2D/arithmetic_distance");
+BENCHMARK(BM_TransformScalar)->Name("Vector2/transform/scalar");
+BENCHMARK(BM_TransformBatch)->Name("Vector2/transform/Vector2Array");
+BENCHMARK(BM_Line2DIntersection)->Name("Line2D/intersection")->ArgName("within_range")->Arg(0)->Arg(1);
+BENCHMARK(BM_Line2DDistance)->Name("Line2D/distance")->ArgName("within_range")->Arg(0)->Arg(1);
+BENCHMARK(BM_NearestLineScalar)->Name("Line2D/nearest/scalar")->ArgName("lines")->Arg(64)->Arg(1024);
+BENCHMARK(BM_NearestLineIndex)->Name("Line2D/nearest/Line2DIndex")->ArgName("lines")->Arg(64)->Arg(1024);
+BENCHMARK(BM_ScanScalar)->Name("ScanProjector/project/scalar");
+BENCHMARK(BM_ScanBatch)->Name("ScanProjector/project/batch");
@@ -4,50 +4,95 @@
 **/
 #pragma once
 
-#include "./../nut_generic.h"
+#include "./../nut_generic_core.h"
 #include "./feedback_controller.h"
 
 namespace nut_ros
 {
+/**
+ * @brief PIDのモードリスト
+ */
+enum class PIDMode
+{
+    pPID = 0, /**< 位置型PID */
+    sPID,     /**< 速度型PID */
+    PI_D,     /**< 微分先行型PID */
+    I_PD      /**< 比例微分先行型PID */
+};
+
+/**
+ * @brief PIDのモードをテンプレート引数で固定するかどうか（テンプレート引数専用）
+ * @details Runtime以外はPIDModeの同名のモードに対応する
+ */
+enum class PIDStaticMode
+{
+    pPID = (int)PIDMode::pPID, /**< 位置型PIDに固定 */
+    sPID = (int)PIDMode::sPID, /**< 速度型PIDに固定 */
+    PI_D = (int)PIDMode::PI_D, /**< 微分先行型PIDに固定 */
+    I_PD = (int)PIDMode::I_PD, /**< 比例微分先行型PIDに固定 */
+    Runtime                    /**< 実行時にparam_t::mode, setMode()で指定 */
+};
+
+/**
+ * @brief PIDの出力制限の有無
+ */
+enum class PIDSaturation
+{
+    No = 0, /**< 出力制限を行わない */
+    Yes,    /**< 出力制限を行う */
+    Runtime /**< 実行時にparam_t::need_saturation, setSaturation()で指定 */
+};
+
+/**
+ * @brief PIDのゲイン構造体
+ */
+template <typename T>
+struct PIDGain
+{
+    T Kp; /**< 比例ゲイン */
+    T Ki; /**< 積分ゲイン */
+    T Kd; /**< 微分ゲイン */
+};
+
+/**
+ * @brief PIDのパラメータ構造体
+ */
+template <typename T>
+struct PIDParam
+{
+    PIDMode mode;         /**< PIDモード */
+    PIDGain<T> gain;      /**< PIDゲイン */
+    bool need_saturation; /**< 出力制限を行うか */
+    T output_min;         /**< 出力制限時の最小値 */
+    T output_max;         /**< 出力制限時の最大値 */
+};
+
 /**
  * @brief PIDの計算
+ * @details モードと出力制限の有無をテンプレート引数で固定すると（例: PID<double, PIDStaticMode::PI_D, PIDSaturation::Yes>）
+ *          update()の分岐がコンパイル時に解決される．省略した場合（PID<T>）は従来通り実行時に切り替えられる
+ * @tparam T: 数値型
+ * @tparam M: PIDモード（PIDStaticMode::Runtimeの場合は実行時に指定）
+ * @tparam S: 出力制限の有無（PIDSaturation::Runtimeの場合は実行時に指定）
 **/
-template <typename T>
+template <typename T, PIDStaticMode M = PIDStaticMode::Runtime, PIDSaturation S = PIDSaturation::Runtime>
 class PID : FeedbackController
 {
 public:
     /**
      * @brief モードリスト
      */
-    enum class Mode
-    {
-        pPID = 0, /**< 位置型PID */
-        sPID,     /**< 速度型PID */
-        PI_D,     /**< 微分先行型PID */
-        I_PD      /**< 比例微分先行型PID */
-    };
+    using Mode = PIDMode;
 
     /**
      * @brief ゲイン構造体
      */
-    struct gain_t
-    {
-        T Kp; /**< 比例ゲイン */
-        T Ki; /**< 積分ゲイン */
-        T Kd; /**< 微分ゲイン */
-    };
+    using gain_t = PIDGain<T>;
 
     /**
-     * @brief パラメータ構造体
+     * @brief パラメータ構造体（テンプレート引数M, Sが異なるPID間でも共通）
      */
-    struct param_t
-    {
-        Mode mode;            /**< PIDモード */
-        gain_t gain;          /**< PIDゲイン */
-        bool need_saturation; /**< 出力制限を行うか */
-        T output_min;         /**< 出力制限時の最小値 */
-        T output_max;         /**< 出力制限時の最大値 */
-    };
+    using param_t = PIDParam<T>;
 
     /**
      * @brief コンストラクタ
@@ -93,6 +138,7 @@ public:
     /**
      * @brief PIDモードの設定
      * @param mode: PIDモードenum
+     * @attention テンプレート引数でモードを固定している場合は無視される
      */
     inline void setMode(const Mode mode) { _param.mode = mode; }
 
@@ -100,6 +146,7 @@ public:
      * @brief 出力の最小，最大値の設定
      * @param min_v: 最小値
      * @param min_v: 最大値
+     * @attention テンプレート引数でPIDSaturation::Noを指定している場合は出力制限されない
      */
     inline void setSaturation(T min_v, T max_v);
 
@@ -132,8 +179,8 @@ private:
     T _output;
 };
 
-template <typename T>
-void PID<T>::reset()
+template <typename T, PIDStaticMode M, PIDSaturation S>
+void PID<T, M, S>::reset()
 {
     _diff.fill(0.0);
     _prev_val = _prev_target = 0.0;
@@ -141,20 +188,23 @@ void PID<T>::reset()
     _output = 0.0;
 }
 
-template <typename T>
-inline void PID<T>::setSaturation(T min_v, T max_v)
+template <typename T, PIDStaticMode M, PIDSaturation S>
+inline void PID<T, M, S>::setSaturation(T min_v, T max_v)
 {
     _param.need_saturation = true;
     _param.output_min = min_v;
     _param.output_max = max_v;
 }
 
-template <typename T>
-inline void PID<T>::update(T target, T now_val, T dt)
+template <typename T, PIDStaticMode M, PIDSaturation S>
+inline void PID<T, M, S>::update(T target, T now_val, T dt)
 {
     _diff[0] = target - now_val;                     // 最新の偏差
     _integral += (_diff[0] + _diff[1]) * (dt / 2.0); // 積分
-    switch (_param.mode)
+
+    // テンプレート引数で固定されている場合は定数となり分岐は畳み込まれる
+    const Mode mode = (M == PIDStaticMode::Runtime) ? _param.mode : (Mode)M;
+    switch (mode)
     {
     case Mode::pPID:
         _output = calculate_pPID(target, now_val, dt);
@@ -177,12 +227,13 @@ inline void PID<T>::update(T target, T now_val, T dt)
     _prev_val = now_val;
 
     // ガード処理
-    if (_param.need_saturation)
-        _output = (_param.need_saturation) ? Generic::guard<double>(_output, _param.output_min, _param.output_max) : _output;
+    const bool need_saturation = (S == PIDSaturation::Runtime) ? _param.need_saturation : (S == PIDSaturation::Yes);
+    if (need_saturation)
+        _output = Generic::guard<double>(_output, _param.output_min, _param.output_max);
 }
 
-template <typename T>
-inline T PID<T>::calculate_pPID(T target, T now_val, T dt)
+template <typename T, PIDStaticMode M, PIDSaturation S>
+inline T PID<T, M, S>::calculate_pPID(T target, T now_val, T dt)
 {
     T p = _param.gain.Kp * _diff[0];
     T i = _param.gain.Ki * _integral;
@@ -191,8 +242,8 @@ inline T PID<T>::calculate_pPID(T target, T now_val, T dt)
 }
 
 // 速度型PID
-template <typename T>
-inline T PID<T>::calculate_sPID(T target, T now_val, T dt)
+template <typename T, PIDStaticMode M, PIDSaturation S>
+inline T PID<T, M, S>::calculate_sPID(T target, T now_val, T dt)
 {
     T p = _param.gain.Kp * _diff[0] - _diff[1];
     T i = _param.gain.Ki * _diff[0] * dt;
@@ -201,8 +252,8 @@ inline T PID<T>::calculate_sPID(T target, T now_val, T dt)
 }
 
 // 微分先行型PID
-template <typename T>
-inline T PID<T>::calculate_PI_D(T target, T now_val, T dt)
+template <typename T, PIDStaticMode M, PIDSaturation S>
+inline T PID<T, M, S>::calculate_PI_D(T target, T now_val, T dt)
 {
     T p =  _param.gain.Kp * _diff[0];
     T i =  _param.gain.Ki * _integral;
@@ -211,8 +262,8 @@ inline T PID<T>::calculate_PI_D(T target, T now_val, T dt)
 }
 
 // 比例微分先行型PID
-template <typename T>
-inline T PID<T>::calculate_I_PD(T target, T now_val, T dt)
+template <typename T, PIDStaticMode M, PIDSaturation S>
+inline T PID<T, M, S>::calculate_I_PD(T target, T now_val, T dt)
 {
     T p = -_param.gain.Kp * now_val;
     T i =  _param.gain.Ki * _integral;
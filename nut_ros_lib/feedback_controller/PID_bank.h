@@ -0,0 +1,213 @@
+/**
+ * @file PID_bank.h
+ * @brief 複数チャンネルのPIDの一括計算
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./PID.h"
+
+namespace nut_ros
+{
+/**
+ * @brief 複数チャンネルのPIDの一括計算
+ * @details ゲインと内部状態をチャンネル毎の配列（SoA）で保持し，全チャンネルを分岐なしの1ループで更新する
+ *          各チャンネルの計算結果は同じパラメータのPID<T>と一致する
+ * @tparam T: 数値型
+ * @tparam N: チャンネル数
+**/
+template <typename T, size_t N>
+class PIDBank
+{
+public:
+    using Mode = typename PID<T>::Mode;       /**< モードリスト（PID<T>と共通） */
+    using gain_t = typename PID<T>::gain_t;   /**< ゲイン構造体（PID<T>と共通） */
+    using param_t = typename PID<T>::param_t; /**< パラメータ構造体（PID<T>と共通） */
+    using array_t = std::array<T, N>;         /**< チャンネル毎の値の配列 */
+
+    /**
+     * @brief コンストラクタ（全チャンネル位置型PID，ゲインゼロ，出力制限なし）
+     */
+    PIDBank()
+    {
+        _kp.fill(0);
+        _ki.fill(0);
+        _kd.fill(0);
+        _mode.fill(Mode::pPID);
+        _need_saturation.fill(false);
+        _output_min.fill(0);
+        _output_max.fill(0);
+        reset();
+    }
+
+    /**
+     * @brief 全チャンネルのリセット
+     */
+    void reset()
+    {
+        _diff1.fill(0);
+        _diff2.fill(0);
+        _prev_val.fill(0);
+        _integral.fill(0);
+        _output.fill(0);
+    }
+
+    /**
+     * @brief 指定チャンネルのリセット
+     * @param ch: チャンネル番号
+     */
+    void reset(size_t ch)
+    {
+        _diff1[ch] = _diff2[ch] = 0;
+        _prev_val[ch] = 0;
+        _integral[ch] = 0;
+        _output[ch] = 0;
+    }
+
+    /**
+     * @brief 指定チャンネルのパラメータの設定
+     * @param ch: チャンネル番号
+     * @param param: パラメータ構造体
+     */
+    void setParam(size_t ch, const param_t &param)
+    {
+        setGain(ch, param.gain);
+        setMode(ch, param.mode);
+        _need_saturation[ch] = param.need_saturation;
+        _output_min[ch] = param.output_min;
+        _output_max[ch] = param.output_max;
+    }
+
+    /**
+     * @brief 指定チャンネルのゲインの設定
+     * @param ch: チャンネル番号
+     * @param gain: ゲイン構造体
+     */
+    void setGain(size_t ch, const gain_t &gain)
+    {
+        _kp[ch] = gain.Kp;
+        _ki[ch] = gain.Ki;
+        _kd[ch] = gain.Kd;
+    }
+
+    /**
+     * @brief 指定チャンネルのPIDモードの設定
+     * @param ch: チャンネル番号
+     * @param mode: PIDモードenum
+     */
+    void setMode(size_t ch, Mode mode) { _mode[ch] = mode; }
+
+    /**
+     * @brief 指定チャンネルの出力の最小，最大値の設定
+     * @param ch: チャンネル番号
+     * @param min_v: 最小値
+     * @param max_v: 最大値
+     */
+    void setSaturation(size_t ch, T min_v, T max_v)
+    {
+        _need_saturation[ch] = true;
+        _output_min[ch] = min_v;
+        _output_max[ch] = max_v;
+    }
+
+    /**
+     * @brief 全チャンネルの値の更新
+     * @param target: 目標値
+     * @param now_val: 現在値
+     * @param dt: 前回この関数をコールしてからの経過時間
+     */
+    void update(const array_t &target, const array_t &now_val, const array_t &dt)
+    {
+        for (size_t i = 0; i < N; ++i)
+            _output[i] = calculate(i, target[i], now_val[i], dt[i]);
+    }
+
+    /**
+     * @brief 全チャンネルの値の更新（経過時間は全チャンネル共通）
+     * @param target: 目標値
+     * @param now_val: 現在値
+     * @param dt: 前回この関数をコールしてからの経過時間
+     */
+    void update(const array_t &target, const array_t &now_val, T dt)
+    {
+        for (size_t i = 0; i < N; ++i)
+            _output[i] = calculate(i, target[i], now_val[i], dt);
+    }
+
+    /**
+     * @brief 指定チャンネルの制御量（PIDの計算結果）の取得
+     * @param ch: チャンネル番号
+     * @return 制御量（PIDの計算結果）
+     * @attention update()を呼び出さないと値は更新されない
+     */
+    T getControlValue(size_t ch) const { return _output[ch]; }
+
+    /**
+     * @brief 全チャンネルの制御量（PIDの計算結果）の取得
+     * @return 制御量（PIDの計算結果）の配列
+     * @attention update()を呼び出さないと値は更新されない
+     */
+    const array_t &getControlValues() const { return _output; }
+
+    /**
+     * @brief チャンネル数を返す
+     * @return チャンネル数
+     */
+    static constexpr size_t size() { return N; }
+
+private:
+    // パラメータ
+    array_t _kp, _ki, _kd;
+    std::array<Mode, N> _mode;
+    std::array<bool, N> _need_saturation;
+    array_t _output_min, _output_max;
+
+    // リセットするやつ
+    array_t _diff1, _diff2; // 過去, 大過去の偏差
+    array_t _prev_val;
+    array_t _integral;
+    array_t _output;
+
+    // 全モードの項を計算してから選択することで分岐をなくし，ループをベクトル化しやすくしている
+    // 各項の計算式と演算順序はPID<T>と同一
+    inline T calculate(size_t i, T target, T now_val, T dt)
+    {
+        const T e0 = target - now_val;
+        const T e1 = _diff1[i];
+        const T e2 = _diff2[i];
+        const T prev_val = _prev_val[i];
+        _integral[i] += (e0 + e1) * (dt / 2.0);
+
+        const bool is_p = (_mode[i] == Mode::pPID);
+        const bool is_s = (_mode[i] == Mode::sPID);
+        const bool is_ipd = (_mode[i] == Mode::I_PD);
+
+        const T p_error = _kp[i] * e0;
+        const T p_s = _kp[i] * e0 - e1;
+        const T p_ipd = -_kp[i] * now_val;
+        const T p = is_s ? p_s : (is_ipd ? p_ipd : p_error);
+
+        const T i_integral = _ki[i] * _integral[i];
+        const T i_s = _ki[i] * e0 * dt;
+        const T i_term = is_s ? i_s : i_integral;
+
+        const T d_p = _kd[i] * ((e0 - e1) / dt);
+        const T d_s = _kd[i] * (e0 - 2 * e1 + e2) / dt;
+        const T d_val = -_kd[i] * ((now_val - prev_val) / dt);
+        const T d = is_p ? d_p : (is_s ? d_s : d_val);
+
+        const T sum = p + i_term + d;
+        const T sum_s = prev_val + p + i_term + d;
+        T output = is_s ? sum_s : sum;
+
+        // 次回ループのために今回の値を前回の値にする
+        _diff2[i] = e1;
+        _diff1[i] = e0;
+        _prev_val[i] = now_val;
+
+        // ガード処理
+        const T guarded = (T)Generic::guard<double>(output, _output_min[i], _output_max[i]);
+        return _need_saturation[i] ? guarded : output;
+    }
+};
+}
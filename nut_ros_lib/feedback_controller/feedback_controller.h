@@ -4,7 +4,7 @@
 **/
 #pragma once
 
-#include "./../nut_generic.h"
+#include "./../nut_generic_core.h"
 
 namespace nut_ros
 {
@@ -0,0 +1,325 @@
+/**
+ * @file distance_transform.h
+ * @brief 占有格子地図の障害物までの距離（ユークリッド距離変換）をキャッシュする
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./../vector/pose_2D.h"
+#include "./occupancy_grid_view.h"
+
+#include <limits>
+
+namespace nut_ros {
+
+/**
+ * @brief 占有格子地図の障害物までの距離（ユークリッド距離変換）をキャッシュする
+ * @details 各格子から最も近い障害物の格子までの距離を，Felzenszwalb-Huttenlocherの厳密なユークリッド距離変換で求めて保持する
+ *          距離はmax_distanceで打ち切るため，地図が変化した場合は変化した格子からmax_distance以内の領域のみを再計算すればよい
+ *          update()は前回の占有状態と比較して変化した範囲を求め，その周辺のみを再計算する
+ *          getDistance()は格子を引くだけのO(1)で，障害物の数によらない
+ * @code
+ * nut_ros::DistanceTransform<double> edt(1.0);
+ * edt.update(nut_ros::OccupancyGridView<double>(*map_msg)); // 地図を受信するたび
+ * const bool free = edt.getDistance(pose) > robot_radius;
+ * @endcode
+**/
+template <typename T>
+class DistanceTransform
+{
+public:
+    /**
+     * @brief コンストラクタ
+     * @param max_distance: 距離を打ち切る上限[m]
+     */
+    explicit DistanceTransform(T max_distance = 1.0) : _max_distance(max_distance) {}
+
+    /**
+     * @brief 地図全体の距離を計算する
+     * @param view: 占有格子地図（占有判定にはview.setThreshold()の設定を使用する）
+     */
+    void compute(const OccupancyGridView<T> &view)
+    {
+        setGeometry(view);
+        const size_t size = (size_t)_width * _height;
+        _mask.resize(size);
+        for (size_t i = 0; i < size; ++i)
+            _mask[i] = view.isOccupiedValue(view.data()[i]);
+        _distance.assign(size, (float)_max_distance);
+        recompute(0, 0, (long long)_width, (long long)_height);
+    }
+
+    /**
+     * @brief 地図の変化した領域の周辺のみ距離を再計算する
+     * @details 前回の占有状態と比較して変化した格子の範囲を求める（比較は地図全体に対して行うが，距離変換よりはるかに軽い）
+     *          地図の大きさや解像度，原点が変化した場合はcompute()と同じく全体を計算する
+     * @param view: 占有格子地図
+     * @return 占有状態が変化した格子の数
+     */
+    size_t update(const OccupancyGridView<T> &view)
+    {
+        if (!isSameGeometry(view))
+        {
+            compute(view);
+            return (size_t)_width * _height;
+        }
+
+        long long x0 = _width, y0 = _height, x1 = -1, y1 = -1;
+        size_t changed = 0;
+        for (uint32_t iy = 0; iy < _height; ++iy)
+        {
+            const size_t row = (size_t)iy * _width;
+            for (uint32_t ix = 0; ix < _width; ++ix)
+            {
+                const uint8_t occupied = view.isOccupiedValue(view.data()[row + ix]);
+                if (occupied != _mask[row + ix])
+                {
+                    _mask[row + ix] = occupied;
+                    ++changed;
+                    x0 = std::min<long long>(x0, ix);
+                    y0 = std::min<long long>(y0, iy);
+                    x1 = std::max<long long>(x1, ix);
+                    y1 = std::max<long long>(y1, iy);
+                }
+            }
+        }
+        if (changed > 0)
+            updateRegion(x0, y0, x1 + 1, y1 + 1);
+        return changed;
+    }
+
+    /**
+     * @brief 指定した範囲の格子が変化したものとして距離を再計算する
+     * @details 変化した範囲が分かっている場合（部分的な地図の更新など）は地図全体の比較を省ける
+     * @param view: 占有格子地図（大きさと原点は前回のcompute()と同じであること）
+     * @param x0: 変化した範囲のx方向の最小の格子番号
+     * @param y0: 変化した範囲のy方向の最小の格子番号
+     * @param x1: 変化した範囲のx方向の最大の格子番号 + 1
+     * @param y1: 変化した範囲のy方向の最大の格子番号 + 1
+     */
+    void update(const OccupancyGridView<T> &view, long long x0, long long y0, long long x1, long long y1)
+    {
+        if (!isSameGeometry(view))
+        {
+            compute(view);
+            return;
+        }
+        x0 = std::max<long long>(x0, 0);
+        y0 = std::max<long long>(y0, 0);
+        x1 = std::min<long long>(x1, _width);
+        y1 = std::min<long long>(y1, _height);
+        for (long long iy = y0; iy < y1; ++iy)
+        {
+            for (long long ix = x0; ix < x1; ++ix)
+            {
+                const size_t i = (size_t)iy * _width + ix;
+                _mask[i] = view.isOccupiedValue(view.data()[i]);
+            }
+        }
+        if (x0 < x1 && y0 < y1)
+            updateRegion(x0, y0, x1, y1);
+    }
+
+    /**
+     * @brief 格子から最も近い障害物までの距離を返す
+     * @param ix: x方向の格子番号
+     * @param iy: y方向の格子番号
+     * @return 距離[m]（max_distanceで打ち切り，範囲外は0）
+     */
+    T getDistance(long long ix, long long iy) const
+    {
+        return _geometry.isInside(ix, iy) ? (T)_distance[(size_t)iy * _width + ix] : 0;
+    }
+
+    /**
+     * @brief 座標から最も近い障害物までの距離を返す
+     * @details 格子の中心間の距離であり，格子内での位置は考慮しない
+     * @param x: x座標[m]
+     * @param y: y座標[m]
+     * @return 距離[m]（max_distanceで打ち切り，範囲外は0）
+     */
+    T getDistance(T x, T y) const
+    {
+        long long ix, iy;
+        _geometry.worldToCell(x, y, ix, iy);
+        return getDistance(ix, iy);
+    }
+
+    /**
+     * @brief 座標から最も近い障害物までの距離を返す
+     * @param pose: 座標
+     * @return 距離[m]（max_distanceで打ち切り，範囲外は0）
+     */
+    T getDistance(const Pose2D<T> &pose) const
+    {
+        return getDistance(pose.x, pose.y);
+    }
+
+    /**
+     * @brief 円が障害物と重ならないかどうか
+     * @param pose: 円の中心
+     * @param radius: 円の半径[m]（max_distance未満であること）
+     * @return 重ならないかどうか（範囲外はfalse）
+     */
+    bool isCollisionFree(const Pose2D<T> &pose, T radius) const
+    {
+        return getDistance(pose) > radius;
+    }
+
+    /**
+     * @brief 距離を打ち切る上限を返す
+     * @return 上限[m]
+     */
+    T getMaxDistance() const
+    {
+        return _max_distance;
+    }
+
+    /**
+     * @brief 格子の大きさ，解像度，原点を返す
+     * @return 座標変換用の地図（data()はnullptr）
+     */
+    const OccupancyGridView<T> &getGeometry() const
+    {
+        return _geometry;
+    }
+
+    /**
+     * @brief 全格子の距離を返す
+     * @return 距離[m]（行優先，幅 * 高さ個）
+     */
+    const std::vector<float> &getData() const
+    {
+        return _distance;
+    }
+
+private:
+    T _max_distance;
+    OccupancyGridView<T> _geometry; // 座標変換にのみ使用する（dataは参照しない）
+    uint32_t _width = 0, _height = 0;
+    std::vector<uint8_t> _mask;    // 前回の占有状態
+    std::vector<float> _distance;  // 障害物までの距離[m]
+    // 距離の2乗[cell^2]と放物線の交点は格子番号の2乗の大きさになり，幅の広い地図ではfloatの仮数部に収まらないためdoubleで扱う
+    std::vector<double> _column;    // 列方向の変換結果（距離の2乗[cell^2]）
+    std::vector<double> _f, _d, _z; // 1次元の変換用の作業領域
+    std::vector<int> _v;
+
+    static constexpr double INF = 1e20;
+
+    void setGeometry(const OccupancyGridView<T> &view)
+    {
+        _geometry.set(nullptr, view.getWidth(), view.getHeight(), view.getResolution(), view.getOrigin());
+        _width = view.getWidth();
+        _height = view.getHeight();
+    }
+
+    bool isSameGeometry(const OccupancyGridView<T> &view) const
+    {
+        return _mask.size() == (size_t)_width * _height && view.getWidth() == _width && view.getHeight() == _height &&
+               view.getResolution() == _geometry.getResolution() && view.getOrigin() == _geometry.getOrigin();
+    }
+
+    // 占有状態が変化した範囲から距離が変わりうる範囲を求めて再計算する
+    void updateRegion(long long x0, long long y0, long long x1, long long y1)
+    {
+        const long long r = getRadius();
+        recompute(std::max<long long>(x0 - r, 0), std::max<long long>(y0 - r, 0),
+                  std::min<long long>(x1 + r, _width), std::min<long long>(y1 + r, _height));
+    }
+
+    // 打ち切り距離[cell]（余裕を1格子持たせる）
+    long long getRadius() const
+    {
+        const T resolution = _geometry.getResolution();
+        return resolution > 0 ? (long long)std::ceil(_max_distance / resolution) + 1 : (long long)std::max(_width, _height);
+    }
+
+    // 範囲[x0, x1) x [y0, y1)の距離を再計算する
+    // 打ち切り距離以内の障害物は範囲をr格子広げた窓の中にあるため，窓の中だけで距離変換すれば範囲内の結果は厳密に一致する
+    void recompute(long long x0, long long y0, long long x1, long long y1)
+    {
+        const long long r = getRadius();
+        const long long wx0 = std::max<long long>(x0 - r, 0), wy0 = std::max<long long>(y0 - r, 0);
+        const long long wx1 = std::min<long long>(x1 + r, _width), wy1 = std::min<long long>(y1 + r, _height);
+        const size_t ww = (size_t)(wx1 - wx0), wh = (size_t)(wy1 - wy0);
+
+        const size_t n = std::max(ww, wh);
+        _f.resize(n);
+        _d.resize(n);
+        _z.resize(n + 1);
+        _v.resize(n);
+        _column.resize(ww * wh);
+
+        // 列方向
+        for (size_t cx = 0; cx < ww; ++cx)
+        {
+            for (size_t cy = 0; cy < wh; ++cy)
+                _f[cy] = _mask[(size_t)(wy0 + cy) * _width + (size_t)(wx0 + cx)] ? 0.0 : INF;
+            transform1D(wh);
+            for (size_t cy = 0; cy < wh; ++cy)
+                _column[cy * ww + cx] = _d[cy];
+        }
+
+        // 行方向（再計算する行のみ）
+        const double resolution = (double)_geometry.getResolution();
+        const double max_distance = (double)_max_distance;
+        for (long long iy = y0; iy < y1; ++iy)
+        {
+            const size_t cy = (size_t)(iy - wy0);
+            for (size_t cx = 0; cx < ww; ++cx)
+                _f[cx] = _column[cy * ww + cx];
+            transform1D(ww);
+            float *out = _distance.data() + (size_t)iy * _width;
+            for (long long ix = x0; ix < x1; ++ix)
+                out[ix] = (float)std::min(std::sqrt(_d[(size_t)(ix - wx0)]) * resolution, max_distance);
+        }
+    }
+
+    // 1次元の距離の2乗の変換（放物線の下側包絡線）: _d[q] = min_p (_f[p] + (q - p)^2)
+    void transform1D(const size_t n)
+    {
+        int k = -1;
+        for (size_t q = 0; q < n; ++q)
+        {
+            if (_f[q] >= INF)
+                continue;
+            const double fq = _f[q] + (double)q * q;
+            while (k >= 0)
+            {
+                const int p = _v[k];
+                const double s = (fq - (_f[p] + (double)p * p)) / (2.0 * ((double)q - p));
+                if (s > _z[k])
+                {
+                    ++k;
+                    _v[k] = (int)q;
+                    _z[k] = s;
+                    break;
+                }
+                --k;
+            }
+            if (k < 0)
+            {
+                k = 0;
+                _v[0] = (int)q;
+                _z[0] = -INF;
+            }
+        }
+
+        if (k < 0)
+        {
+            for (size_t q = 0; q < n; ++q)
+                _d[q] = INF;
+            return;
+        }
+        int j = 0;
+        _z[k + 1] = INF;
+        for (size_t q = 0; q < n; ++q)
+        {
+            while (_z[j + 1] < (double)q)
+                ++j;
+            const double dq = (double)q - _v[j];
+            _d[q] = dq * dq + _f[_v[j]];
+        }
+    }
+};
+}
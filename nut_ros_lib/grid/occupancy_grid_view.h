@@ -0,0 +1,353 @@
+/**
+ * @file occupancy_grid_view.h
+ * @brief 占有格子地図のデータをコピーせずに参照する
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./../vector/vector2.h"
+#include "./../vector/pose_2D.h"
+#include "./../vector/rotation_2D.h"
+
+#include <limits>
+
+namespace nut_ros {
+
+/**
+ * @brief 占有格子地図のデータをコピーせずに参照する
+ * @details nav_msgs::OccupancyGridのdataを指すだけで，座標と格子の変換，占有判定，レイキャストを行う
+ *          値は-1: 未知，0〜100: 占有確率[%]で，setThreshold()で設定した閾値以上を障害物とみなす
+ *          レイキャストは格子をDDA（Amanatides-Woo）でたどるため，距離に比例した計算量で済む
+ *          getRayDistance()の形式がLine2DIndexと同じなので，RayCasterにそのまま渡せる
+ * @attention 参照先のメッセージが破棄・再確保された場合はset()し直す必要がある
+ * @code
+ * nut_ros::OccupancyGridView<double> view(*map_msg);
+ * const bool occupied = view.isOccupied(pose);
+ * const double range = view.getRayDistance(pose, 10.0);
+ * @endcode
+**/
+template <typename T>
+class OccupancyGridView
+{
+public:
+    /**
+     * @brief コンストラクタ
+     */
+    OccupancyGridView() = default;
+
+    /**
+     * @brief コンストラクタ 生データで初期化
+     * @param data: 格子の値（行優先，width * height個）
+     * @param width: 幅[cell]
+     * @param height: 高さ[cell]
+     * @param resolution: 1格子の大きさ[m]
+     * @param origin: 格子(0, 0)の角の位置姿勢
+     */
+    OccupancyGridView(const int8_t *data, uint32_t width, uint32_t height, T resolution, const Pose2D<T> &origin)
+    {
+        set(data, width, height, resolution, origin);
+    }
+
+    /**
+     * @brief コンストラクタ nav_msgs::OccupancyGridで初期化
+     * @param grid: nav_msgs::OccupancyGrid（info, dataを持つ型）
+     */
+    template <class Grid>
+    explicit OccupancyGridView(const Grid &grid)
+    {
+        set(grid);
+    }
+
+    /**
+     * @brief 生データを参照する
+     * @param data: 格子の値（行優先，width * height個）
+     * @param width: 幅[cell]
+     * @param height: 高さ[cell]
+     * @param resolution: 1格子の大きさ[m]
+     * @param origin: 格子(0, 0)の角の位置姿勢
+     */
+    void set(const int8_t *data, uint32_t width, uint32_t height, T resolution, const Pose2D<T> &origin)
+    {
+        _data = data;
+        _width = width;
+        _height = height;
+        _resolution = resolution;
+        _inv_resolution = resolution > 0 ? 1 / resolution : 0;
+        _origin = origin;
+        _rotation = Rotation2D<T>(origin.theta);
+    }
+
+    /**
+     * @brief nav_msgs::OccupancyGridを参照する
+     * @param grid: nav_msgs::OccupancyGrid（info, dataを持つ型）
+     */
+    template <class Grid>
+    void set(const Grid &grid)
+    {
+        const auto &q = grid.info.origin.orientation;
+        const T yaw = (T)std::atan2(2 * (q.w * q.z + q.x * q.y), q.w * q.w + q.x * q.x - q.y * q.y - q.z * q.z);
+        set(grid.data.data(), grid.info.width, grid.info.height, (T)grid.info.resolution,
+            Pose2D<T>((T)grid.info.origin.position.x, (T)grid.info.origin.position.y, yaw));
+    }
+
+    /**
+     * @brief 障害物とみなす閾値の設定
+     * @param occupied_threshold: この値以上の格子を障害物とみなす（デフォルト: 50）
+     * @param unknown_is_occupied: 未知（-1）の格子を障害物とみなすかどうか（デフォルト: false）
+     */
+    void setThreshold(int8_t occupied_threshold, bool unknown_is_occupied = false)
+    {
+        _occupied_threshold = occupied_threshold;
+        _unknown_is_occupied = unknown_is_occupied;
+    }
+
+    /**
+     * @brief データを参照しているかどうか
+     * @return 参照しているかどうか
+     */
+    bool empty() const { return _data == nullptr || _width == 0 || _height == 0; }
+
+    /**
+     * @brief 参照しているデータを返す
+     * @return データの先頭
+     */
+    const int8_t *data() const { return _data; }
+
+    /**
+     * @brief 幅を返す
+     * @return 幅[cell]
+     */
+    uint32_t getWidth() const { return _width; }
+
+    /**
+     * @brief 高さを返す
+     * @return 高さ[cell]
+     */
+    uint32_t getHeight() const { return _height; }
+
+    /**
+     * @brief 1格子の大きさを返す
+     * @return 1格子の大きさ[m]
+     */
+    T getResolution() const { return _resolution; }
+
+    /**
+     * @brief 格子(0, 0)の角の位置姿勢を返す
+     * @return 位置姿勢
+     */
+    const Pose2D<T> &getOrigin() const { return _origin; }
+
+    /**
+     * @brief 格子が地図の範囲内かどうか
+     * @param ix: x方向の格子番号
+     * @param iy: y方向の格子番号
+     * @return 範囲内かどうか
+     */
+    bool isInside(long long ix, long long iy) const
+    {
+        return ix >= 0 && iy >= 0 && ix < (long long)_width && iy < (long long)_height;
+    }
+
+    /**
+     * @brief 格子のdata上の添字を返す
+     * @param ix: x方向の格子番号
+     * @param iy: y方向の格子番号
+     * @return 添字
+     */
+    size_t getIndex(long long ix, long long iy) const
+    {
+        return (size_t)iy * _width + (size_t)ix;
+    }
+
+    /**
+     * @brief 座標を格子番号に変換する
+     * @param x: x座標[m]
+     * @param y: y座標[m]
+     * @param ix: x方向の格子番号の出力先
+     * @param iy: y方向の格子番号の出力先
+     * @return 地図の範囲内かどうか
+     */
+    bool worldToCell(T x, T y, long long &ix, long long &iy) const
+    {
+        T gx, gy;
+        worldToGrid(x, y, gx, gy);
+        ix = toCell(gx);
+        iy = toCell(gy);
+        return isInside(ix, iy);
+    }
+
+    /**
+     * @brief 座標を格子番号に変換する
+     * @param pose: 座標
+     * @param ix: x方向の格子番号の出力先
+     * @param iy: y方向の格子番号の出力先
+     * @return 地図の範囲内かどうか
+     */
+    bool worldToCell(const Pose2D<T> &pose, long long &ix, long long &iy) const
+    {
+        return worldToCell(pose.x, pose.y, ix, iy);
+    }
+
+    /**
+     * @brief 格子の中心の座標を返す
+     * @param ix: x方向の格子番号
+     * @param iy: y方向の格子番号
+     * @return 格子の中心の座標[m]
+     */
+    Vector2<T> cellToWorld(long long ix, long long iy) const
+    {
+        T x = ((T)ix + (T)0.5) * _resolution;
+        T y = ((T)iy + (T)0.5) * _resolution;
+        _rotation.apply(x, y);
+        return Vector2<T>(x + _origin.x, y + _origin.y);
+    }
+
+    /**
+     * @brief 格子の値を返す
+     * @param ix: x方向の格子番号
+     * @param iy: y方向の格子番号
+     * @return 格子の値（範囲外の場合は未知: -1）
+     */
+    int8_t getValue(long long ix, long long iy) const
+    {
+        return isInside(ix, iy) ? _data[getIndex(ix, iy)] : (int8_t)-1;
+    }
+
+    /**
+     * @brief 座標の格子の値を返す
+     * @param pose: 座標
+     * @return 格子の値（範囲外の場合は未知: -1）
+     */
+    int8_t getValue(const Pose2D<T> &pose) const
+    {
+        long long ix, iy;
+        worldToCell(pose, ix, iy);
+        return getValue(ix, iy);
+    }
+
+    /**
+     * @brief 値が障害物を表すかどうか
+     * @param value: 格子の値
+     * @return 障害物かどうか
+     */
+    bool isOccupiedValue(int8_t value) const
+    {
+        return value < 0 ? _unknown_is_occupied : value >= _occupied_threshold;
+    }
+
+    /**
+     * @brief 格子が障害物かどうか
+     * @param ix: x方向の格子番号
+     * @param iy: y方向の格子番号
+     * @return 障害物かどうか（範囲外は未知として扱う）
+     */
+    bool isOccupied(long long ix, long long iy) const
+    {
+        return isOccupiedValue(getValue(ix, iy));
+    }
+
+    /**
+     * @brief 座標の格子が障害物かどうか
+     * @param pose: 座標
+     * @return 障害物かどうか（範囲外は未知として扱う）
+     */
+    bool isOccupied(const Pose2D<T> &pose) const
+    {
+        return isOccupiedValue(getValue(pose));
+    }
+
+    /**
+     * @brief 半直線上で最も近い障害物までの距離
+     * @details 地図の外に出た時点で打ち切る（始点が地図の外の場合は当たらないものとする）
+     * @param ox: 始点のx座標
+     * @param oy: 始点のy座標
+     * @param dir_x: 方向の単位ベクトルのx成分
+     * @param dir_y: 方向の単位ベクトルのy成分
+     * @param max_range: 最大距離
+     * @return 障害物までの距離（max_range以内に当たらない場合は無限大）
+     */
+    T getRayDistance(T ox, T oy, T dir_x, T dir_y, T max_range) const
+    {
+        const T inf = std::numeric_limits<T>::infinity();
+        T gx, gy;
+        worldToGrid(ox, oy, gx, gy);
+        long long ix = toCell(gx);
+        long long iy = toCell(gy);
+        if (!isInside(ix, iy))
+            return inf;
+        if (isOccupiedValue(_data[getIndex(ix, iy)]))
+            return 0;
+
+        // 格子座標系での方向
+        const T dx = _rotation.cos() * dir_x + _rotation.sin() * dir_y;
+        const T dy = -_rotation.sin() * dir_x + _rotation.cos() * dir_y;
+        const long long step_x = dx > 0 ? 1 : -1;
+        const long long step_y = dy > 0 ? 1 : -1;
+        const T delta_x = dx != 0 ? std::abs(1 / dx) : inf;
+        const T delta_y = dy != 0 ? std::abs(1 / dy) : inf;
+        T next_x = dx != 0 ? ((T)(ix + (dx > 0)) - gx) / dx : inf;
+        T next_y = dy != 0 ? ((T)(iy + (dy > 0)) - gy) / dy : inf;
+        const T max_t = max_range * _inv_resolution;
+
+        while (true)
+        {
+            T t;
+            if (next_x < next_y)
+            {
+                t = next_x;
+                next_x += delta_x;
+                ix += step_x;
+                if (ix < 0 || ix >= (long long)_width)
+                    return inf;
+            }
+            else
+            {
+                t = next_y;
+                next_y += delta_y;
+                iy += step_y;
+                if (iy < 0 || iy >= (long long)_height)
+                    return inf;
+            }
+            if (t > max_t)
+                return inf;
+            if (isOccupiedValue(_data[getIndex(ix, iy)]))
+                return t * _resolution;
+        }
+    }
+
+    /**
+     * @brief 姿勢の向きの半直線上で最も近い障害物までの距離
+     * @param pose: 始点と向き
+     * @param max_range: 最大距離
+     * @return 障害物までの距離（max_range以内に当たらない場合は無限大）
+     */
+    T getRayDistance(const Pose2D<T> &pose, T max_range) const
+    {
+        return getRayDistance(pose.x, pose.y, std::cos(pose.theta), std::sin(pose.theta), max_range);
+    }
+
+private:
+    const int8_t *_data = nullptr;
+    uint32_t _width = 0, _height = 0;
+    T _resolution = 0, _inv_resolution = 0;
+    Pose2D<T> _origin;
+    Rotation2D<T> _rotation;
+    int8_t _occupied_threshold = 50;
+    bool _unknown_is_occupied = false;
+
+    // 格子座標系（格子単位，原点は格子(0, 0)の角）に変換する
+    void worldToGrid(T x, T y, T &gx, T &gy) const
+    {
+        const T dx = x - _origin.x;
+        const T dy = y - _origin.y;
+        gx = (_rotation.cos() * dx + _rotation.sin() * dy) * _inv_resolution;
+        gy = (-_rotation.sin() * dx + _rotation.cos() * dy) * _inv_resolution;
+    }
+
+    static long long toCell(T g)
+    {
+        const T c = std::floor(g);
+        return c < (T)-1e15 ? (long long)-1e15 : (c > (T)1e15 ? (long long)1e15 : (long long)c);
+    }
+};
+}
@@ -0,0 +1,418 @@
+/**
+ * @file particle_filter.h
+ * @brief パーティクルフィルタによる自己位置推定（モンテカルロ位置推定）
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./../angles/angles.h"
+#include "./../vector/pose_2D.h"
+#include "./../vector/pose_2D_array.h"
+#include "./../vector/vector2_array.h"
+#include "./../vector/ray_caster.h"
+#include "./../grid/distance_transform.h"
+#include "./../odometry/odometry_integrator.h"
+#include "./../realtime/thread_pool.h"
+
+#include <random>
+
+namespace nut_ros {
+/**
+ * @brief パーティクルフィルタによる自己位置推定（モンテカルロ位置推定）
+ * @details パーティクルはPose2DArray（SoA）で保持し，生成時に確保した領域のみを使用する（各周期での動的確保は行わない）
+ *          予測はOdometryIntegratorの位置姿勢の差分（ロボット座標系）に移動量に比例したガウス雑音を加えて行う
+ *          観測はDistanceTransformによる尤度場モデル，またはRayCasterによるビームモデルで行い，
+ *          各ビームの尤度 z_hit * exp(-誤差^2 / (2 * sigma_hit^2)) + z_rand の対数の和で重みを更新する
+ *          予測と観測はThreadPoolでパーティクルを分割して並列に処理する（乱数生成器は区間ごとに持つため結果はスケジューリングによらない）
+ *          有効パーティクル数が閾値を下回った場合は，系統的（低分散）リサンプリングを行う
+ * @code
+ * nut_ros::ParticleFilter<float> filter;
+ * filter.initialize(initial_pose, nut_ros::Pose2D<float>(0.5, 0.5, 0.3));
+ * // 周期ごと
+ * filter.predict(odometry);
+ * projector.project(scan, laser_pose, points); // ロボット座標系の測定点
+ * filter.updateLikelihoodField(edt, points);
+ * nut_ros::MsgGenerator::fill(pose_msg, "map", filter.getPose(), filter.getCovariance());
+ * @endcode
+**/
+template <typename T>
+class ParticleFilter
+{
+public:
+    /**
+     * @brief パラメータ構造体
+     */
+    struct param_t
+    {
+        size_t particle_count = 1000; /**< パーティクルの数 */
+        size_t thread_num = 0;        /**< スレッド数（0の場合はハードウェアの並列数） */
+        uint32_t seed = 0;            /**< 乱数の種 */
+
+        T alpha_rotation_by_rotation = 0.2;       /**< 回転量に比例する回転の雑音[rad/rad] */
+        T alpha_rotation_by_translation = 0.2;    /**< 移動量に比例する回転の雑音[rad/m] */
+        T alpha_translation_by_translation = 0.2; /**< 移動量に比例する移動の雑音[m/m] */
+        T alpha_translation_by_rotation = 0.05;   /**< 回転量に比例する移動の雑音[m/rad] */
+
+        size_t max_beams = 60; /**< 観測に使用する最大のビーム数（測定点を間引く） */
+        T sigma_hit = 0.2;     /**< 測定誤差の標準偏差[m] */
+        T z_hit = 0.95;        /**< 測定誤差の成分の重み */
+        T z_rand = 0.05;       /**< ランダムな測定の成分（誤差によらない尤度） */
+
+        T resample_threshold = 0.5; /**< リサンプリングする有効パーティクル数の割合 */
+    };
+
+    /**
+     * @brief コンストラクタ
+     */
+    ParticleFilter() : ParticleFilter(param_t()) {}
+
+    /**
+     * @brief コンストラクタ パラメータ構造体で初期化
+     * @param param: パラメータ構造体
+     */
+    explicit ParticleFilter(const param_t &param)
+        : _param(param), _pool(param.thread_num), _particles(std::max<size_t>(param.particle_count, 1)), _next(_particles.size()),
+          _weights(_particles.size(), (T)1 / (T)_particles.size()), _log_likelihood(_particles.size())
+    {
+        _random.reserve(_pool.size());
+        for (size_t i = 0; i < _pool.size(); ++i)
+            _random.emplace_back(param.seed + (uint32_t)i);
+    }
+
+    /**
+     * @brief 初期位置の周辺にパーティクルを配置する（ガウス分布）
+     * @param mean: 初期位置
+     * @param stddev: 各成分の標準偏差
+     */
+    void initialize(const Pose2D<T> &mean, const Pose2D<T> &stddev)
+    {
+        _pool.parallelFor(size(), [&](size_t chunk, size_t begin, size_t end) {
+            random_t &random = _random[chunk];
+            for (size_t i = begin; i < end; ++i)
+            {
+                _particles.x[i] = mean.x + stddev.x * random.normal(random.engine);
+                _particles.y[i] = mean.y + stddev.y * random.normal(random.engine);
+                _particles.theta[i] = (T)Angles::normalize(mean.theta + stddev.theta * random.normal(random.engine));
+            }
+        });
+        std::fill(_weights.begin(), _weights.end(), (T)1 / (T)size());
+        _has_odometry = false;
+        estimate();
+    }
+
+    /**
+     * @brief ロボット座標系の移動量で予測する
+     * @param delta: 前回の予測からの移動量（ロボット座標系）
+     */
+    void predict(const Pose2D<T> &delta)
+    {
+        const T translation = std::hypot(delta.x, delta.y);
+        const T rotation = std::abs(delta.theta);
+        const T sigma_translation = _param.alpha_translation_by_translation * translation + _param.alpha_translation_by_rotation * rotation;
+        const T sigma_rotation = _param.alpha_rotation_by_rotation * rotation + _param.alpha_rotation_by_translation * translation;
+
+        _pool.parallelFor(size(), [&](size_t chunk, size_t begin, size_t end) {
+            random_t &random = _random[chunk];
+            for (size_t i = begin; i < end; ++i)
+            {
+                const T dx = delta.x + sigma_translation * random.normal(random.engine);
+                const T dy = delta.y + sigma_translation * random.normal(random.engine);
+                const T dtheta = delta.theta + sigma_rotation * random.normal(random.engine);
+                const T theta = _particles.theta[i];
+                const T c = Angles::fastCos(theta);
+                const T s = Angles::fastSin(theta);
+                _particles.x[i] += c * dx - s * dy;
+                _particles.y[i] += s * dx + c * dy;
+                _particles.theta[i] = (T)Angles::normalize(theta + dtheta);
+            }
+        });
+        estimate();
+    }
+
+    /**
+     * @brief オドメトリの前回の呼び出しからの変化で予測する
+     * @details 最初の呼び出し（およびinitialize()の直後）は基準の位置姿勢を記録するのみ
+     * @param odometry: オドメトリ
+     */
+    void predict(const OdometryIntegrator<T> &odometry)
+    {
+        const Pose2D<T> current(odometry.getPose().x, odometry.getPose().y, odometry.getTotalTheta());
+        if (_has_odometry)
+        {
+            const T dx = current.x - _last_odometry.x;
+            const T dy = current.y - _last_odometry.y;
+            const T c = std::cos(_last_odometry.theta);
+            const T s = std::sin(_last_odometry.theta);
+            predict(Pose2D<T>(c * dx + s * dy, -s * dx + c * dy, current.theta - _last_odometry.theta));
+        }
+        _last_odometry = current;
+        _has_odometry = true;
+    }
+
+    /**
+     * @brief 尤度場モデルで観測する
+     * @details 各測定点を各パーティクルの位置姿勢で地図座標系に変換し，距離変換から最も近い障害物までの距離を引いて誤差とする
+     *          地図の範囲外の測定点はmax_distanceの誤差とする
+     * @param field: 地図の距離変換
+     * @param points: 測定点（ロボット座標系．ScanProjector::project()でセンサの位置姿勢を指定して求めたもの）
+     */
+    void updateLikelihoodField(const DistanceTransform<T> &field, const Vector2Array<T> &points)
+    {
+        const size_t count = points.size();
+        if (count == 0)
+            return;
+        const size_t step = getBeamStep(count);
+        const OccupancyGridView<T> &geometry = field.getGeometry();
+        const T max_distance = field.getMaxDistance();
+
+        _pool.parallelFor(size(), [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const T c = Angles::fastCos(_particles.theta[i]);
+                const T s = Angles::fastSin(_particles.theta[i]);
+                T log_likelihood = 0;
+                for (size_t j = 0; j < count; j += step)
+                {
+                    const T x = _particles.x[i] + c * points.x[j] - s * points.y[j];
+                    const T y = _particles.y[i] + s * points.x[j] + c * points.y[j];
+                    long long ix, iy;
+                    const T distance = geometry.worldToCell(x, y, ix, iy) ? field.getDistance(ix, iy) : max_distance;
+                    log_likelihood += getBeamLogLikelihood(distance);
+                }
+                _log_likelihood[i] = log_likelihood;
+            }
+        });
+        applyLikelihood();
+    }
+
+    /**
+     * @brief ビームモデルで観測する
+     * @details 各パーティクルの位置からRayCasterでスキャンをシミュレーションし，測定した距離との差を誤差とする
+     *          距離が0以下，range_max以上，または有限でない測定は使用しない
+     * @param map: 地図（Line2DIndex, OccupancyGridViewなどgetRayDistance()を持つ型）
+     * @param caster: 観測に使用するビームの角度を設定したRayCaster
+     * @param ranges: 測定した距離（casterのi番目のビームはranges[i * stride]）
+     * @param stride: rangesの間隔（LaserScanを間引いてcasterを作った場合はその間隔）
+     * @param range_max: 最大距離[m]
+     * @param laser_pose: センサの位置姿勢（ロボット座標系）
+     */
+    template <class Map>
+    void updateBeamModel(const Map &map, const RayCaster<T> &caster, const float *ranges, size_t stride, T range_max, const Pose2D<T> &laser_pose)
+    {
+        const size_t beams = caster.size();
+        if (beams == 0)
+            return;
+        _expected.resize(_pool.size() * beams); // 2回目以降は確保しない
+
+        _pool.parallelFor(size(), [&](size_t chunk, size_t begin, size_t end) {
+            float *expected = _expected.data() + chunk * beams;
+            for (size_t i = begin; i < end; ++i)
+            {
+                const T c = Angles::fastCos(_particles.theta[i]);
+                const T s = Angles::fastSin(_particles.theta[i]);
+                const Pose2D<T> sensor(_particles.x[i] + c * laser_pose.x - s * laser_pose.y,
+                                       _particles.y[i] + s * laser_pose.x + c * laser_pose.y,
+                                       _particles.theta[i] + laser_pose.theta);
+                caster.cast(map, sensor, expected);
+                T log_likelihood = 0;
+                for (size_t j = 0; j < beams; ++j)
+                {
+                    const T range = (T)ranges[j * stride];
+                    if (!(range > 0 && range < range_max))
+                        continue;
+                    log_likelihood += getBeamLogLikelihood(range - (T)expected[j]);
+                }
+                _log_likelihood[i] = log_likelihood;
+            }
+        });
+        applyLikelihood();
+    }
+
+    /**
+     * @brief パーティクルの数を返す
+     * @return パーティクルの数
+     */
+    size_t size() const
+    {
+        return _particles.size();
+    }
+
+    /**
+     * @brief パーティクルを返す
+     * @return パーティクルの位置姿勢
+     */
+    const Pose2DArray<T> &getParticles() const
+    {
+        return _particles;
+    }
+
+    /**
+     * @brief パーティクルの重みを返す
+     * @return 重み（合計1）
+     */
+    const std::vector<T> &getWeights() const
+    {
+        return _weights;
+    }
+
+    /**
+     * @brief 推定した位置姿勢を返す
+     * @return 重み付き平均（thetaは円周平均）
+     */
+    const Pose2D<T> &getPose() const
+    {
+        return _pose;
+    }
+
+    /**
+     * @brief 推定した位置姿勢の共分散を返す
+     * @return 共分散行列（x, y, thetaの3x3，行優先）
+     */
+    const std::array<T, 9> &getCovariance() const
+    {
+        return _covariance;
+    }
+
+    /**
+     * @brief 有効パーティクル数を返す
+     * @return 1 / Σ重み^2（前回の観測での値）
+     */
+    T getEffectiveSampleSize() const
+    {
+        return _effective_sample_size;
+    }
+
+    /**
+     * @brief 前回の観測でリサンプリングしたかどうか
+     * @return リサンプリングしたかどうか
+     */
+    bool isResampled() const
+    {
+        return _resampled;
+    }
+
+private:
+    struct random_t
+    {
+        std::mt19937 engine;
+        std::normal_distribution<T> normal;
+
+        explicit random_t(uint32_t seed) : engine(seed), normal(0, 1) {}
+    };
+
+    param_t _param;
+    ThreadPool _pool;
+    std::vector<random_t> _random; // 区間ごとの乱数生成器
+    Pose2DArray<T> _particles;
+    Pose2DArray<T> _next; // リサンプリング先
+    std::vector<T> _weights;
+    std::vector<T> _log_likelihood;
+    std::vector<float> _expected; // 区間ごとのシミュレーションしたスキャン
+
+    Pose2D<T> _last_odometry;
+    bool _has_odometry = false;
+
+    Pose2D<T> _pose;
+    std::array<T, 9> _covariance{};
+    T _effective_sample_size = 0;
+    bool _resampled = false;
+
+    size_t getBeamStep(size_t count) const
+    {
+        return _param.max_beams > 0 ? std::max<size_t>((count + _param.max_beams - 1) / _param.max_beams, 1) : 1;
+    }
+
+    T getBeamLogLikelihood(T error) const
+    {
+        const T sigma = _param.sigma_hit;
+        return std::log(_param.z_hit * std::exp(-error * error / (2 * sigma * sigma)) + _param.z_rand);
+    }
+
+    // 対数尤度を重みに掛けて正規化し，必要ならリサンプリングする
+    void applyLikelihood()
+    {
+        const T max_log_likelihood = *std::max_element(_log_likelihood.begin(), _log_likelihood.end());
+        T sum = 0;
+        for (size_t i = 0; i < size(); ++i)
+        {
+            _weights[i] *= std::exp(_log_likelihood[i] - max_log_likelihood);
+            sum += _weights[i];
+        }
+
+        T square_sum = 0;
+        if (sum > 0 && std::isfinite(sum))
+        {
+            for (auto &weight : _weights)
+            {
+                weight /= sum;
+                square_sum += weight * weight;
+            }
+        }
+        else
+        {
+            // 全てのパーティクルの尤度がゼロの場合は一様に戻す
+            std::fill(_weights.begin(), _weights.end(), (T)1 / (T)size());
+            square_sum = (T)1 / (T)size();
+        }
+        _effective_sample_size = (T)1 / square_sum;
+
+        estimate();
+        _resampled = _effective_sample_size < _param.resample_threshold * (T)size();
+        if (_resampled)
+            resample();
+    }
+
+    // 系統的（低分散）リサンプリング
+    void resample()
+    {
+        const size_t n = size();
+        const T step = (T)1 / (T)n;
+        std::uniform_real_distribution<T> uniform(0, step);
+        T target = uniform(_random[0].engine);
+        T cumulative = _weights[0];
+        size_t j = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            while (target > cumulative && j + 1 < n)
+                cumulative += _weights[++j];
+            _next.x[i] = _particles.x[j];
+            _next.y[i] = _particles.y[j];
+            _next.theta[i] = _particles.theta[j];
+            target += step;
+        }
+        std::swap(_particles, _next);
+        std::fill(_weights.begin(), _weights.end(), step);
+    }
+
+    // 重み付き平均と共分散を求める
+    void estimate()
+    {
+        T x = 0, y = 0, c = 0, s = 0;
+        for (size_t i = 0; i < size(); ++i)
+        {
+            const T w = _weights[i];
+            x += w * _particles.x[i];
+            y += w * _particles.y[i];
+            c += w * Angles::fastCos(_particles.theta[i]);
+            s += w * Angles::fastSin(_particles.theta[i]);
+        }
+        _pose = Pose2D<T>(x, y, std::atan2(s, c));
+
+        T xx = 0, xy = 0, xt = 0, yy = 0, yt = 0, tt = 0;
+        for (size_t i = 0; i < size(); ++i)
+        {
+            const T w = _weights[i];
+            const T dx = _particles.x[i] - _pose.x;
+            const T dy = _particles.y[i] - _pose.y;
+            const T dt = (T)Angles::getShortestAngle(_pose.theta, _particles.theta[i]);
+            xx += w * dx * dx;
+            xy += w * dx * dy;
+            xt += w * dx * dt;
+            yy += w * dy * dy;
+            yt += w * dy * dt;
+            tt += w * dt * dt;
+        }
+        _covariance = {xx, xy, xt, xy, yy, yt, xt, yt, tt};
+    }
+};
+}
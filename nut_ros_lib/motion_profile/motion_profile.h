@@ -0,0 +1,406 @@
+/**
+ * @file motion_profile.h
+ * @brief 台形・S字の速度プロファイル
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+
+namespace nut_ros
+{
+/**
+ * @brief 速度プロファイルの種類
+ */
+enum class MotionProfileType
+{
+    Trapezoidal = 0, /**< 台形（加速度の上限のみ） */
+    SCurve           /**< S字（加加速度の上限あり） */
+};
+
+/**
+ * @brief 台形・S字の速度プロファイル
+ * @details plan()で一度だけプロファイルを求め，加加速度一定の区分3次多項式として固定長の配列に保持する
+ *          制御周期ごとのget()は高々MAX_SEGMENTS個の区間から該当区間を探して多項式を評価するだけで，平方根や場合分けを行わない
+ *          動作中の再計画（replan()）も含めてメモリの確保は発生しない
+ *          初速度は任意（目標から遠ざかる向きや止まりきれない場合は一度停止してから戻る），終速度はゼロ
+ * @attention 各上限値は正でなければならない（S字でmax_jerkがゼロ以下の場合は台形として計画する）
+ *            S字の再計画は現在の加速度をゼロとみなして行う
+ * @code
+ * nut_ros::MotionProfile<double> profile(nut_ros::MotionProfileType::SCurve, 1.0, 2.0, 10.0);
+ * profile.plan(0.0, 3.0);
+ * // 制御周期ごと
+ * pid.update(profile.getPosition(t), now_position, dt);
+ * @endcode
+**/
+template <typename T>
+class MotionProfile
+{
+public:
+    static constexpr size_t MAX_SEGMENTS = 16; /**< 保持できる区間の最大数 */
+
+    /**
+     * @brief 状態（位置，速度，加速度）
+     */
+    struct state_t
+    {
+        T position;     /**< 位置 */
+        T velocity;     /**< 速度 */
+        T acceleration; /**< 加速度 */
+    };
+
+    /**
+     * @brief コンストラクタ
+     */
+    MotionProfile() = default;
+
+    /**
+     * @brief コンストラクタ 種類と上限値で初期化
+     * @param type: プロファイルの種類
+     * @param max_velocity: 最大速度
+     * @param max_acceleration: 最大加速度
+     * @param max_jerk: 最大加加速度（S字のみ使用）
+     */
+    MotionProfile(MotionProfileType type, T max_velocity, T max_acceleration, T max_jerk = 0)
+        : _type(type), _max_velocity(max_velocity), _max_acceleration(max_acceleration), _max_jerk(max_jerk) {}
+
+    /**
+     * @brief 種類の設定
+     * @param type: プロファイルの種類
+     * @attention 次のplan()から反映される
+     */
+    void setType(MotionProfileType type)
+    {
+        _type = type;
+    }
+
+    /**
+     * @brief 上限値の設定
+     * @param max_velocity: 最大速度
+     * @param max_acceleration: 最大加速度
+     * @param max_jerk: 最大加加速度（S字のみ使用）
+     * @attention 次のplan()から反映される
+     */
+    void setLimit(T max_velocity, T max_acceleration, T max_jerk = 0)
+    {
+        _max_velocity = max_velocity;
+        _max_acceleration = max_acceleration;
+        _max_jerk = max_jerk;
+    }
+
+    /**
+     * @brief プロファイルを計画する
+     * @details 時刻0で位置start，速度start_velocityから始まり，位置targetで静止するプロファイルを求める
+     * @param start: 開始位置
+     * @param target: 目標位置
+     * @param start_velocity: 開始時の速度
+     */
+    void plan(T start, T target, T start_velocity = 0)
+    {
+        _size = 0;
+        _duration = 0;
+        _start = start;
+        _target = target;
+        _p = start;
+        _v = start_velocity;
+        _a = 0;
+        if (_type == MotionProfileType::SCurve && _max_jerk > 0)
+            planSCurve();
+        else
+            planTrapezoidal();
+    }
+
+    /**
+     * @brief 動作中に目標位置を変更して再計画する
+     * @details 時刻tの位置と速度から新しいプロファイルを計画し，時刻tを新しいプロファイルの時刻0とする
+     * @param t: 現在のプロファイルの時刻
+     * @param target: 新しい目標位置
+     */
+    void replan(T t, T target)
+    {
+        const state_t state = get(t);
+        plan(state.position, target, state.velocity);
+    }
+
+    /**
+     * @brief 時刻tの状態を返す
+     * @param t: プロファイル開始からの時刻
+     * @return 状態（t < 0の場合は開始時，t >= getDuration()の場合は目標位置で静止した状態）
+     */
+    state_t get(T t) const
+    {
+        if (t >= _duration || _size == 0)
+            return state_t{_target, 0, 0};
+        if (t < 0)
+            t = 0;
+        size_t i = _size - 1;
+        while (i > 0 && _segments[i].t0 > t)
+            --i;
+        const segment_t &seg = _segments[i];
+        const T tau = t - seg.t0;
+        state_t state;
+        state.position = seg.p0 + tau * (seg.v0 + tau * (seg.a0 * (T)0.5 + tau * seg.j * (T)(1.0 / 6.0)));
+        state.velocity = seg.v0 + tau * (seg.a0 + tau * seg.j * (T)0.5);
+        state.acceleration = seg.a0 + tau * seg.j;
+        return state;
+    }
+
+    /**
+     * @brief 時刻tの位置を返す
+     * @param t: プロファイル開始からの時刻
+     * @return 位置
+     */
+    T getPosition(T t) const
+    {
+        return get(t).position;
+    }
+
+    /**
+     * @brief 時刻tの速度を返す
+     * @param t: プロファイル開始からの時刻
+     * @return 速度
+     */
+    T getVelocity(T t) const
+    {
+        return get(t).velocity;
+    }
+
+    /**
+     * @brief 時刻tの加速度を返す
+     * @param t: プロファイル開始からの時刻
+     * @return 加速度
+     */
+    T getAcceleration(T t) const
+    {
+        return get(t).acceleration;
+    }
+
+    /**
+     * @brief プロファイルの所要時間を返す
+     * @return 所要時間
+     */
+    T getDuration() const
+    {
+        return _duration;
+    }
+
+    /**
+     * @brief 時刻tにプロファイルが終了しているかどうか
+     * @param t: プロファイル開始からの時刻
+     * @return 終了しているかどうか
+     */
+    bool isFinished(T t) const
+    {
+        return t >= _duration;
+    }
+
+    /**
+     * @brief 開始位置を返す
+     * @return 開始位置
+     */
+    T getStart() const
+    {
+        return _start;
+    }
+
+    /**
+     * @brief 目標位置を返す
+     * @return 目標位置
+     */
+    T getTarget() const
+    {
+        return _target;
+    }
+
+    /**
+     * @brief 区間の数を返す
+     * @return 区間の数
+     */
+    size_t getSegmentCount() const
+    {
+        return _size;
+    }
+
+private:
+    // 加加速度一定の区間
+    struct segment_t
+    {
+        T t0; // 開始時刻
+        T p0, v0, a0, j;
+    };
+
+    MotionProfileType _type = MotionProfileType::Trapezoidal;
+    T _max_velocity = 1;
+    T _max_acceleration = 1;
+    T _max_jerk = 0;
+
+    std::array<segment_t, MAX_SEGMENTS> _segments;
+    size_t _size = 0;
+    T _duration = 0;
+    T _start = 0, _target = 0;
+    T _p = 0, _v = 0, _a = 0; // 計画中の区間終端の状態
+
+    static T sign(T x)
+    {
+        return x < 0 ? -1 : 1;
+    }
+
+    // 時間tauだけ，加速度a0・加加速度jの区間を追加する
+    void push(T tau, T a0, T j)
+    {
+        if (!(tau > 0) || _size >= MAX_SEGMENTS)
+            return;
+        segment_t &seg = _segments[_size++];
+        seg.t0 = _duration;
+        seg.p0 = _p;
+        seg.v0 = _v;
+        seg.a0 = a0;
+        seg.j = j;
+        _p += tau * (_v + tau * (a0 * (T)0.5 + tau * j * (T)(1.0 / 6.0)));
+        _v += tau * (a0 + tau * j * (T)0.5);
+        _a = a0 + tau * j;
+        _duration += tau;
+    }
+
+    ///////////////// 台形 /////////////////
+    void planTrapezoidal()
+    {
+        const T a = _max_acceleration;
+        T d = _target - _p;
+
+        // 目標から遠ざかる向きに動いている，または止まりきれない場合はまず停止する
+        const T stop_distance = _v * std::abs(_v) / (2 * a);
+        if (_v * d < 0 || std::abs(stop_distance) > std::abs(d))
+        {
+            push(std::abs(_v) / a, -sign(_v) * a, 0);
+            _v = 0;
+            d = _target - _p;
+        }
+
+        const T s = sign(d);
+        const T h = std::abs(d);
+        const T v0 = std::abs(_v);
+        const T vp = v0 > _max_velocity ? _max_velocity : std::min(_max_velocity, std::sqrt(a * h + v0 * v0 * (T)0.5));
+        const T a1 = vp >= v0 ? a : -a;
+        const T d1 = (vp * vp - v0 * v0) / (2 * a1);
+        const T d3 = vp * vp / (2 * a);
+        const T t2 = vp > 0 ? std::max<T>(h - d1 - d3, 0) / vp : 0;
+
+        push((vp - v0) / a1, s * a1, 0);
+        push(t2, 0, 0);
+        push(vp / a, -s * a, 0);
+    }
+
+    ///////////////// S字 /////////////////
+    // 加速度ゼロから速度をdvだけ変化させて加速度ゼロに戻る区間の，加加速度が働く時間Tjと全体の時間
+    void getVelocityChangeTime(T dv, T &tj, T &time) const
+    {
+        const T j = _max_jerk, a = _max_acceleration;
+        if (dv * j < a * a)
+        {
+            tj = std::sqrt(dv / j);
+            time = 2 * tj;
+        }
+        else
+        {
+            tj = a / j;
+            time = tj + dv / a;
+        }
+    }
+
+    // 加加速度+-jの区間（tj），加速度一定の区間，加加速度-+jの区間（tj）の計time
+    void pushJerkPhase(T tj, T time, T s)
+    {
+        const T j = s * _max_jerk;
+        push(tj, _a, j);
+        push(time - 2 * tj, _a, 0);
+        push(tj, _a, -j);
+        _a = 0;
+    }
+
+    // 現在の速度から速度vへ変化させる
+    void pushVelocityChange(T v)
+    {
+        T tj, time;
+        getVelocityChangeTime(std::abs(v - _v), tj, time);
+        pushJerkPhase(tj, time, sign(v - _v));
+        _v = v;
+    }
+
+    T getStopDistance(T v) const
+    {
+        T tj, time;
+        getVelocityChangeTime(v, tj, time);
+        return v * time * (T)0.5;
+    }
+
+    void planSCurve()
+    {
+        // 停止や最大速度までの減速を挟んだ後に，目標方向へ速度が最大速度以下の状態から計画する
+        for (int iteration = 0; iteration < 4; ++iteration)
+        {
+            const T d = _target - _p;
+            if (_v * d < 0 || (_v != 0 && getStopDistance(std::abs(_v)) > std::abs(d)))
+            {
+                pushVelocityChange(0);
+                continue;
+            }
+            const T s = sign(d);
+            if (std::abs(_v) > _max_velocity)
+            {
+                pushVelocityChange(s * _max_velocity);
+                continue;
+            }
+            planDoubleS(std::abs(d), std::abs(_v), s);
+            return;
+        }
+    }
+
+    // 終速度ゼロのS字（L. Biagiotti, C. Melchiorri, "Trajectory Planning for Automatic Machines and Robots", 3.4）
+    void planDoubleS(T h, T v0, T s)
+    {
+        const T j = _max_jerk;
+        const T vmax = _max_velocity;
+
+        // 最大速度に到達する場合
+        T tj1, ta, tj2, td;
+        getVelocityChangeTime(vmax - v0, tj1, ta);
+        getVelocityChangeTime(vmax, tj2, td);
+        const T tv = h / vmax - ta * (T)0.5 * (1 + v0 / vmax) - td * (T)0.5;
+        if (tv >= 0)
+        {
+            pushJerkPhase(tj1, ta, s);
+            push(tv, 0, 0);
+            pushJerkPhase(tj2, td, -s);
+            return;
+        }
+
+        // 最大速度に到達しない場合は，加減速区間が成立するまで最大加速度を下げる
+        T a = _max_acceleration;
+        for (int iteration = 0; iteration < 1000; ++iteration)
+        {
+            const T tj = a / j;
+            const T delta = a * a * a * a / (j * j) + 2 * v0 * v0 + a * (4 * h - 2 * a / j * v0);
+            ta = (a * a / j - 2 * v0 + std::sqrt(delta)) / (2 * a);
+            td = (a * a / j + std::sqrt(delta)) / (2 * a);
+            if (ta < 0)
+            {
+                // 減速のみで目標に到達する
+                td = 2 * h / v0;
+                tj2 = (j * h - std::sqrt(j * std::max<T>(j * h * h - v0 * v0 * v0, 0))) / (j * v0);
+                pushJerkPhase(tj2, td, -s);
+                return;
+            }
+            if (ta >= 2 * tj && td >= 2 * tj)
+            {
+                pushJerkPhase(tj, ta, s);
+                pushJerkPhase(tj, td, -s);
+                return;
+            }
+            a *= (T)0.99;
+        }
+        // 収束しない場合（実用上は起こらない）
+        pushJerkPhase(std::min(ta, td) * (T)0.5, ta, s);
+        pushJerkPhase(std::min(ta, td) * (T)0.5, td, -s);
+    }
+};
+}
@@ -0,0 +1,226 @@
+/**
+ * @file pose_2D_profile.h
+ * @brief Pose2D（x, y, theta）の速度プロファイル
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./../angles/angles.h"
+#include "./../vector/pose_2D.h"
+#include "./../vector/vector2.h"
+#include "./motion_profile.h"
+
+namespace nut_ros
+{
+/**
+ * @brief Pose2D（x, y, theta）の速度プロファイル
+ * @details 並進は開始位置から目標位置までの距離に対して1つのMotionProfileを計画し，その単位方向ベクトルに射影してx, yとする
+ *          そのため経路は開始位置と目標位置を結ぶ直線となり，斜め方向でも並進の速度，加速度は上限値以下となる
+ *          thetaは回転の上限値で独立したMotionProfileを計画し，Angles::getShortestAngle()で求めた最短方向に回転する（get〜()では-pi～+piに正規化して返す）
+ *          並進と回転の所要時間は異なり，全体の所要時間はその最大値となる
+ * @attention 開始時の並進速度は進行方向の成分のみを使用する（直交する成分は無視される）
+ * @code
+ * nut_ros::Pose2DProfile<double> profile(nut_ros::MotionProfileType::Trapezoidal, 0.5, 1.0, 0.0, 1.0, 2.0, 0.0);
+ * profile.plan(current_pose, goal_pose);
+ * // 制御周期ごと
+ * const nut_ros::Pose2D<double> target = profile.getPose(t);
+ * pid_x.update(target.x, current_pose.x, dt);
+ * @endcode
+**/
+template <typename T>
+class Pose2DProfile
+{
+public:
+    /**
+     * @brief コンストラクタ
+     */
+    Pose2DProfile() = default;
+
+    /**
+     * @brief コンストラクタ 種類と上限値で初期化
+     * @param type: プロファイルの種類
+     * @param max_linear_velocity: 最大並進速度[m/s]
+     * @param max_linear_acceleration: 最大並進加速度[m/s^2]
+     * @param max_linear_jerk: 最大並進加加速度[m/s^3]（S字のみ使用）
+     * @param max_angular_velocity: 最大角速度[rad/s]
+     * @param max_angular_acceleration: 最大角加速度[rad/s^2]
+     * @param max_angular_jerk: 最大角加加速度[rad/s^3]（S字のみ使用）
+     */
+    Pose2DProfile(MotionProfileType type,
+                  T max_linear_velocity, T max_linear_acceleration, T max_linear_jerk,
+                  T max_angular_velocity, T max_angular_acceleration, T max_angular_jerk)
+        : _linear(type, max_linear_velocity, max_linear_acceleration, max_linear_jerk),
+          _theta(type, max_angular_velocity, max_angular_acceleration, max_angular_jerk) {}
+
+    /**
+     * @brief 種類の設定
+     * @param type: プロファイルの種類
+     * @attention 次のplan()から反映される
+     */
+    void setType(MotionProfileType type)
+    {
+        _linear.setType(type);
+        _theta.setType(type);
+    }
+
+    /**
+     * @brief 並進の上限値の設定
+     * @param max_velocity: 最大並進速度[m/s]
+     * @param max_acceleration: 最大並進加速度[m/s^2]
+     * @param max_jerk: 最大並進加加速度[m/s^3]（S字のみ使用）
+     * @attention 次のplan()から反映される
+     */
+    void setLinearLimit(T max_velocity, T max_acceleration, T max_jerk = 0)
+    {
+        _linear.setLimit(max_velocity, max_acceleration, max_jerk);
+    }
+
+    /**
+     * @brief 回転の上限値の設定
+     * @param max_velocity: 最大角速度[rad/s]
+     * @param max_acceleration: 最大角加速度[rad/s^2]
+     * @param max_jerk: 最大角加加速度[rad/s^3]（S字のみ使用）
+     * @attention 次のplan()から反映される
+     */
+    void setAngularLimit(T max_velocity, T max_acceleration, T max_jerk = 0)
+    {
+        _theta.setLimit(max_velocity, max_acceleration, max_jerk);
+    }
+
+    /**
+     * @brief プロファイルを計画する
+     * @param start: 開始姿勢
+     * @param goal: 目標姿勢
+     * @param start_velocity: 開始時の速度（x, y, thetaの各成分の速度．x, yは進行方向の成分のみ使用）
+     */
+    void plan(const Pose2D<T> &start, const Pose2D<T> &goal, const Pose2D<T> &start_velocity = Pose2D<T>(0, 0, 0))
+    {
+        planLinear(start.x, start.y, goal.x, goal.y, start_velocity.x, start_velocity.y);
+        _theta.plan(start.theta, start.theta + (T)Angles::getShortestAngle(start.theta, goal.theta), start_velocity.theta);
+    }
+
+    /**
+     * @brief 動作中に目標姿勢を変更して再計画する
+     * @details 時刻tの姿勢と速度から新しいプロファイルを計画し，時刻tを新しいプロファイルの時刻0とする
+     * @param t: 現在のプロファイルの時刻
+     * @param goal: 新しい目標姿勢
+     */
+    void replan(T t, const Pose2D<T> &goal)
+    {
+        const typename MotionProfile<T>::state_t linear = _linear.get(t);
+        planLinear(_start_x + _direction_x * linear.position, _start_y + _direction_y * linear.position, goal.x, goal.y,
+                   _direction_x * linear.velocity, _direction_y * linear.velocity);
+        const T theta = _theta.getPosition(t);
+        _theta.replan(t, theta + (T)Angles::getShortestAngle(theta, goal.theta));
+    }
+
+    /**
+     * @brief 時刻tの姿勢を返す
+     * @param t: プロファイル開始からの時刻
+     * @return 姿勢（thetaは-pi～+piに正規化）
+     */
+    Pose2D<T> getPose(T t) const
+    {
+        const T s = _linear.getPosition(t);
+        return Pose2D<T>(_start_x + _direction_x * s, _start_y + _direction_y * s, (T)Angles::normalize(_theta.getPosition(t)));
+    }
+
+    /**
+     * @brief 時刻tの速度を返す
+     * @param t: プロファイル開始からの時刻
+     * @return 速度（x, y, thetaの各成分の速度）
+     */
+    Pose2D<T> getVelocity(T t) const
+    {
+        const T v = _linear.getVelocity(t);
+        return Pose2D<T>(_direction_x * v, _direction_y * v, _theta.getVelocity(t));
+    }
+
+    /**
+     * @brief 時刻tの加速度を返す
+     * @param t: プロファイル開始からの時刻
+     * @return 加速度（x, y, thetaの各成分の加速度）
+     */
+    Pose2D<T> getAcceleration(T t) const
+    {
+        const T a = _linear.getAcceleration(t);
+        return Pose2D<T>(_direction_x * a, _direction_y * a, _theta.getAcceleration(t));
+    }
+
+    /**
+     * @brief プロファイルの所要時間を返す
+     * @return 並進と回転の所要時間の最大値
+     */
+    T getDuration() const
+    {
+        return std::max(_linear.getDuration(), _theta.getDuration());
+    }
+
+    /**
+     * @brief 時刻tに全ての軸のプロファイルが終了しているかどうか
+     * @param t: プロファイル開始からの時刻
+     * @return 終了しているかどうか
+     */
+    bool isFinished(T t) const
+    {
+        return t >= getDuration();
+    }
+
+    /**
+     * @brief 並進のプロファイルを返す
+     * @details 位置は開始位置からの進行方向の距離
+     * @return 並進のプロファイル
+     */
+    const MotionProfile<T> &getLinear() const
+    {
+        return _linear;
+    }
+
+    /**
+     * @brief 並進の進行方向を返す
+     * @return 進行方向の単位ベクトル
+     */
+    Vector2<T> getDirection() const
+    {
+        return Vector2<T>(_direction_x, _direction_y);
+    }
+
+    /**
+     * @brief theta軸のプロファイルを返す
+     * @details 位置は正規化されていない（開始角度から連続した値）
+     * @return theta軸のプロファイル
+     */
+    const MotionProfile<T> &getTheta() const
+    {
+        return _theta;
+    }
+
+private:
+    MotionProfile<T> _linear, _theta;
+    T _start_x = 0, _start_y = 0;
+    T _direction_x = 1, _direction_y = 0; // 進行方向の単位ベクトル
+
+    // 開始位置から目標位置までの距離に対して並進のプロファイルを計画する
+    void planLinear(T start_x, T start_y, T goal_x, T goal_y, T start_velocity_x, T start_velocity_y)
+    {
+        const T dx = goal_x - start_x;
+        const T dy = goal_y - start_y;
+        const T distance = std::sqrt(dx * dx + dy * dy);
+        const T speed = std::sqrt(start_velocity_x * start_velocity_x + start_velocity_y * start_velocity_y);
+        _start_x = start_x;
+        _start_y = start_y;
+        if (distance > 0)
+        {
+            _direction_x = dx / distance;
+            _direction_y = dy / distance;
+        }
+        else if (speed > 0)
+        {
+            // 目標位置にいる場合は現在の速度の向きに止まってから戻る
+            _direction_x = start_velocity_x / speed;
+            _direction_y = start_velocity_y / speed;
+        }
+        _linear.plan(0, distance, _direction_x * start_velocity_x + _direction_y * start_velocity_y);
+    }
+};
+}
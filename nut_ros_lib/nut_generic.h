@@ -1,6 +1,7 @@
 /**
  * @file nut_generic.h
  * @brief 数多のinclude管理と各種汎用的な関数を提供
+ * @details ROSのメッセージ型を全てincludeする互換用のヘッダ．ROSに依存しない部分はnut_generic_core.hを参照
  * @author Ryoga Sato
  * @date 2021/03/25
 **/
@@ -8,6 +9,8 @@
 
 #include <bits/stdc++.h>
 
+#include "./nut_generic_core.h"
+
 #include <ros/ros.h>
 
 #include <std_msgs/Bool.h>
@@ -125,19 +128,3 @@
 #include <diagnostic_updater/diagnostic_updater.h>
 
 #include <jsk_rviz_plugins/OverlayText.h>
-
-namespace nut_ros
-{
-    /**
-     * @brief 汎用関数群
-    **/
-    class Generic
-    {
-    public:
-        template <typename T>
-        static inline T guard(T x, T min, T max)
-        {
-            return ((x) < (min) ? (min) : ((x) > (max) ? (max) : (x)));
-        }
-    };
-} // namespace nut_ros
@@ -0,0 +1,33 @@
+/**
+ * @file nut_generic_core.h
+ * @brief ROSに依存しない標準ライブラリのinclude管理と各種汎用的な関数を提供
+ * @details Vector2, Pose2D, Line2D, Angles, PIDなどのコア部分はこのファイルのみに依存する
+ * @author Ryoga Sato
+ * @date 2021/03/25
+**/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace nut_ros
+{
+    /**
+     * @brief 汎用関数群
+    **/
+    class Generic
+    {
+    public:
+        template <typename T>
+        static inline T guard(T x, T min, T max)
+        {
+            return ((x) < (min) ? (min) : ((x) > (max) ? (max) : (x)));
+        }
+    };
+} // namespace nut_ros
@@ -0,0 +1,55 @@
+#pragma once
+#include "./nut_generic_core.h"
+
+// angles
+#include "./angles/angles.h"
+
+// vector
+#include "./vector/rotation_2D.h"
+#include "./vector/vec_n.h"
+#include "./vector/vector2.h"
+#include "./vector/pose_2D.h"
+#include "./vector/vector3.h"
+#include "./vector/segment_2D.h"
+#include "./vector/line_2D.h"
+#include "./vector/line_2D_index.h"
+#include "./vector/ray_caster.h"
+#include "./vector/scan_projector.h"
+#include "./vector/line_extractor.h"
+#include "./vector/polygon_geometry.h"
+#include "./vector/transform_2D.h"
+#include "./vector/vector2_array.h"
+#include "./vector/pose_2D_array.h"
+
+// stopwatch
+#include "./stopwatch/timing_stats.h"
+#include "./stopwatch/steady_stopwatch.h"
+#include "./stopwatch/profiler.h"
+
+// feedback_controller
+#include "./feedback_controller/PID.h"
+#include "./feedback_controller/PID_bank.h"
+
+// path_follower
+#include "./path_follower/indexed_path.h"
+#include "./path_follower/pure_pursuit.h"
+
+// motion_profile
+#include "./motion_profile/motion_profile.h"
+#include "./motion_profile/pose_2D_profile.h"
+
+// odometry
+#include "./odometry/wheel_kinematics.h"
+#include "./odometry/odometry_integrator.h"
+
+// grid
+#include "./grid/occupancy_grid_view.h"
+#include "./grid/distance_transform.h"
+
+// realtime
+#include "./realtime/latest_value.h"
+#include "./realtime/control_loop_executor.h"
+#include "./realtime/thread_pool.h"
+
+// localization
+#include "./localization/particle_filter.h"
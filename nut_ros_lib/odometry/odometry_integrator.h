@@ -0,0 +1,250 @@
+/**
+ * @file odometry_integrator.h
+ * @brief 車輪の回転量からオドメトリ（位置姿勢）を積算する
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./../angles/angles.h"
+#include "./../vector/pose_2D.h"
+#include "./wheel_kinematics.h"
+
+namespace nut_ros {
+/**
+ * @brief 車輪の回転量からオドメトリ（位置姿勢）を積算する
+ * @details 1周期の間の速度が一定（円弧運動）として厳密に積分する（Pose2Dの+=とrotate()による近似より誤差が小さい）
+ *          向きのcos, sinは1周期の回転量のcos, sinとの積で更新し，回転量が小さい場合はテイラー展開で求めるため，周期ごとの三角関数の計算は不要
+ *          （丸め誤差の蓄積を防ぐため，RESYNC_INTERVAL周期ごとに積算した角度から計算し直す）
+ *          x, y, thetaの積算には補償付きの加算（Kahan-Babuska）を使用し，長時間積算しても丸め誤差が蓄積しない
+ *          動的確保は行わない
+ * @code
+ * nut_ros::OdometryIntegrator<double> odometry(nut_ros::WheelKinematics<double>::differential(0.05, 0.3));
+ * odometry.setEncoderResolution(4096);
+ * // エンコーダの値を受信するたび
+ * odometry.updateCounts(count_deltas, dt);
+ * nut_ros::MsgGenerator::fill(odom_msg, "odom", "base_link", odometry.getPose(), odometry.getTwist());
+ * @endcode
+**/
+template <typename T>
+class OdometryIntegrator
+{
+public:
+    static constexpr size_t RESYNC_INTERVAL = 256; /**< 向きのcos, sinを角度から計算し直す周期数 */
+
+    /**
+     * @brief コンストラクタ
+     */
+    OdometryIntegrator() = default;
+
+    /**
+     * @brief コンストラクタ 運動学で初期化
+     * @param kinematics: 運動学
+     * @param initial: 初期の位置姿勢
+     */
+    explicit OdometryIntegrator(const WheelKinematics<T> &kinematics, const Pose2D<T> &initial = Pose2D<T>(0, 0, 0))
+        : _kinematics(kinematics)
+    {
+        reset(initial);
+    }
+
+    /**
+     * @brief 運動学の設定
+     * @param kinematics: 運動学
+     */
+    void setKinematics(const WheelKinematics<T> &kinematics)
+    {
+        _kinematics = kinematics;
+    }
+
+    /**
+     * @brief 運動学の取得
+     * @return 運動学
+     */
+    const WheelKinematics<T> &getKinematics() const
+    {
+        return _kinematics;
+    }
+
+    /**
+     * @brief エンコーダの分解能の設定（updateCounts()で使用）
+     * @param counts_per_revolution: 車輪1回転あたりのカウント数
+     */
+    void setEncoderResolution(T counts_per_revolution)
+    {
+        _radian_per_count = counts_per_revolution != 0 ? (T)(2 * M_PI) / counts_per_revolution : 0;
+    }
+
+    /**
+     * @brief 位置姿勢をリセットする
+     * @param pose: 位置姿勢
+     */
+    void reset(const Pose2D<T> &pose = Pose2D<T>(0, 0, 0))
+    {
+        _x.reset(pose.x);
+        _y.reset(pose.y);
+        _theta.reset(pose.theta);
+        _twist = Pose2D<T>(0, 0, 0);
+        resync();
+    }
+
+    /**
+     * @brief 1周期分の車輪の回転角度で更新する
+     * @param wheel_delta: 各車輪の前回からの回転角度[rad]（運動学の車輪の数だけ）
+     * @param dt: 前回からの時間[sec]（速度の計算に使用．ゼロ以下の場合は速度を更新しない）
+     */
+    void update(const T *wheel_delta, T dt)
+    {
+        T dx, dy, dtheta;
+        _kinematics.toBody(wheel_delta, dx, dy, dtheta);
+        integrate(dx, dy, dtheta, dt);
+    }
+
+    /**
+     * @brief 1周期分のエンコーダのカウントで更新する
+     * @param count_delta: 各車輪の前回からのカウント数（運動学の車輪の数だけ）
+     * @param dt: 前回からの時間[sec]（速度の計算に使用．ゼロ以下の場合は速度を更新しない）
+     */
+    void updateCounts(const int32_t *count_delta, T dt)
+    {
+        T wheel_delta[WheelKinematics<T>::MAX_WHEELS];
+        for (size_t i = 0; i < _kinematics.size(); ++i)
+            wheel_delta[i] = (T)count_delta[i] * _radian_per_count;
+        update(wheel_delta, dt);
+    }
+
+    /**
+     * @brief 複数周期分の車輪の回転角度でまとめて更新する
+     * @details マイコンから複数周期分のエンコーダの値をまとめて受信した場合などに使用する
+     * @param wheel_deltas: 各周期の各車輪の回転角度[rad]（周期ごとに運動学の車輪の数だけ並べたもの）
+     * @param samples: 周期の数
+     * @param dt: 1周期の時間[sec]
+     */
+    void updateBatch(const T *wheel_deltas, size_t samples, T dt)
+    {
+        const size_t n = _kinematics.size();
+        for (size_t k = 0; k < samples; ++k)
+            update(wheel_deltas + k * n, dt);
+    }
+
+    /**
+     * @brief ロボット座標系の移動量で更新する
+     * @details 運動学を使用せずに，IMUと組み合わせた移動量などを積算する場合に使用する
+     * @param dx: 前方向の移動量[m]
+     * @param dy: 左方向の移動量[m]
+     * @param dtheta: 回転量[rad]
+     * @param dt: 前回からの時間[sec]（速度の計算に使用．ゼロ以下の場合は速度を更新しない）
+     */
+    void integrate(T dx, T dy, T dtheta, T dt)
+    {
+        // 1周期の回転量のsin, cosと，円弧の補正係数 sin(a)/a, (1-cos(a))/a
+        T s, c, sinc, cosc;
+        const T a2 = dtheta * dtheta;
+        if (std::abs(dtheta) < (T)0.05)
+        {
+            sinc = 1 - a2 / 6 * (1 - a2 / 20 * (1 - a2 / 42));
+            cosc = dtheta / 2 * (1 - a2 / 12 * (1 - a2 / 30 * (1 - a2 / 56)));
+            s = dtheta * sinc;
+            c = 1 - dtheta * cosc;
+        }
+        else
+        {
+            s = std::sin(dtheta);
+            c = std::cos(dtheta);
+            sinc = s / dtheta;
+            cosc = (1 - c) / dtheta;
+        }
+
+        // 円弧に沿った移動量（前回の向きの座標系）を地図座標系に回転して加算する
+        const T local_x = dx * sinc - dy * cosc;
+        const T local_y = dx * cosc + dy * sinc;
+        _x.add(_cos * local_x - _sin * local_y);
+        _y.add(_sin * local_x + _cos * local_y);
+        _theta.add(dtheta);
+
+        if (++_steps >= RESYNC_INTERVAL)
+        {
+            resync();
+        }
+        else
+        {
+            const T next_cos = _cos * c - _sin * s;
+            _sin = _sin * c + _cos * s;
+            _cos = next_cos;
+        }
+
+        if (dt > 0)
+            _twist = Pose2D<T>(dx / dt, dy / dt, dtheta / dt);
+    }
+
+    /**
+     * @brief 位置姿勢を返す
+     * @return 位置姿勢（thetaは-pi～+piに正規化）
+     */
+    Pose2D<T> getPose() const
+    {
+        return Pose2D<T>(_x.get(), _y.get(), (T)Angles::normalize(_theta.get()));
+    }
+
+    /**
+     * @brief 積算した角度を返す
+     * @return 角度[rad]（正規化していない連続した値）
+     */
+    T getTotalTheta() const
+    {
+        return _theta.get();
+    }
+
+    /**
+     * @brief 最後に更新した周期の速度を返す
+     * @return ロボット座標系の速度（x: 前方向[m/s], y: 左方向[m/s], theta: 角速度[rad/s]）
+     */
+    const Pose2D<T> &getTwist() const
+    {
+        return _twist;
+    }
+
+private:
+    // 補償付きの加算（Kahan-Babuska / Neumaier）
+    struct compensated_t
+    {
+        T sum = 0;
+        T compensation = 0;
+
+        void reset(T value)
+        {
+            sum = value;
+            compensation = 0;
+        }
+
+        void add(T value)
+        {
+            const T next = sum + value;
+            if (std::abs(sum) >= std::abs(value))
+                compensation += (sum - next) + value;
+            else
+                compensation += (value - next) + sum;
+            sum = next;
+        }
+
+        T get() const
+        {
+            return sum + compensation;
+        }
+    };
+
+    WheelKinematics<T> _kinematics;
+    T _radian_per_count = 0;
+    compensated_t _x, _y, _theta;
+    T _cos = 1, _sin = 0; // 向きのcos, sin
+    size_t _steps = 0;    // 前回resync()してからの周期数
+    Pose2D<T> _twist;
+
+    void resync()
+    {
+        const T theta = _theta.get();
+        _cos = std::cos(theta);
+        _sin = std::sin(theta);
+        _steps = 0;
+    }
+};
+}
@@ -0,0 +1,188 @@
+/**
+ * @file wheel_kinematics.h
+ * @brief 車輪の回転量とロボットの移動量の関係（運動学）
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+
+namespace nut_ros {
+/**
+ * @brief 車輪の回転量とロボットの移動量の関係（運動学）
+ * @details 逆運動学（ロボット座標系の移動量(dx, dy, dtheta)から各車輪の回転角度）の行列Jを生成時に作り，
+ *          順運動学はその擬似逆行列 (J^T J)^-1 J^T を一度だけ計算して保持する（車輪が4輪以上の場合は最小二乗解となる）
+ *          動けない方向（二輪差動のy方向）は移動量ゼロとして扱う
+ *          車輪の回転角度の正の向きは，二輪差動とメカナムではロボットを前進させる向き，オムニではロボットを反時計回りに回す向きとする
+ * @code
+ * const auto kinematics = nut_ros::WheelKinematics<double>::mecanum(0.05, 0.2, 0.15);
+ * @endcode
+**/
+template <typename T>
+class WheelKinematics
+{
+public:
+    static constexpr size_t MAX_WHEELS = 4; /**< 車輪の最大数 */
+
+    using row_t = std::array<T, 3>; /**< 逆運動学の行列の1行（dx, dy, dthetaの係数） */
+
+    /**
+     * @brief コンストラクタ
+     */
+    WheelKinematics() = default;
+
+    /**
+     * @brief コンストラクタ 逆運動学の行列で初期化
+     * @param rows: 各車輪の回転角度[rad] = rows[i][0] * dx + rows[i][1] * dy + rows[i][2] * dtheta となる係数
+     * @param count: 車輪の数（MAX_WHEELS以下）
+     */
+    WheelKinematics(const row_t *rows, size_t count)
+    {
+        set(rows, count);
+    }
+
+    /**
+     * @brief 二輪差動
+     * @param wheel_radius: 車輪の半径[m]
+     * @param tread: 左右の車輪の間隔[m]
+     * @return 運動学（車輪の順番は左, 右）
+     */
+    static WheelKinematics differential(T wheel_radius, T tread)
+    {
+        const T k = 1 / wheel_radius;
+        const row_t rows[2] = {{k, 0, -tread / 2 * k}, {k, 0, tread / 2 * k}};
+        return WheelKinematics(rows, 2);
+    }
+
+    /**
+     * @brief オムニホイール（3輪，4輪など，中心から等距離に等間隔で配置したもの）
+     * @param count: 車輪の数（3以上MAX_WHEELS以下）
+     * @param wheel_radius: 車輪の半径[m]
+     * @param base_radius: ロボットの中心から車輪までの距離[m]
+     * @param first_angle: 最初の車輪の，ロボットの中心から見た取り付け角度[rad]（x軸正の向きが0，反時計回りに順番に並べる）
+     * @return 運動学
+     */
+    static WheelKinematics omni(size_t count, T wheel_radius, T base_radius, T first_angle = 0)
+    {
+        row_t rows[MAX_WHEELS];
+        if (count > MAX_WHEELS)
+            count = MAX_WHEELS;
+        const T k = 1 / wheel_radius;
+        for (size_t i = 0; i < count; ++i)
+        {
+            // 駆動方向は取り付け角度から90度回した向き
+            const T angle = first_angle + (T)(2 * M_PI) * (T)i / (T)count;
+            rows[i] = {-std::sin(angle) * k, std::cos(angle) * k, base_radius * k};
+        }
+        return WheelKinematics(rows, count);
+    }
+
+    /**
+     * @brief メカナムホイール（ローラーの角度45度）
+     * @param wheel_radius: 車輪の半径[m]
+     * @param half_length: ロボットの中心から前後の車軸までの距離[m]
+     * @param half_width: ロボットの中心から左右の車輪までの距離[m]
+     * @return 運動学（車輪の順番は左前, 右前, 左後, 右後）
+     */
+    static WheelKinematics mecanum(T wheel_radius, T half_length, T half_width)
+    {
+        const T k = 1 / wheel_radius;
+        const T l = (half_length + half_width) * k;
+        const row_t rows[4] = {{k, -k, -l}, {k, k, l}, {k, k, -l}, {k, -k, l}};
+        return WheelKinematics(rows, 4);
+    }
+
+    /**
+     * @brief 逆運動学の行列を設定し，順運動学の行列を計算する
+     * @param rows: 各車輪の回転角度[rad] = rows[i][0] * dx + rows[i][1] * dy + rows[i][2] * dtheta となる係数
+     * @param count: 車輪の数（MAX_WHEELS以下）
+     */
+    void set(const row_t *rows, size_t count)
+    {
+        _count = count;
+        if (_count > MAX_WHEELS)
+            _count = MAX_WHEELS;
+        for (size_t i = 0; i < _count; ++i)
+            _inverse[i] = rows[i];
+
+        // J^T J（動けない方向は対角成分を1にして正則にする．その方向のJ^Tの行はゼロなので移動量もゼロになる）
+        T a[3][3] = {};
+        for (size_t i = 0; i < _count; ++i)
+            for (size_t r = 0; r < 3; ++r)
+                for (size_t c = 0; c < 3; ++c)
+                    a[r][c] += _inverse[i][r] * _inverse[i][c];
+        for (size_t r = 0; r < 3; ++r)
+            if (a[r][r] == 0)
+                a[r][r] = 1;
+
+        // 余因子による逆行列
+        T inv[3][3];
+        inv[0][0] = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+        inv[0][1] = a[0][2] * a[2][1] - a[0][1] * a[2][2];
+        inv[0][2] = a[0][1] * a[1][2] - a[0][2] * a[1][1];
+        inv[1][0] = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+        inv[1][1] = a[0][0] * a[2][2] - a[0][2] * a[2][0];
+        inv[1][2] = a[0][2] * a[1][0] - a[0][0] * a[1][2];
+        inv[2][0] = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+        inv[2][1] = a[0][1] * a[2][0] - a[0][0] * a[2][1];
+        inv[2][2] = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+        const T det = a[0][0] * inv[0][0] + a[0][1] * inv[1][0] + a[0][2] * inv[2][0];
+        const T inv_det = det != 0 ? 1 / det : 0;
+
+        for (size_t r = 0; r < 3; ++r)
+        {
+            for (size_t i = 0; i < _count; ++i)
+            {
+                T sum = 0;
+                for (size_t c = 0; c < 3; ++c)
+                    sum += inv[r][c] * _inverse[i][c];
+                _forward[r][i] = sum * inv_det;
+            }
+        }
+    }
+
+    /**
+     * @brief 車輪の数を返す
+     * @return 車輪の数
+     */
+    size_t size() const
+    {
+        return _count;
+    }
+
+    /**
+     * @brief 各車輪の回転角度からロボット座標系の移動量を求める（順運動学）
+     * @param wheel: 各車輪の回転角度[rad]（size()個）
+     * @param dx: 前方向の移動量[m]の出力先
+     * @param dy: 左方向の移動量[m]の出力先
+     * @param dtheta: 回転量[rad]の出力先
+     */
+    void toBody(const T *wheel, T &dx, T &dy, T &dtheta) const
+    {
+        T out[3] = {0, 0, 0};
+        for (size_t r = 0; r < 3; ++r)
+            for (size_t i = 0; i < _count; ++i)
+                out[r] += _forward[r][i] * wheel[i];
+        dx = out[0];
+        dy = out[1];
+        dtheta = out[2];
+    }
+
+    /**
+     * @brief ロボット座標系の移動量から各車輪の回転角度を求める（逆運動学）
+     * @param dx: 前方向の移動量[m]
+     * @param dy: 左方向の移動量[m]
+     * @param dtheta: 回転量[rad]
+     * @param wheel: 各車輪の回転角度[rad]の出力先（size()個）
+     */
+    void toWheel(T dx, T dy, T dtheta, T *wheel) const
+    {
+        for (size_t i = 0; i < _count; ++i)
+            wheel[i] = _inverse[i][0] * dx + _inverse[i][1] * dy + _inverse[i][2] * dtheta;
+    }
+
+private:
+    size_t _count = 0;
+    std::array<row_t, MAX_WHEELS> _inverse{};            // 逆運動学（車輪 x 3）
+    std::array<std::array<T, MAX_WHEELS>, 3> _forward{}; // 順運動学（3 x 車輪）
+};
+}
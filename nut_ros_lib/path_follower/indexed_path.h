@@ -0,0 +1,264 @@
+/**
+ * @file indexed_path.h
+ * @brief 経路追従のために前処理した経路（線分と累積距離）
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./../angles/angles.h"
+#include "./../vector/pose_2D.h"
+#include "./../vector/pose_2D_array.h"
+#include "./../vector/line_2D.h"
+
+#include <limits>
+
+namespace nut_ros {
+
+/**
+ * @brief 経路追従のために前処理した経路（線分と累積距離）
+ * @details 経路の各点を結ぶ線分（Line2D）と，各線分の始点までの累積距離（弧長）を保持する
+ *          弧長から線分を探すfindSegment()は，前回の結果をヒントとして渡すと経路を前進する限り償却O(1)で求まる
+ *          連続する同一点（長さゼロの線分）は取り除かれる
+ * @code
+ * nut_ros::Pose2DArray<double> poses;
+ * nut_ros::MsgDecoder::getPose2DArray(path_msg, poses);
+ * nut_ros::IndexedPath<double> path(poses);
+ * @endcode
+**/
+template <typename T>
+class IndexedPath
+{
+public:
+    /**
+     * @brief コンストラクタ
+     */
+    IndexedPath() = default;
+
+    /**
+     * @brief コンストラクタ 経路の点列で初期化
+     * @param poses: 経路の点列
+     */
+    explicit IndexedPath(const Pose2DArray<T> &poses)
+    {
+        set(poses);
+    }
+
+    /**
+     * @brief コンストラクタ 経路の点列で初期化
+     * @param poses: 経路の点列
+     */
+    explicit IndexedPath(const std::vector<Pose2D<T>> &poses)
+    {
+        set(poses);
+    }
+
+    /**
+     * @brief 経路を設定する
+     * @param poses: 経路の点列
+     */
+    void set(const Pose2DArray<T> &poses)
+    {
+        build(poses.size(), [&](size_t i) { return Pose2D<T>(poses.x[i], poses.y[i], poses.theta[i]); });
+    }
+
+    /**
+     * @brief 経路を設定する
+     * @param poses: 経路の点列
+     */
+    void set(const std::vector<Pose2D<T>> &poses)
+    {
+        build(poses.size(), [&](size_t i) { return poses[i]; });
+    }
+
+    /**
+     * @brief 経路を空にする
+     */
+    void clear()
+    {
+        _segments.clear();
+        _arc.clear();
+        _length = 0;
+    }
+
+    /**
+     * @brief 経路が空かどうか
+     * @return 経路が空かどうか
+     */
+    bool empty() const
+    {
+        return _segments.empty();
+    }
+
+    /**
+     * @brief 線分の数を返す
+     * @details 経路が1点のみの場合は長さゼロの線分が1つとなる
+     * @return 線分の数
+     */
+    size_t getSegmentCount() const
+    {
+        return _segments.size();
+    }
+
+    /**
+     * @brief 線分の配列を返す
+     * @return 線分の配列
+     */
+    const std::vector<Line2D<T>> &getSegments() const
+    {
+        return _segments;
+    }
+
+    /**
+     * @brief 経路の全長を返す
+     * @return 経路の全長[m]
+     */
+    T getLength() const
+    {
+        return _length;
+    }
+
+    /**
+     * @brief 線分の始点までの弧長を返す
+     * @param segment: 線分の番号
+     * @return 弧長[m]
+     */
+    T getArcLength(size_t segment) const
+    {
+        return _arc[segment];
+    }
+
+    /**
+     * @brief 経路の始点を返す
+     * @return 始点
+     */
+    const Pose2D<T> &getStart() const
+    {
+        return _segments.front().getStart();
+    }
+
+    /**
+     * @brief 経路の終点を返す
+     * @return 終点
+     */
+    const Pose2D<T> &getGoal() const
+    {
+        return _segments.back().getEnd();
+    }
+
+    /**
+     * @brief 弧長sの位置を含む線分を探す
+     * @details hintの線分から前方に探索するため，sが単調増加する場合は償却O(1)となる
+     *          sがhintの線分より手前の場合は二分探索を行う
+     * @param s: 弧長[m]
+     * @param hint: 探索を始める線分の番号
+     * @return 線分の番号（sが範囲外の場合は最初または最後の線分）
+     */
+    size_t findSegment(T s, size_t hint = 0) const
+    {
+        const size_t n = _segments.size();
+        if (hint >= n || s < _arc[hint])
+            hint = std::max<size_t>(std::upper_bound(_arc.begin(), _arc.end(), s) - _arc.begin(), 1) - 1;
+        while (hint + 1 < n && _arc[hint + 1] <= s)
+            ++hint;
+        return hint;
+    }
+
+    /**
+     * @brief 弧長sの位置の姿勢を返す
+     * @details 角度は線分の始点と終点の角度を最短方向に補間したもの
+     * @param s: 弧長[m]（0からgetLength()の範囲に制限される）
+     * @param hint: 探索を始める線分の番号（findSegment()を参照）
+     * @return 姿勢
+     */
+    Pose2D<T> getPose(T s, size_t hint = 0) const
+    {
+        return getPoseOnSegment(findSegment(s, hint), s);
+    }
+
+    /**
+     * @brief 指定した線分上の弧長sの位置の姿勢を返す
+     * @param segment: 線分の番号
+     * @param s: 弧長[m]（線分の範囲に制限される）
+     * @return 姿勢
+     */
+    Pose2D<T> getPoseOnSegment(size_t segment, T s) const
+    {
+        const Line2D<T> &line = _segments[segment];
+        const T length = line.getLength();
+        const T t = Generic::guard<T>(s - _arc[segment], 0, length);
+        const Vector2<T> dir = line.getDirection();
+        const T ratio = length > 0 ? t / length : 0;
+        const T theta = (T)Angles::normalize(line.getStart().theta + Angles::getShortestAngle(line.getStart().theta, line.getEnd().theta) * ratio);
+        return Pose2D<T>(line.getStart().x + dir.x * t, line.getStart().y + dir.y * t, theta);
+    }
+
+    /**
+     * @brief 点に最も近い経路上の位置を探す
+     * @details 線分firstから，始点の弧長がmax_arc以下の線分までを探索する（線分firstは必ず含む）
+     *          距離が等しい場合は番号の小さい線分を返す
+     * @param p: 点
+     * @param first: 探索を始める線分の番号
+     * @param max_arc: 探索する線分の始点の弧長の上限[m]（経路全体を探索する場合は無限大）
+     * @return 線分の番号, 最近傍点の弧長[m], 最近傍点までの距離[m]
+     */
+    std::tuple<size_t, T, T> project(const Pose2D<T> &p, size_t first = 0, T max_arc = std::numeric_limits<T>::infinity()) const
+    {
+        const size_t n = _segments.size();
+        first = std::min(first, n - 1);
+        size_t best = first;
+        T best_t = 0;
+        T best_d2 = std::numeric_limits<T>::infinity();
+        for (size_t i = first; i < n && (i == first || _arc[i] <= max_arc); ++i)
+        {
+            const Line2D<T> &line = _segments[i];
+            const Vector2<T> dir = line.getDirection();
+            const T ox = p.x - line.getStart().x;
+            const T oy = p.y - line.getStart().y;
+            const T t = Generic::guard<T>(ox * dir.x + oy * dir.y, 0, line.getLength());
+            const T hx = ox - dir.x * t;
+            const T hy = oy - dir.y * t;
+            const T d2 = hx * hx + hy * hy;
+            if (d2 < best_d2)
+            {
+                best = i;
+                best_t = t;
+                best_d2 = d2;
+            }
+        }
+        return std::make_tuple(best, _arc[best] + best_t, std::sqrt(best_d2));
+    }
+
+private:
+    std::vector<Line2D<T>> _segments; // 各点を結ぶ線分
+    std::vector<T> _arc;              // 各線分の始点までの弧長
+    T _length = 0;                    // 全長
+
+    template <typename Getter>
+    void build(const size_t n, Getter get)
+    {
+        clear();
+        if (n == 0)
+            return;
+        _segments.reserve(n > 1 ? n - 1 : 1);
+        _arc.reserve(n > 1 ? n - 1 : 1);
+
+        Pose2D<T> prev = get(0);
+        for (size_t i = 1; i < n; ++i)
+        {
+            const Pose2D<T> p = get(i);
+            if (p.x == prev.x && p.y == prev.y)
+                continue;
+            _segments.emplace_back(prev, p);
+            _arc.push_back(_length);
+            _length += _segments.back().getLength();
+            prev = p;
+        }
+        if (_segments.empty())
+        {
+            // 1点のみの経路は長さゼロの線分として扱う
+            _segments.emplace_back(prev, prev);
+            _arc.push_back(0);
+        }
+    }
+};
+}
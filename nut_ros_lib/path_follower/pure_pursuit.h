@@ -0,0 +1,281 @@
+/**
+ * @file pure_pursuit.h
+ * @brief Pure Pursuitによる経路追従
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./../vector/pose_2D.h"
+#include "./../vector/pose_2D_array.h"
+#include "./indexed_path.h"
+
+#include <limits>
+
+namespace nut_ros {
+
+/**
+ * @brief Pure Pursuitによる経路追従
+ * @details 経路上の最近傍点と前方注視点は，経路に沿って単調に進むカーソルから前方の一定範囲（search_window）のみを探索して求めるため，
+ *          経路長によらず1周期あたり償却O(1)で計算できる
+ *          最初のupdate()とrelocalize()の後のみ経路全体を探索する
+ *          出力はロボット座標系の速度（x: 前進速度[m/s], y: 0, theta: 角速度[rad/s]）で，
+ *          MsgGenerator::toTwist()でgeometry_msgs::Twistに変換したり，各成分をPIDの目標値として使用したりできる
+ * @code
+ * nut_ros::PurePursuit<double> follower(param);
+ * follower.setPath(poses);
+ * // 制御周期ごと
+ * const nut_ros::Pose2D<double> velocity = follower.update(robot_pose);
+ * cmd_vel_pub.publish(nut_ros::MsgGenerator::toTwist(velocity));
+ * @endcode
+**/
+template <typename T>
+class PurePursuit
+{
+public:
+    /**
+     * @brief パラメータ構造体
+     */
+    struct param_t
+    {
+        T lookahead_distance = 0.5; /**< 前方注視距離[m] */
+        T lookahead_gain = 0.0;     /**< 速度に比例して前方注視距離を伸ばす係数[s] */
+        T max_linear_speed = 0.5;   /**< 最大前進速度[m/s] */
+        T max_angular_speed = 1.0;  /**< 最大角速度[rad/s] */
+        T max_deceleration = 0.5;   /**< ゴール手前（経路に沿った残りの距離）での減速度[m/s^2]（ゼロの場合は減速しない） */
+        T goal_tolerance = 0.05;    /**< ゴールに到達したとみなす距離[m] */
+        T search_window = 1.0;      /**< 最近傍点を探す範囲（カーソルからの弧長）[m] */
+    };
+
+    /**
+     * @brief コンストラクタ
+     */
+    PurePursuit() = default;
+
+    /**
+     * @brief コンストラクタ パラメータ構造体で初期化
+     * @param param: パラメータ構造体
+     */
+    explicit PurePursuit(const param_t &param) : _param(param) {}
+
+    /**
+     * @brief パラメータの設定
+     * @param param: パラメータ構造体
+     */
+    void setParam(const param_t &param)
+    {
+        _param = param;
+    }
+
+    /**
+     * @brief パラメータの取得
+     * @return パラメータ構造体
+     */
+    const param_t &getParam() const
+    {
+        return _param;
+    }
+
+    /**
+     * @brief 経路を設定する
+     * @param poses: 経路の点列
+     */
+    void setPath(const Pose2DArray<T> &poses)
+    {
+        _path.set(poses);
+        reset();
+    }
+
+    /**
+     * @brief 経路を設定する
+     * @param poses: 経路の点列
+     */
+    void setPath(const std::vector<Pose2D<T>> &poses)
+    {
+        _path.set(poses);
+        reset();
+    }
+
+    /**
+     * @brief 前処理済みの経路を返す
+     * @return 経路
+     */
+    const IndexedPath<T> &getPath() const
+    {
+        return _path;
+    }
+
+    /**
+     * @brief カーソルを経路の始点に戻す
+     * @details 次のupdate()では経路全体から最近傍点を探す
+     */
+    void reset()
+    {
+        _segment = 0;
+        _lookahead_segment = 0;
+        _arc = 0;
+        _cross_track_error = 0;
+        _speed = 0;
+        _goal_reached = _path.empty();
+        _need_relocalize = true;
+    }
+
+    /**
+     * @brief 次のupdate()で経路全体から最近傍点を探し直す
+     * @details 自己位置が大きく飛んだ場合などに使用する（カーソルは後退しうる）
+     */
+    void relocalize()
+    {
+        _need_relocalize = true;
+    }
+
+    /**
+     * @brief 現在の姿勢から速度指令を計算する
+     * @param pose: ロボットの姿勢（経路と同じ座標系）
+     * @return ロボット座標系の速度（x: 前進速度[m/s], y: 0, theta: 角速度[rad/s]，ゴール到達後はゼロ）
+     */
+    Pose2D<T> update(const Pose2D<T> &pose)
+    {
+        if (_path.empty())
+        {
+            _goal_reached = true;
+            return Pose2D<T>(0, 0, 0);
+        }
+
+        updateNearest(pose);
+
+        const Pose2D<T> &goal = _path.getGoal();
+        const T goal_dx = goal.x - pose.x;
+        const T goal_dy = goal.y - pose.y;
+        const T goal_distance = std::sqrt(goal_dx * goal_dx + goal_dy * goal_dy);
+        const T lookahead = _param.lookahead_distance + _param.lookahead_gain * std::abs(_speed);
+
+        // 経路が自身に近づく場合に途中でゴール判定しないよう，残りの弧長も確認する
+        if (_goal_reached || (goal_distance <= _param.goal_tolerance && getRemainingDistance() <= lookahead))
+        {
+            _goal_reached = true;
+            _speed = 0;
+            return Pose2D<T>(0, 0, 0);
+        }
+
+        // 前方注視点（カーソルと同様に単調に進める）
+        const T target_arc = std::min(_arc + lookahead, _path.getLength());
+        _lookahead_segment = _path.findSegment(target_arc, std::max(_lookahead_segment, _segment));
+        _lookahead_pose = _path.getPoseOnSegment(_lookahead_segment, target_arc);
+
+        // ロボット座標系での前方注視点
+        const T c = std::cos(pose.theta), s = std::sin(pose.theta);
+        const T dx = _lookahead_pose.x - pose.x;
+        const T dy = _lookahead_pose.y - pose.y;
+        const T local_x = c * dx + s * dy;
+        const T local_y = -s * dx + c * dy;
+        const T distance2 = local_x * local_x + local_y * local_y;
+        const T curvature = distance2 > std::numeric_limits<T>::epsilon() ? 2 * local_y / distance2 : 0;
+
+        // 減速は経路に沿った残りの距離で行う（周回経路などでは始点付近でゴールまでの直線距離がほぼゼロになるため）
+        T speed = _param.max_linear_speed;
+        if (_param.max_deceleration > 0)
+            speed = std::min(speed, std::sqrt(2 * _param.max_deceleration * getRemainingDistance()));
+
+        // 角速度が上限を超える場合は曲率を保ったまま減速する
+        T angular = speed * curvature;
+        if (std::abs(angular) > _param.max_angular_speed)
+        {
+            angular = std::copysign(_param.max_angular_speed, angular);
+            speed = angular / curvature;
+        }
+
+        _speed = speed;
+        return Pose2D<T>(speed, 0, angular);
+    }
+
+    /**
+     * @brief ゴールに到達したかどうか
+     * @return ゴールに到達したかどうか
+     */
+    bool isGoalReached() const
+    {
+        return _goal_reached;
+    }
+
+    /**
+     * @brief 最近傍点の弧長を返す
+     * @return 経路の始点から最近傍点までの弧長[m]
+     */
+    T getArcLength() const
+    {
+        return _arc;
+    }
+
+    /**
+     * @brief 最近傍点からゴールまでの残りの弧長を返す
+     * @return 残りの弧長[m]
+     */
+    T getRemainingDistance() const
+    {
+        return _path.getLength() - _arc;
+    }
+
+    /**
+     * @brief 経路からの横方向の偏差を返す
+     * @return 偏差[m]（経路の進行方向に対して左側が正）
+     */
+    T getCrossTrackError() const
+    {
+        return _cross_track_error;
+    }
+
+    /**
+     * @brief 最近傍点の属する線分の番号を返す
+     * @return 線分の番号
+     */
+    size_t getSegmentIndex() const
+    {
+        return _segment;
+    }
+
+    /**
+     * @brief 前回のupdate()で使用した前方注視点を返す
+     * @return 前方注視点
+     */
+    const Pose2D<T> &getLookaheadPose() const
+    {
+        return _lookahead_pose;
+    }
+
+private:
+    param_t _param;
+    IndexedPath<T> _path;
+
+    size_t _segment = 0;           // 最近傍点の属する線分（カーソル）
+    size_t _lookahead_segment = 0; // 前方注視点の属する線分
+    T _arc = 0;                    // 最近傍点の弧長
+    T _cross_track_error = 0;
+    T _speed = 0; // 前回出力した前進速度
+    Pose2D<T> _lookahead_pose;
+    bool _goal_reached = true;
+    bool _need_relocalize = true;
+
+    void updateNearest(const Pose2D<T> &pose)
+    {
+        size_t segment;
+        T arc;
+        if (_need_relocalize)
+        {
+            std::tie(segment, arc, std::ignore) = _path.project(pose);
+            _need_relocalize = false;
+            _arc = arc;
+            _lookahead_segment = segment;
+        }
+        else
+        {
+            std::tie(segment, arc, std::ignore) = _path.project(pose, _segment, _arc + _param.search_window);
+            _arc = std::max(_arc, arc); // カーソルは後退させない
+        }
+        _segment = segment;
+
+        const Line2D<T> &line = _path.getSegments()[_segment];
+        const Vector2<T> dir = line.getDirection();
+        _cross_track_error = dir.x * (pose.y - line.getStart().y) - dir.y * (pose.x - line.getStart().x);
+    }
+};
+}
@@ -0,0 +1,292 @@
+/**
+ * @file control_loop_executor.h
+ * @brief 登録した制御周期の処理を専用スレッドで一定周期に実行する
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./../stopwatch/profiler.h"
+
+#include <atomic>
+#include <cerrno>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+namespace nut_ros {
+/**
+ * @brief 登録した制御周期の処理を専用スレッドで一定周期に実行する
+ * @details 各処理の開始時刻を絶対時刻（CLOCK_MONOTONIC）で管理し，clock_nanosleep(TIMER_ABSTIME)で次の開始時刻まで待つため，
+ *          処理時間や起床の遅れが次の周期に累積しない
+ *          処理に渡すdtは計測値ではなく周期（周期を超過して実行できなかった回がある場合はその分を含めた周期の整数倍）で，PID::update()などにそのまま渡せる
+ *          スレッドはオプションでSCHED_FIFOの優先度とCPUの固定を設定できる（権限がない場合は通常のスケジューリングで動作する）
+ *          各処理の実行時間を"<name>/exec"，開始時刻からの起床の遅れを"<name>/jitter"としてProfilerに記録し，周期の超過で飛ばした周期の数を数える
+ *          ROSのコールバックはros::spin()などの別スレッドで処理し，値の受け渡しにはLatestValueを使用するとよい
+ * @attention 処理は全て同じスレッドで登録順に実行されるため，処理の中で長時間ブロックしないこと
+ * @code
+ * nut_ros::ControlLoopExecutor::param_t param;
+ * param.priority = 80;
+ * param.cpu = 3;
+ * nut_ros::ControlLoopExecutor executor(param);
+ * executor.add("wheel_pid", 0.001, [&](double dt) { pid.update(target.get(), encoder.get(), dt); });
+ * executor.start();
+ * ros::spin();
+ * @endcode
+**/
+class ControlLoopExecutor
+{
+public:
+    /**
+     * @brief パラメータ構造体
+     */
+    struct param_t
+    {
+        int priority = 0; /**< SCHED_FIFOの優先度（1〜99，0の場合はスケジューリングを変更しない） */
+        int cpu = -1;     /**< スレッドを固定するCPUの番号（負の場合は固定しない） */
+    };
+
+    using callback_t = std::function<void(double)>; /**< 周期処理（引数はdt[sec]） */
+
+    /**
+     * @brief コンストラクタ
+     */
+    ControlLoopExecutor() = default;
+
+    /**
+     * @brief コンストラクタ パラメータ構造体で初期化
+     * @param param: パラメータ構造体
+     */
+    explicit ControlLoopExecutor(const param_t &param) : _param(param) {}
+
+    /**
+     * @brief デストラクタ（スレッドを停止する）
+     */
+    ~ControlLoopExecutor()
+    {
+        stop();
+    }
+
+    ControlLoopExecutor(const ControlLoopExecutor &) = delete;
+    ControlLoopExecutor &operator=(const ControlLoopExecutor &) = delete;
+
+    /**
+     * @brief 周期処理を登録する
+     * @param name: 処理の名前（Profilerのスコープ名に使用）
+     * @param period: 周期[sec]
+     * @param callback: 周期処理（引数はdt[sec]）
+     * @return 処理のID（実行中やperiodが正でない場合は-1）
+     */
+    int add(const std::string &name, double period, callback_t callback)
+    {
+        if (isRunning() || !(period > 0) || !callback)
+            return -1;
+        std::unique_ptr<task_t> task(new task_t);
+        task->name = name;
+        task->period_ns = std::max<int64_t>((int64_t)std::llround(period * 1e9), 1);
+        task->callback = std::move(callback);
+        task->exec_id = Profiler::registerScope(name + "/exec");
+        task->jitter_id = Profiler::registerScope(name + "/jitter");
+        _tasks.push_back(std::move(task));
+        return (int)_tasks.size() - 1;
+    }
+
+    /**
+     * @brief スレッドを起動する
+     * @details スケジューリングとCPUの設定が終わるまで待ってから戻る（結果はisRealtime(), isPinned()で確認できる）
+     * @return 起動したかどうか（実行中や処理が未登録の場合はfalse）
+     */
+    bool start()
+    {
+        if (isRunning() || _tasks.empty())
+            return false;
+        _running.store(true, std::memory_order_release);
+        std::promise<void> ready;
+        std::future<void> ready_future = ready.get_future();
+        _thread = std::thread([this](std::promise<void> promise) { run(promise); }, std::move(ready));
+        ready_future.wait();
+        return true;
+    }
+
+    /**
+     * @brief スレッドを停止する
+     * @details 実行中の処理と，最も短い周期だけ待つ場合がある
+     */
+    void stop()
+    {
+        _running.store(false, std::memory_order_release);
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    /**
+     * @brief 実行中かどうか
+     * @return 実行中かどうか
+     */
+    bool isRunning() const
+    {
+        return _running.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief SCHED_FIFOで動作しているかどうか
+     * @return SCHED_FIFOの設定に成功したかどうか
+     */
+    bool isRealtime() const
+    {
+        return _realtime.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief CPUに固定されているかどうか
+     * @return CPUの固定に成功したかどうか
+     */
+    bool isPinned() const
+    {
+        return _pinned.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 登録した処理の数を返す
+     * @return 処理の数
+     */
+    size_t size() const
+    {
+        return _tasks.size();
+    }
+
+    /**
+     * @brief 処理を実行した回数を返す
+     * @param id: add()で取得した処理のID
+     * @return 実行した回数
+     */
+    uint64_t getExecutionCount(int id) const
+    {
+        return isValidId(id) ? _tasks[id]->execution_count.load(std::memory_order_relaxed) : 0;
+    }
+
+    /**
+     * @brief 周期の超過により実行せずに飛ばした周期の数を返す
+     * @details 処理の終了時に次の開始時刻を過ぎていた場合，過ぎた開始時刻の数だけ加算する（1回の超過で複数周期を飛ばすことがある）
+     * @param id: add()で取得した処理のID
+     * @return 飛ばした周期の数
+     */
+    uint64_t getOverrunCount(int id) const
+    {
+        return isValidId(id) ? _tasks[id]->overrun_count.load(std::memory_order_relaxed) : 0;
+    }
+
+private:
+    struct task_t
+    {
+        std::string name;
+        int64_t period_ns = 0;
+        callback_t callback;
+        int exec_id = -1;
+        int jitter_id = -1;
+        int64_t next_ns = 0; // 次の開始時刻（スレッドのみが使用する）
+        int64_t last_ns = 0; // 前回の開始時刻（スレッドのみが使用する）
+        std::atomic<uint64_t> execution_count{0};
+        std::atomic<uint64_t> overrun_count{0};
+    };
+
+    param_t _param;
+    std::vector<std::unique_ptr<task_t>> _tasks;
+    std::thread _thread;
+    std::atomic<bool> _running{false};
+    std::atomic<bool> _realtime{false};
+    std::atomic<bool> _pinned{false};
+
+    bool isValidId(int id) const
+    {
+        return id >= 0 && (size_t)id < _tasks.size();
+    }
+
+    static int64_t now()
+    {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+    }
+
+    static void sleepUntil(int64_t ns)
+    {
+        timespec ts;
+        ts.tv_sec = (time_t)(ns / 1000000000);
+        ts.tv_nsec = (long)(ns % 1000000000);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+            ; // シグナルで中断された場合は同じ時刻まで待ち直す
+    }
+
+    void configureThread()
+    {
+        if (_param.cpu >= 0)
+        {
+#ifdef __linux__
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            CPU_SET(_param.cpu, &cpu_set);
+            _pinned.store(pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0, std::memory_order_release);
+#endif
+        }
+        if (_param.priority > 0)
+        {
+            sched_param sched;
+            sched.sched_priority = _param.priority;
+            _realtime.store(pthread_setschedparam(pthread_self(), SCHED_FIFO, &sched) == 0, std::memory_order_release);
+        }
+    }
+
+    void run(std::promise<void> &ready)
+    {
+        configureThread();
+        ready.set_value();
+
+        const int64_t start_ns = now();
+        for (auto &task : _tasks)
+        {
+            task->next_ns = start_ns;
+            task->last_ns = start_ns - task->period_ns;
+        }
+
+        while (_running.load(std::memory_order_acquire))
+        {
+            int64_t wake_ns = _tasks[0]->next_ns;
+            for (const auto &task : _tasks)
+                wake_ns = std::min(wake_ns, task->next_ns);
+            sleepUntil(wake_ns);
+
+            for (auto &task : _tasks)
+            {
+                const int64_t begin_ns = now();
+                if (task->next_ns > begin_ns)
+                    continue;
+                Profiler::record(task->jitter_id, (uint64_t)(begin_ns - task->next_ns));
+
+                // dtは前回の開始時刻からの周期の整数倍
+                const int64_t dt_ns = task->next_ns - task->last_ns;
+                task->callback((double)dt_ns * 1e-9);
+                task->last_ns = task->next_ns;
+                task->execution_count.fetch_add(1, std::memory_order_relaxed);
+
+                const int64_t end_ns = now();
+                Profiler::record(task->exec_id, (uint64_t)(end_ns - begin_ns));
+
+                // 次の開始時刻を過ぎていた場合は，位相を保ったまま過ぎた周期を飛ばす
+                task->next_ns += task->period_ns;
+                if (task->next_ns <= end_ns)
+                {
+                    const int64_t skipped = (end_ns - task->next_ns) / task->period_ns + 1;
+                    task->overrun_count.fetch_add((uint64_t)skipped, std::memory_order_relaxed);
+                    task->next_ns += skipped * task->period_ns;
+                }
+            }
+        }
+    }
+};
+}
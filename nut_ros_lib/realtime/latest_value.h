@@ -0,0 +1,130 @@
+/**
+ * @file latest_value.h
+ * @brief スレッド間で最新の値をロックなしで受け渡す
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+
+#include <atomic>
+#include <type_traits>
+
+namespace nut_ros {
+/**
+ * @brief スレッド間で最新の値をロックなしで受け渡す（トリプルバッファ）
+ * @details 書き込み側と読み出し側がそれぞれ専用のバッファを持ち，残りの1つと原子的に交換することで受け渡す
+ *          書き込みも読み出しも待ちが発生せず（wait-free），書き込み側が途中で中断されても読み出し側は直前の値を即座に得られる
+ *          サブスクライバのコールバックで書き込み，制御ループで読み出す用途を想定している（間の値は捨てられ，常に最新の値のみが読める）
+ *          Pose2D, Vector2, PIDのparam_tなどのトリビアルコピー可能な型に使用できる
+ * @attention 書き込み側と読み出し側はそれぞれ同時に1スレッドまで（ROSのコールバックは同じサブスクライバについては並行に呼ばれない）
+ * @code
+ * nut_ros::LatestValue<nut_ros::Pose2D<double>> odom;
+ * // コールバック
+ * odom.write(nut_ros::MsgDecoder::getPose2D(msg->pose));
+ * // 制御ループ
+ * nut_ros::Pose2D<double> pose;
+ * if (odom.read(pose)) { ... } // 新しい値が届いていた場合
+ * @endcode
+**/
+template <typename T>
+class LatestValue
+{
+    static_assert(std::is_trivially_copyable<T>::value, "LatestValue requires a trivially copyable type");
+
+public:
+    /**
+     * @brief コンストラクタ
+     * @param initial: 最初に書き込まれるまでに読み出される値
+     */
+    explicit LatestValue(const T &initial = T())
+    {
+        for (auto &buffer : _buffers)
+            buffer.value = initial;
+    }
+
+    LatestValue(const LatestValue &) = delete;
+    LatestValue &operator=(const LatestValue &) = delete;
+
+    /**
+     * @brief 値を書き込む（書き込み側のスレッドから呼び出す）
+     * @param value: 値
+     */
+    void write(const T &value)
+    {
+        _buffers[_back].value = value;
+        const uint8_t previous = _middle.exchange((uint8_t)(_back | FRESH), std::memory_order_acq_rel);
+        _back = previous & INDEX_MASK;
+        _write_count.store(_write_count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 最新の値を読み出す（読み出し側のスレッドから呼び出す）
+     * @param value: 値の出力先（新しい値がない場合は前回と同じ値）
+     * @return 前回の読み出しの後に新しい値が書き込まれたかどうか
+     */
+    bool read(T &value)
+    {
+        const bool fresh = swapFront();
+        value = _buffers[_front].value;
+        return fresh;
+    }
+
+    /**
+     * @brief 最新の値を返す（読み出し側のスレッドから呼び出す）
+     * @return 最新の値
+     */
+    T get()
+    {
+        swapFront();
+        return _buffers[_front].value;
+    }
+
+    /**
+     * @brief 一度でも書き込まれたかどうか（どのスレッドからも呼び出せる）
+     * @return 書き込まれたかどうか
+     */
+    bool hasValue() const
+    {
+        return getWriteCount() > 0;
+    }
+
+    /**
+     * @brief 書き込まれた回数を返す（どのスレッドからも呼び出せる）
+     * @return 書き込まれた回数
+     */
+    uint64_t getWriteCount() const
+    {
+        return _write_count.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4; // 中間のバッファが読み出されていない新しい値かどうか
+
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    // 書き込み側と読み出し側でキャッシュラインを共有しないよう，間を空けて配置する
+    // （alignasはC++14のnewで保証されないため使用しない）
+    struct buffer_t
+    {
+        T value;
+        char padding[CACHE_LINE_SIZE];
+    };
+
+    buffer_t _buffers[3];
+    std::atomic<uint8_t> _middle{1};
+    std::atomic<uint64_t> _write_count{0};
+    char _padding0[CACHE_LINE_SIZE];
+    uint8_t _back = 2; // 書き込み側のみが使用する
+    char _padding1[CACHE_LINE_SIZE];
+    uint8_t _front = 0; // 読み出し側のみが使用する
+
+    bool swapFront()
+    {
+        if (!(_middle.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        _front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+};
+}
@@ -0,0 +1,91 @@
+/**
+ * @file latest_value_subscriber.h
+ * @brief 受信したメッセージをデコードしてLatestValueに書き込むサブスクライバ
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./../vector/vector2.h"
+#include "./../vector/pose_2D.h"
+#include "./../type_handler/msg_decoder.h"
+#include "./latest_value.h"
+
+#include <string>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <ros/ros.h>
+
+namespace nut_ros {
+
+/**
+ * @brief 受信したメッセージをデコードしてLatestValueに書き込むサブスクライバ
+ * @details コールバック内ではMsgDecoderのPose2D, Vector2版（ヒープ確保なし）でデコードし，そのままLatestValueに書き込む
+ *          制御ループはロックなしでLatestValue::read()するだけでよい
+ * @attention cellはサブスクライバより長く生存させること
+ * @code
+ * nut_ros::LatestValue<nut_ros::Pose2D<double>> odom;
+ * ros::Subscriber sub = nut_ros::LatestValueSubscriber::subscribePose2D<geometry_msgs::PoseStamped>(nh, "pose", 1, odom);
+ * @endcode
+**/
+class LatestValueSubscriber
+{
+public:
+    /**
+     * @brief MsgDecoder::getPose2D()でデコードしてPose2Dとして書き込む
+     * @tparam Msg: メッセージ型（geometry_msgs::Pose, PoseStamped, Twist, Accel）
+     * @param nh: ノードハンドル
+     * @param topic: トピック名
+     * @param queue_size: キューの長さ
+     * @param cell: 書き込み先
+     * @return サブスクライバ
+     */
+    template <class Msg, typename T>
+    static ros::Subscriber subscribePose2D(ros::NodeHandle &nh, const std::string &topic, uint32_t queue_size, LatestValue<Pose2D<T>> &cell)
+    {
+        return subscribe<Msg>(nh, topic, queue_size, cell, [](const Msg &msg) {
+            const Pose2D<double> pose = MsgDecoder::getPose2D(msg);
+            return Pose2D<T>((T)pose.x, (T)pose.y, (T)pose.theta);
+        });
+    }
+
+    /**
+     * @brief MsgDecoder::getLinearVector2()でデコードしてVector2として書き込む
+     * @tparam Msg: メッセージ型（geometry_msgs::Vector3, Point, Pose, PoseStamped, Twist, Accel）
+     * @param nh: ノードハンドル
+     * @param topic: トピック名
+     * @param queue_size: キューの長さ
+     * @param cell: 書き込み先
+     * @return サブスクライバ
+     */
+    template <class Msg, typename T>
+    static ros::Subscriber subscribeVector2(ros::NodeHandle &nh, const std::string &topic, uint32_t queue_size, LatestValue<Vector2<T>> &cell)
+    {
+        return subscribe<Msg>(nh, topic, queue_size, cell, [](const Msg &msg) {
+            const Vector2<double> v = MsgDecoder::getLinearVector2(msg);
+            return Vector2<T>((T)v.x, (T)v.y);
+        });
+    }
+
+    /**
+     * @brief 任意の関数でデコードして書き込む
+     * @details PIDのparam_tなど，MsgDecoderに対応する関数がない型に使用する
+     * @tparam Msg: メッセージ型
+     * @param nh: ノードハンドル
+     * @param topic: トピック名
+     * @param queue_size: キューの長さ
+     * @param cell: 書き込み先
+     * @param decoder: メッセージから値を求める関数（const Msg&を受け取りValueを返す）
+     * @return サブスクライバ
+     */
+    template <class Msg, typename Value, class Decoder>
+    static ros::Subscriber subscribe(ros::NodeHandle &nh, const std::string &topic, uint32_t queue_size, LatestValue<Value> &cell, Decoder decoder)
+    {
+        LatestValue<Value> *const target = &cell;
+        const boost::function<void(const boost::shared_ptr<const Msg> &)> callback =
+            [target, decoder](const boost::shared_ptr<const Msg> &msg) { target->write(decoder(*msg)); };
+        return nh.subscribe<Msg>(topic, queue_size, callback);
+    }
+};
+}
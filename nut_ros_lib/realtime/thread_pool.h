@@ -0,0 +1,150 @@
+/**
+ * @file thread_pool.h
+ * @brief 範囲を分割して複数のスレッドで並列に処理するスレッドプール
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace nut_ros {
+/**
+ * @brief 範囲を分割して複数のスレッドで並列に処理するスレッドプール
+ * @details スレッドは生成時に起動して待機させておくため，parallelFor()ごとのスレッドの生成や動的確保は行わない
+ *          範囲[0, count)をスレッド数の連続した区間に分割し，呼び出したスレッドも最初の区間を処理する
+ *          区間の分割はスレッド数と要素数のみで決まるため，区間ごとに乱数生成器などを持てば結果はスケジューリングによらない
+ * @attention parallelFor()は同時に1つのスレッドからのみ呼び出すこと
+ * @code
+ * nut_ros::ThreadPool pool(4);
+ * pool.parallelFor(particles.size(), [&](size_t chunk, size_t begin, size_t end) {
+ *     for (size_t i = begin; i < end; ++i)
+ *         weights[i] = evaluate(particles.get(i));
+ * });
+ * @endcode
+**/
+class ThreadPool
+{
+public:
+    /**
+     * @brief コンストラクタ
+     * @param thread_num: スレッド数（呼び出したスレッドを含む．0の場合はハードウェアの並列数）
+     */
+    explicit ThreadPool(size_t thread_num = 0)
+    {
+        if (thread_num == 0)
+            thread_num = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        _workers.reserve(thread_num - 1);
+        for (size_t i = 1; i < thread_num; ++i)
+            _workers.emplace_back([this, i]() { run(i); });
+    }
+
+    /**
+     * @brief デストラクタ（スレッドを停止する）
+     */
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _start.notify_all();
+        for (auto &worker : _workers)
+            worker.join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief スレッド数を返す
+     * @return スレッド数（呼び出したスレッドを含む）
+     */
+    size_t size() const
+    {
+        return _workers.size() + 1;
+    }
+
+    /**
+     * @brief 範囲[0, count)を分割して並列に処理する
+     * @details 全ての区間の処理が終わるまで戻らない
+     * @param count: 要素数
+     * @param func: 区間の処理（区間の番号(0〜size()-1), 開始位置, 終了位置を受け取る）
+     */
+    template <class Func>
+    void parallelFor(size_t count, const Func &func)
+    {
+        if (_workers.empty() || count <= 1)
+        {
+            func((size_t)0, (size_t)0, count);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _job.invoke = [](const void *context, size_t chunk, size_t begin, size_t end) {
+                (*static_cast<const Func *>(context))(chunk, begin, end);
+            };
+            _job.context = &func;
+            _job.count = count;
+            _pending = _workers.size();
+            ++_generation;
+        }
+        _start.notify_all();
+
+        runChunk(0);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this]() { return _pending == 0; });
+    }
+
+private:
+    struct job_t
+    {
+        void (*invoke)(const void *, size_t, size_t, size_t) = nullptr;
+        const void *context = nullptr;
+        size_t count = 0;
+    };
+
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    job_t _job;
+    uint64_t _generation = 0;
+    size_t _pending = 0;
+    bool _stop = false;
+
+    // 区間chunkの範囲を求めて処理する（_jobはparallelFor()が戻るまで変更されない）
+    void runChunk(size_t chunk)
+    {
+        const size_t step = (_job.count + size() - 1) / size();
+        const size_t begin = std::min(chunk * step, _job.count);
+        const size_t end = std::min(begin + step, _job.count);
+        if (begin < end)
+            _job.invoke(_job.context, chunk, begin, end);
+    }
+
+    void run(size_t chunk)
+    {
+        uint64_t generation = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _start.wait(lock, [&]() { return _stop || _generation != generation; });
+                if (_stop)
+                    return;
+                generation = _generation;
+            }
+
+            runChunk(chunk);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_pending == 0)
+                _done.notify_one();
+        }
+    }
+};
+}
@@ -0,0 +1,231 @@
+/**
+ * @file profiler.h
+ * @brief 名前付きスコープの処理時間をプロセス全体で集計するプロファイラ
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./steady_stopwatch.h"
+#include "./timing_stats.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace nut_ros
+{
+/**
+ * @brief 名前付きスコープの処理時間をプロセス全体で集計するプロファイラ
+ * @details 計測結果はスレッド毎のヒストグラム（TimingStats）に記録されるため，記録時にロックや共有変数への書き込みは発生しない
+ *          collect()で全スレッドの結果を合算して取得する（読み出しはシーケンスロックで書き込み側を待たせない）
+ *          通常はNUT_ROS_PROFILE_SCOPE(name)マクロで計測する．NUT_ROS_DISABLE_PROFILERを定義するとマクロは無効になる
+ * @code
+ * void callback(const sensor_msgs::LaserScan &msg)
+ * {
+ *     NUT_ROS_PROFILE_SCOPE("scan_callback");
+ *     // 計測したい処理
+ * }
+ * @endcode
+**/
+class Profiler
+{
+public:
+    static constexpr size_t MAX_SCOPES = 64; /**< 登録できるスコープ数の上限 */
+
+    /**
+     * @brief スコープ毎の集計結果
+     */
+    struct result_t
+    {
+        std::string name;  /**< スコープ名 */
+        TimingStats stats; /**< 全スレッドの合算 */
+    };
+
+    /**
+     * @brief スコープの登録
+     * @param name: スコープ名
+     * @return スコープID（登録済みの名前の場合は既存のID，上限を超えた場合は-1）
+     */
+    static int registerScope(const std::string &name)
+    {
+        state_t &state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        const size_t size = state.scope_size.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < size; ++i)
+            if (state.names[i] == name)
+                return (int)i;
+        if (size >= MAX_SCOPES)
+            return -1;
+        state.names[size] = name;
+        state.scope_size.store(size + 1, std::memory_order_release);
+        return (int)size;
+    }
+
+    /**
+     * @brief 計測結果の記録
+     * @param id: registerScope()で取得したスコープID（-1の場合は何もしない）
+     * @param ns: 計測時間[nsec]
+     */
+    static inline void record(int id, uint64_t ns)
+    {
+        if (id < 0)
+            return;
+        slot_t &slot = getSlot(id);
+        const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.stats.add(ns);
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief 全スレッドの計測結果を合算して取得
+     * @return 登録順のスコープ毎の集計結果
+     */
+    static std::vector<result_t> collect()
+    {
+        std::vector<result_t> results;
+        collect(results);
+        return results;
+    }
+
+    /**
+     * @brief 全スレッドの計測結果を合算して取得
+     * @param results: 登録順のスコープ毎の集計結果（要素数は自動で合わせる）
+     */
+    static void collect(std::vector<result_t> &results)
+    {
+        state_t &state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        const size_t size = state.scope_size.load(std::memory_order_relaxed);
+        results.resize(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            results[i].name = state.names[i];
+            results[i].stats.reset();
+        }
+
+        TimingStats snapshot;
+        for (const auto &thread : state.threads)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                const slot_t *slot_ptr = thread->slots[i].load(std::memory_order_acquire);
+                if (!slot_ptr)
+                    continue;
+                const slot_t &slot = *slot_ptr;
+                uint32_t before, after;
+                do
+                {
+                    before = slot.sequence.load(std::memory_order_acquire);
+                    snapshot = slot.stats;
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    after = slot.sequence.load(std::memory_order_relaxed);
+                } while ((before & 1) || before != after);
+                results[i].stats.merge(snapshot);
+            }
+        }
+    }
+
+private:
+    struct slot_t
+    {
+        std::atomic<uint32_t> sequence{0}; // 奇数のとき書き込み中
+        TimingStats stats;
+    };
+
+    // スロットは各スレッドで初めて記録したスコープの分だけ確保される
+    struct thread_data_t
+    {
+        std::array<std::atomic<slot_t *>, MAX_SCOPES> slots;
+
+        thread_data_t()
+        {
+            for (auto &slot : slots)
+                slot.store(nullptr, std::memory_order_relaxed);
+        }
+
+        ~thread_data_t()
+        {
+            for (auto &slot : slots)
+                delete slot.load(std::memory_order_relaxed);
+        }
+    };
+
+    struct state_t
+    {
+        std::mutex mutex;
+        std::array<std::string, MAX_SCOPES> names;
+        std::atomic<size_t> scope_size{0};
+        std::vector<std::unique_ptr<thread_data_t>> threads; // スレッド終了後も結果を残すため解放しない
+    };
+
+    static state_t &getState()
+    {
+        static state_t state;
+        return state;
+    }
+
+    static inline slot_t &getSlot(int id)
+    {
+        thread_local thread_data_t *data = nullptr;
+        if (!data)
+        {
+            state_t &state = getState();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.threads.emplace_back(new thread_data_t());
+            data = state.threads.back().get();
+        }
+        slot_t *slot = data->slots[id].load(std::memory_order_relaxed);
+        if (!slot)
+        {
+            slot = new slot_t();
+            data->slots[id].store(slot, std::memory_order_release);
+        }
+        return *slot;
+    }
+};
+
+/**
+ * @brief スコープを抜けるまでの時間をProfilerに記録する
+**/
+class ProfileScope
+{
+public:
+    /**
+     * @brief コンストラクタ （計測開始）
+     * @param id: Profiler::registerScope()で取得したスコープID
+     */
+    explicit ProfileScope(int id) : _id(id), _start_time(SteadyStopwatch::clock_type::now()) {}
+
+    /**
+     * @brief デストラクタ （計測結果をProfilerに記録）
+     */
+    ~ProfileScope()
+    {
+        const auto d = SteadyStopwatch::clock_type::now() - _start_time;
+        Profiler::record(_id, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    int _id;
+    SteadyStopwatch::clock_type::time_point _start_time;
+};
+}
+
+#define NUT_ROS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define NUT_ROS_PROFILE_CONCAT(a, b) NUT_ROS_PROFILE_CONCAT_IMPL(a, b)
+
+#ifndef NUT_ROS_DISABLE_PROFILER
+/**
+ * @brief このマクロを書いたスコープの処理時間をnameとしてProfilerに記録する
+ */
+#define NUT_ROS_PROFILE_SCOPE(name)                                                                            \
+    static const int NUT_ROS_PROFILE_CONCAT(_nut_ros_profile_id_, __LINE__) = nut_ros::Profiler::registerScope(name); \
+    nut_ros::ProfileScope NUT_ROS_PROFILE_CONCAT(_nut_ros_profile_scope_, __LINE__)(NUT_ROS_PROFILE_CONCAT(_nut_ros_profile_id_, __LINE__))
+#else
+#define NUT_ROS_PROFILE_SCOPE(name)
+#endif
@@ -0,0 +1,153 @@
+/**
+ * @file profiler_reporter.h
+ * @brief Profilerの集計結果をdiagnostic_updater, OverlayTextで出力する
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./profiler.h"
+#include "./steady_stopwatch.h"
+
+#include <cstdio>
+#include <diagnostic_updater/diagnostic_updater.h>
+#include <jsk_rviz_plugins/OverlayText.h>
+
+namespace nut_ros
+{
+/**
+ * @brief Profilerの集計結果をdiagnostic_updater, OverlayTextで出力する
+ * @details update()で全スレッドの結果を合算し，前回のupdate()からの呼び出し回数で各スコープの周期[Hz]を求める
+ * @code
+ * diagnostic_updater::Updater updater;
+ * nut_ros::ProfilerReporter reporter;
+ * reporter.attach(updater);
+ * // 周期的に: updater.update(); overlay_pub.publish(reporter.toOverlayText());
+ * @endcode
+**/
+class ProfilerReporter
+{
+public:
+    /**
+     * @brief スコープ毎の表示内容
+     */
+    struct summary_t
+    {
+        std::string name; /**< スコープ名 */
+        uint64_t count;   /**< 累計の呼び出し回数 */
+        double rate;      /**< 前回のupdate()からの呼び出し周期[Hz] */
+        double mean;      /**< 平均[sec] */
+        double p50;       /**< 50パーセンタイル[sec] */
+        double p99;       /**< 99パーセンタイル[sec] */
+        double max;       /**< 最大[sec] */
+    };
+
+    /**
+     * @brief diagnostic_updaterにタスクとして登録
+     * @param updater: 登録先
+     * @param name: タスク名
+     * @attention このオブジェクトはupdaterより長く生存している必要がある
+     */
+    void attach(diagnostic_updater::Updater &updater, const std::string &name = "profiler")
+    {
+        updater.add(name, this, &ProfilerReporter::produceDiagnostics);
+    }
+
+    /**
+     * @brief Profilerの集計結果を更新
+     */
+    void update()
+    {
+        Profiler::collect(_results);
+        const double elapsed = _stopwatch.lap();
+        _summaries.resize(_results.size());
+        _prev_counts.resize(_results.size(), 0);
+        for (size_t i = 0; i < _results.size(); ++i)
+        {
+            const TimingStats &stats = _results[i].stats;
+            summary_t &summary = _summaries[i];
+            summary.name = _results[i].name;
+            summary.count = stats.getCount();
+            summary.rate = elapsed > 0 ? (double)(summary.count - _prev_counts[i]) / elapsed : 0.0;
+            summary.mean = stats.getMean();
+            summary.p50 = stats.getPercentile(50);
+            summary.p99 = stats.getPercentile(99);
+            summary.max = stats.getMax();
+            _prev_counts[i] = summary.count;
+        }
+    }
+
+    /**
+     * @brief 最新の集計結果を返す
+     * @return スコープ毎の表示内容
+     * @attention update()を呼び出さないと値は更新されない
+     */
+    const std::vector<summary_t> &getSummaries() const { return _summaries; }
+
+    /**
+     * @brief diagnostic_updaterのタスク（update()して結果を書き込む）
+     * @param stat: 出力先
+     */
+    void produceDiagnostics(diagnostic_updater::DiagnosticStatusWrapper &stat)
+    {
+        update();
+        stat.summary(diagnostic_msgs::DiagnosticStatus::OK, "profiling");
+        for (const auto &summary : _summaries)
+        {
+            stat.addf(summary.name, "%.1f[Hz] mean: %.1f p50: %.1f p99: %.1f max: %.1f [usec]",
+                      summary.rate, summary.mean * 1e6, summary.p50 * 1e6, summary.p99 * 1e6, summary.max * 1e6);
+        }
+    }
+
+    /**
+     * @brief 最新の集計結果を表形式の文字列で返す
+     * @return 1スコープ1行の文字列
+     * @attention update()を呼び出さないと値は更新されない
+     */
+    std::string getText() const
+    {
+        std::string text;
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-24s %9s %9s %9s %9s %9s\n", "scope", "Hz", "mean[us]", "p50[us]", "p99[us]", "max[us]");
+        text += line;
+        for (const auto &summary : _summaries)
+        {
+            std::snprintf(line, sizeof(line), "%-24.24s %9.1f %9.1f %9.1f %9.1f %9.1f\n", summary.name.c_str(),
+                          summary.rate, summary.mean * 1e6, summary.p50 * 1e6, summary.p99 * 1e6, summary.max * 1e6);
+            text += line;
+        }
+        return text;
+    }
+
+    /**
+     * @brief 最新の集計結果をjsk_rviz_plugins::OverlayTextで返す
+     * @param width: 表示幅[px]
+     * @param text_size: 文字の大きさ
+     * @return OverlayText
+     * @attention update()を呼び出さないと値は更新されない
+     */
+    jsk_rviz_plugins::OverlayText toOverlayText(int width = 600, float text_size = 10) const
+    {
+        jsk_rviz_plugins::OverlayText msg;
+        msg.action = jsk_rviz_plugins::OverlayText::ADD;
+        msg.width = width;
+        msg.height = (int)((_summaries.size() + 1) * text_size * 2);
+        msg.left = 0;
+        msg.top = 0;
+        msg.text_size = text_size;
+        msg.line_width = 1;
+        msg.font = "DejaVu Sans Mono";
+        msg.bg_color.r = msg.bg_color.g = msg.bg_color.b = 0.0;
+        msg.bg_color.a = 0.5;
+        msg.fg_color.r = msg.fg_color.g = msg.fg_color.b = 1.0;
+        msg.fg_color.a = 1.0;
+        msg.text = getText();
+        return msg;
+    }
+
+private:
+    std::vector<Profiler::result_t> _results;
+    std::vector<summary_t> _summaries;
+    std::vector<uint64_t> _prev_counts;
+    SteadyStopwatch _stopwatch;
+};
+}
@@ -0,0 +1,146 @@
+/**
+ * @file steady_stopwatch.h
+ * @brief ROSの時刻に依存しない高分解能の時間計測を行う
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./timing_stats.h"
+
+#include <chrono>
+
+namespace nut_ros
+{
+/**
+ * @brief ROSの時刻に依存しない高分解能の時間計測を行う
+ * @details std::chrono::steady_clockを使用するため，シミュレーション時間の影響を受けず単調増加する
+ *          シミュレーション時間に合わせて計測したい場合はStopwatchを使用する
+**/
+class SteadyStopwatch
+{
+public:
+    using clock_type = std::chrono::steady_clock; /**< 使用する時計 */
+
+    /**
+     * @brief コンストラクタ （計測開始）
+     */
+    SteadyStopwatch()
+    {
+        start();
+    }
+
+    /**
+     * @brief 計測開始（ラップの基準もリセットされる）
+     */
+    void start()
+    {
+        _start_time = _lap_time = clock_type::now();
+    }
+
+    /**
+     * @brief start()を呼び出してからの経過時間[nsec]を返す
+     * @return start()を呼び出してからの経過時間[nsec]
+     */
+    uint64_t getDurationNs() const
+    {
+        return toNs(clock_type::now() - _start_time);
+    }
+
+    /**
+     * @brief start()を呼び出してからの経過時間[sec]を返す
+     * @return start()を呼び出してからの経過時間[sec]
+     */
+    double getDuration() const
+    {
+        return (double)getDurationNs() * 1e-9;
+    }
+
+    /**
+     * @brief ラップタイム[nsec]を返し，次のラップを開始する
+     * @return start()または前回のlap()からの経過時間[nsec]
+     */
+    uint64_t lapNs()
+    {
+        const clock_type::time_point now = clock_type::now();
+        const uint64_t lap = toNs(now - _lap_time);
+        _lap_time = now;
+        return lap;
+    }
+
+    /**
+     * @brief ラップタイム[sec]を返し，次のラップを開始する
+     * @return start()または前回のlap()からの経過時間[sec]
+     */
+    double lap()
+    {
+        return (double)lapNs() * 1e-9;
+    }
+
+    /**
+     * @brief ラップタイムを統計に追加し，次のラップを開始する
+     * @param stats: 追加先の統計
+     * @return start()または前回のlap()からの経過時間[sec]
+     */
+    double lap(TimingStats &stats)
+    {
+        const uint64_t lap = lapNs();
+        stats.add(lap);
+        return (double)lap * 1e-9;
+    }
+
+    /**
+     * @brief スプリットタイム[sec]を返す（ラップは更新しない）
+     * @return start()を呼び出してからの経過時間[sec]
+     */
+    double split() const
+    {
+        return getDuration();
+    }
+
+private:
+    clock_type::time_point _start_time;
+    clock_type::time_point _lap_time;
+
+    static inline uint64_t toNs(clock_type::duration d)
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    }
+};
+
+/**
+ * @brief スコープを抜けるまでの時間を計測して統計に追加する
+ * @details 使用例
+ * @code
+ * static nut_ros::TimingStats stats;
+ * {
+ *     nut_ros::ScopedTimer timer(stats);
+ *     // 計測したい処理
+ * }
+ * @endcode
+**/
+class ScopedTimer
+{
+public:
+    /**
+     * @brief コンストラクタ （計測開始）
+     * @param stats: 計測結果の追加先
+     */
+    explicit ScopedTimer(TimingStats &stats) : _stats(stats), _start_time(SteadyStopwatch::clock_type::now()) {}
+
+    /**
+     * @brief デストラクタ （計測結果を統計に追加）
+     */
+    ~ScopedTimer()
+    {
+        const auto d = SteadyStopwatch::clock_type::now() - _start_time;
+        _stats.add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+    TimingStats &_stats;
+    SteadyStopwatch::clock_type::time_point _start_time;
+};
+}
@@ -1,18 +1,22 @@
 /**
- * @file pose_2D.h
+ * @file stopwatch.h
  * @brief 時間計測を行う
  * @author Ryoga Sato
  * @date 2020/11/27
 **/
 #pragma once
 
-#include "./../nut_generic.h"
+#include "./../nut_generic_core.h"
+
+#include <ros/console.h>
+#include <ros/time.h>
 
 namespace nut_ros
 {
 /**
  * @brief 時間計測を行う
  * @details start()を実行したタイミングからの経過秒をgetDuration()で取得できる
+ *          ROSの時刻（シミュレーション時間を含む）を使用する．高分解能な計測にはSteadyStopwatchを使用する
 **/
 class Stopwatch
 {
@@ -43,7 +47,7 @@ public:
     double getDuration()
     {
         ros::Duration ros_duration = ros::Time::now() - start_time;
-        return (double)ros_duration.sec + (double)ros_duration.nsec * std::pow(10, -9);
+        return (double)ros_duration.sec + (double)ros_duration.nsec * 1e-9;
     }
 
     /**
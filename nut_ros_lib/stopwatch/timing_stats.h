@@ -0,0 +1,168 @@
+/**
+ * @file timing_stats.h
+ * @brief 計測時間の統計（最小，最大，平均，パーセンタイル）
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+
+namespace nut_ros
+{
+/**
+ * @brief 計測時間の統計（最小，最大，平均，パーセンタイル）
+ * @details サンプル毎にログ出力や動的確保を行わず，固定長の対数ヒストグラムに積算する
+ *          パーセンタイルはヒストグラムのビン幅（相対誤差およそ12.5%以内）の精度で求まる
+**/
+class TimingStats
+{
+public:
+    static constexpr size_t SUB_BUCKET_BITS = 3;                            /**< 2のべき乗区間毎の分割数のbit数 */
+    static constexpr size_t SUB_BUCKETS = (size_t)1 << SUB_BUCKET_BITS;     /**< 2のべき乗区間毎の分割数 */
+    static constexpr size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS; /**< ビン数 */
+
+    /**
+     * @brief コンストラクタ
+     */
+    TimingStats()
+    {
+        reset();
+    }
+
+    /**
+     * @brief リセット
+     */
+    void reset()
+    {
+        _count = 0;
+        _sum_ns = 0;
+        _min_ns = UINT64_MAX;
+        _max_ns = 0;
+        _buckets.fill(0);
+    }
+
+    /**
+     * @brief サンプルの追加
+     * @param ns: 計測時間[nsec]
+     */
+    void add(uint64_t ns)
+    {
+        ++_count;
+        _sum_ns += ns;
+        _min_ns = ns < _min_ns ? ns : _min_ns;
+        _max_ns = ns > _max_ns ? ns : _max_ns;
+        ++_buckets[getBucketIndex(ns)];
+    }
+
+    /**
+     * @brief 他の統計を合算
+     * @param other: 合算する統計
+     */
+    void merge(const TimingStats &other)
+    {
+        _count += other._count;
+        _sum_ns += other._sum_ns;
+        _min_ns = other._min_ns < _min_ns ? other._min_ns : _min_ns;
+        _max_ns = other._max_ns > _max_ns ? other._max_ns : _max_ns;
+        for (size_t i = 0; i < BUCKETS; ++i)
+            _buckets[i] += other._buckets[i];
+    }
+
+    /**
+     * @brief サンプル数を返す
+     * @return サンプル数
+     */
+    uint64_t getCount() const { return _count; }
+
+    /**
+     * @brief 最小値[sec]を返す
+     * @return 最小値[sec]（サンプルがない場合は0）
+     */
+    double getMin() const { return _count ? (double)_min_ns * 1e-9 : 0.0; }
+
+    /**
+     * @brief 最大値[sec]を返す
+     * @return 最大値[sec]
+     */
+    double getMax() const { return (double)_max_ns * 1e-9; }
+
+    /**
+     * @brief 平均値[sec]を返す
+     * @return 平均値[sec]（サンプルがない場合は0）
+     */
+    double getMean() const { return _count ? (double)_sum_ns / (double)_count * 1e-9 : 0.0; }
+
+    /**
+     * @brief 合計値[sec]を返す
+     * @return 合計値[sec]
+     */
+    double getTotal() const { return (double)_sum_ns * 1e-9; }
+
+    /**
+     * @brief パーセンタイル値[sec]を返す
+     * @param percent: パーセント（0~100，例: 99で99パーセンタイル）
+     * @return パーセンタイル値[sec]（該当ビンの上限値を最大値で制限したもの，サンプルがない場合は0）
+     */
+    double getPercentile(double percent) const
+    {
+        if (_count == 0)
+            return 0.0;
+        // 順位（1始まり）
+        double rank_f = std::ceil(percent / 100.0 * (double)_count);
+        uint64_t rank = rank_f < 1.0 ? 1 : (uint64_t)rank_f;
+        rank = rank > _count ? _count : rank;
+
+        uint64_t accumulated = 0;
+        for (size_t i = 0; i < BUCKETS; ++i)
+        {
+            accumulated += _buckets[i];
+            if (accumulated >= rank)
+            {
+                uint64_t upper = getBucketUpperBound(i);
+                upper = upper > _max_ns ? _max_ns : upper;
+                upper = upper < _min_ns ? _min_ns : upper;
+                return (double)upper * 1e-9;
+            }
+        }
+        return getMax();
+    }
+
+private:
+    uint64_t _count;
+    uint64_t _sum_ns;
+    uint64_t _min_ns, _max_ns;
+    std::array<uint64_t, BUCKETS> _buckets;
+
+    // 2^SUB_BUCKET_BITS未満はそのまま，それ以上は最上位bitの位置と続くSUB_BUCKET_BITS bitでビンを決める
+    static inline size_t getBucketIndex(uint64_t ns)
+    {
+        if (ns < SUB_BUCKETS)
+            return (size_t)ns;
+        const size_t msb = 63 - countLeadingZeros(ns);
+        const size_t sub = (size_t)(ns >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+        return (msb - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+    }
+
+    static inline uint64_t getBucketUpperBound(size_t index)
+    {
+        if (index < SUB_BUCKETS)
+            return (uint64_t)index;
+        const size_t msb = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+        const uint64_t sub = (uint64_t)(index % SUB_BUCKETS);
+        const size_t shift = msb - SUB_BUCKET_BITS;
+        const uint64_t lower = (((uint64_t)SUB_BUCKETS | sub) << shift);
+        return lower + (((uint64_t)1 << shift) - 1);
+    }
+
+    static inline size_t countLeadingZeros(uint64_t v)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return (size_t)__builtin_clzll(v);
+#else
+        size_t n = 0;
+        for (uint64_t bit = (uint64_t)1 << 63; bit && !(v & bit); bit >>= 1)
+            ++n;
+        return n;
+#endif
+    }
+};
+}
@@ -0,0 +1,76 @@
+/**
+ * @file test_distance_transform.cpp
+ * @brief DistanceTransformの単体テスト
+**/
+#include "nut_ros_lib_core.h"
+
+#include <gtest/gtest.h>
+
+using nut_ros::DistanceTransform;
+using nut_ros::OccupancyGridView;
+using nut_ros::Pose2D;
+
+namespace {
+// 障害物の格子を全て調べて求めた距離[cell]と一致することを確認する
+void expectBruteForce(const DistanceTransform<double> &edt, const std::vector<int8_t> &data, uint32_t width, uint32_t height)
+{
+    std::vector<std::pair<long long, long long>> obstacles;
+    for (uint32_t iy = 0; iy < height; ++iy)
+        for (uint32_t ix = 0; ix < width; ++ix)
+            if (data[(size_t)iy * width + ix] >= 50)
+                obstacles.emplace_back(ix, iy);
+
+    for (uint32_t iy = 0; iy < height; ++iy)
+    {
+        for (uint32_t ix = 0; ix < width; ++ix)
+        {
+            double best = edt.getMaxDistance();
+            for (const auto &o : obstacles)
+                best = std::min(best, std::hypot((double)(o.first - ix), (double)(o.second - iy)));
+            ASSERT_NEAR(edt.getDistance((long long)ix, (long long)iy), best, 1e-3) << "ix=" << ix << " iy=" << iy;
+        }
+    }
+}
+}
+
+// 幅の広い地図でも放物線の交点が丸められず，全格子で厳密な距離になる
+TEST(DistanceTransformTest, WideMapMatchesBruteForce)
+{
+    const uint32_t width = 20000, height = 3;
+    std::vector<int8_t> data((size_t)width * height, 0);
+    // 隣接する放物線の交点を地図の端まで求めさせるため，障害物を疎らに全体へ置く
+    for (uint32_t ix = 3; ix < width; ix += 37)
+        data[(size_t)((ix / 37) % height) * width + ix] = 100;
+    const OccupancyGridView<double> view(data.data(), width, height, 1.0, Pose2D<double>(0, 0, 0));
+
+    DistanceTransform<double> edt(1e5);
+    edt.compute(view);
+    expectBruteForce(edt, data, width, height);
+
+    // 障害物を移動して差分更新した結果も一致する
+    data[(size_t)((7995 / 37) % height) * width + 7995] = 0;
+    data[(size_t)1 * width + 15000] = 100;
+    EXPECT_EQ(edt.update(view), 2u);
+    expectBruteForce(edt, data, width, height);
+}
+
+// 打ち切り距離がある場合の差分更新は全体の再計算と一致する
+TEST(DistanceTransformTest, IncrementalUpdateMatchesCompute)
+{
+    const uint32_t width = 8000, height = 4;
+    std::vector<int8_t> data((size_t)width * height, 0);
+    for (uint32_t ix = 100; ix < width; ix += 997)
+        data[(size_t)(ix % height) * width + ix] = 100;
+    const OccupancyGridView<double> view(data.data(), width, height, 0.05, Pose2D<double>(0, 0, 0));
+
+    DistanceTransform<double> edt(2.0);
+    edt.compute(view);
+    data[(size_t)1 * width + 5000] = 100;
+    data[(size_t)(3091 % height) * width + 3091] = 0;
+    EXPECT_EQ(edt.update(view), 2u);
+
+    DistanceTransform<double> expected(2.0);
+    expected.compute(view);
+    for (size_t i = 0; i < data.size(); ++i)
+        ASSERT_FLOAT_EQ(edt.getData()[i], expected.getData()[i]) << "i=" << i;
+}
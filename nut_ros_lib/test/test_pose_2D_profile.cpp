@@ -0,0 +1,83 @@
+/**
+ * @file test_pose_2D_profile.cpp
+ * @brief Pose2DProfileの単体テスト
+**/
+#include "nut_ros_lib_core.h"
+
+#include <gtest/gtest.h>
+
+using nut_ros::MotionProfileType;
+using nut_ros::Pose2D;
+using nut_ros::Pose2DProfile;
+
+namespace {
+const double MAX_V = 0.5;
+const double MAX_A = 1.0;
+const double MAX_J = 4.0;
+
+// 全時刻で並進の速度，加速度が上限値以下で，開始位置と目標位置を結ぶ直線上にあることを確認する
+void expectStraightAndLimited(const Pose2DProfile<double> &profile, const Pose2D<double> &start, const Pose2D<double> &goal)
+{
+    const double dx = goal.x - start.x, dy = goal.y - start.y;
+    const double length = std::hypot(dx, dy);
+    for (double t = 0; t <= profile.getDuration() + 0.1; t += 0.001)
+    {
+        const Pose2D<double> p = profile.getPose(t);
+        const Pose2D<double> v = profile.getVelocity(t);
+        const Pose2D<double> a = profile.getAcceleration(t);
+        EXPECT_LE(std::hypot(v.x, v.y), MAX_V + 1e-9) << "t=" << t;
+        EXPECT_LE(std::hypot(a.x, a.y), MAX_A + 1e-9) << "t=" << t;
+        EXPECT_NEAR(((p.x - start.x) * dy - (p.y - start.y) * dx) / length, 0, 1e-9) << "t=" << t;
+    }
+    const Pose2D<double> end = profile.getPose(profile.getDuration());
+    EXPECT_NEAR(end.x, goal.x, 1e-9);
+    EXPECT_NEAR(end.y, goal.y, 1e-9);
+}
+}
+
+// 斜め方向でも並進の上限値を超えず，x, yが同時に終了する
+TEST(Pose2DProfileTest, DiagonalMoveIsStraightAndLimited)
+{
+    for (MotionProfileType type : {MotionProfileType::Trapezoidal, MotionProfileType::SCurve})
+    {
+        Pose2DProfile<double> profile(type, MAX_V, MAX_A, MAX_J, 1.0, 2.0, 8.0);
+        const Pose2D<double> start(0, 0, 0), goal(2, 2, M_PI / 2);
+        profile.plan(start, goal);
+        expectStraightAndLimited(profile, start, goal);
+        // 巡航速度は並進の上限値（軸ごとに計画した場合は√2倍になる）
+        EXPECT_NEAR(std::hypot(profile.getVelocity(profile.getDuration() / 2).x, profile.getVelocity(profile.getDuration() / 2).y), MAX_V, 1e-9);
+        EXPECT_NEAR(profile.getPose(profile.getDuration()).theta, M_PI / 2, 1e-9);
+    }
+}
+
+// 再計画後も速度が連続し，新しい目標位置への直線上を移動する
+TEST(Pose2DProfileTest, ReplanKeepsVelocityAlongDirection)
+{
+    Pose2DProfile<double> profile(MotionProfileType::Trapezoidal, MAX_V, MAX_A, 0.0, 1.0, 2.0, 0.0);
+    profile.plan(Pose2D<double>(0, 0, 0), Pose2D<double>(3, 0, 0));
+    const double t = 1.5;
+    const Pose2D<double> p = profile.getPose(t);
+    const Pose2D<double> v = profile.getVelocity(t);
+
+    const Pose2D<double> goal(5, 0, 0);
+    profile.replan(t, goal);
+    EXPECT_NEAR(profile.getPose(0).x, p.x, 1e-9);
+    EXPECT_NEAR(profile.getVelocity(0).x, v.x, 1e-9);
+    expectStraightAndLimited(profile, p, goal);
+}
+
+// 目標位置が開始位置と同じ場合は回転のみ行う
+TEST(Pose2DProfileTest, RotationOnly)
+{
+    Pose2DProfile<double> profile(MotionProfileType::Trapezoidal, MAX_V, MAX_A, 0.0, 1.0, 2.0, 0.0);
+    profile.plan(Pose2D<double>(1, 1, 3.0), Pose2D<double>(1, 1, -3.0));
+    EXPECT_GT(profile.getDuration(), 0);
+    for (double t = 0; t <= profile.getDuration(); t += 0.01)
+    {
+        EXPECT_EQ(profile.getPose(t).x, 1);
+        EXPECT_EQ(profile.getPose(t).y, 1);
+    }
+    // 最短方向（+pi側を越える向き）に回転する
+    EXPECT_GT(profile.getVelocity(profile.getDuration() / 2).theta, 0);
+    EXPECT_NEAR(profile.getPose(profile.getDuration()).theta, -3.0, 1e-9);
+}
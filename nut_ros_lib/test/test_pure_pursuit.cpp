@@ -0,0 +1,99 @@
+/**
+ * @file test_pure_pursuit.cpp
+ * @brief PurePursuitの単体テスト
+**/
+#include "nut_ros_lib_core.h"
+
+#include <gtest/gtest.h>
+
+using nut_ros::Pose2D;
+using nut_ros::PurePursuit;
+
+namespace {
+// 始点と終点が一致する円の経路
+std::vector<Pose2D<double>> makeLoop(double radius, size_t n)
+{
+    std::vector<Pose2D<double>> poses;
+    for (size_t i = 0; i <= n; ++i)
+    {
+        const double a = 2 * M_PI * (double)i / (double)n;
+        poses.emplace_back(radius * std::cos(a), radius * std::sin(a), a + M_PI / 2);
+    }
+    return poses;
+}
+
+// 速度指令で姿勢を進める
+Pose2D<double> step(const Pose2D<double> &pose, const Pose2D<double> &velocity, double dt)
+{
+    const double theta = pose.theta + velocity.theta * dt / 2;
+    return Pose2D<double>(pose.x + velocity.x * std::cos(theta) * dt, pose.y + velocity.x * std::sin(theta) * dt, pose.theta + velocity.theta * dt);
+}
+
+PurePursuit<double>::param_t makeParam()
+{
+    PurePursuit<double>::param_t param;
+    param.lookahead_distance = 0.3;
+    param.max_linear_speed = 0.5;
+    param.max_angular_speed = 2.0;
+    param.max_deceleration = 0.5;
+    param.goal_tolerance = 0.05;
+    return param;
+}
+}
+
+// 周回経路の始点ではゴールまでの直線距離がゼロでも減速しない
+TEST(PurePursuitTest, LoopPathDoesNotThrottleAtStart)
+{
+    PurePursuit<double> follower(makeParam());
+    follower.setPath(makeLoop(1.0, 100));
+
+    const Pose2D<double> start(1.0, 0.0, M_PI / 2);
+    const Pose2D<double> velocity = follower.update(start);
+    EXPECT_FALSE(follower.isGoalReached());
+    EXPECT_NEAR(velocity.x, 0.5, 1e-9);
+}
+
+// 周回経路を一周してゴールに到達し，ゴール手前では残りの弧長に応じて減速する
+TEST(PurePursuitTest, LoopPathReachesGoal)
+{
+    const PurePursuit<double>::param_t param = makeParam();
+    PurePursuit<double> follower(param);
+    follower.setPath(makeLoop(1.0, 100));
+
+    Pose2D<double> pose(1.0, 0.0, M_PI / 2);
+    const double dt = 0.01;
+    int steps = 0;
+    for (; steps < 10000 && !follower.isGoalReached(); ++steps)
+    {
+        const Pose2D<double> velocity = follower.update(pose);
+        EXPECT_LE(velocity.x, std::sqrt(2 * param.max_deceleration * follower.getRemainingDistance()) + 1e-9);
+        pose = step(pose, velocity, dt);
+    }
+    ASSERT_TRUE(follower.isGoalReached());
+    // 途中で止まらずに一周している（2πr / 最大速度 ≒ 12.6秒より長く，減速を含めても大幅には遅れない）
+    EXPECT_GT(steps * dt, 2 * M_PI / param.max_linear_speed);
+    EXPECT_LT(steps * dt, 2 * (2 * M_PI / param.max_linear_speed));
+    EXPECT_LT(std::hypot(pose.x - 1.0, pose.y), 0.1);
+}
+
+// 直線経路ではゴールに向かって減速して停止する
+TEST(PurePursuitTest, StraightPathDeceleratesToGoal)
+{
+    PurePursuit<double> follower(makeParam());
+    follower.setPath(std::vector<Pose2D<double>>{Pose2D<double>(0, 0, 0), Pose2D<double>(2, 0, 0)});
+
+    Pose2D<double> pose(0, 0.1, 0);
+    double previous_speed = 0;
+    bool decelerated = false;
+    for (int i = 0; i < 10000 && !follower.isGoalReached(); ++i)
+    {
+        const Pose2D<double> velocity = follower.update(pose);
+        decelerated |= velocity.x < previous_speed - 1e-6;
+        previous_speed = velocity.x;
+        pose = step(pose, velocity, 0.01);
+    }
+    ASSERT_TRUE(follower.isGoalReached());
+    EXPECT_TRUE(decelerated);
+    EXPECT_LT(std::hypot(pose.x - 2.0, pose.y), 0.05 + 1e-9);
+    EXPECT_EQ(follower.update(pose).x, 0);
+}
@@ -0,0 +1,411 @@
+/**
+ * @file marker_array_builder.h
+ * @brief 多数の図形を少数のマーカーにまとめたvisualization_msgs::MarkerArrayを生成する
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./../vector/vector2.h"
+#include "./../vector/pose_2D.h"
+#include "./../vector/line_2D.h"
+#include "./../vector/vector2_array.h"
+#include "./../vector/pose_2D_array.h"
+#include "./msg_generator.h"
+
+#include <std_msgs/ColorRGBA.h>
+#include <std_msgs/Header.h>
+
+#include <geometry_msgs/Point.h>
+#include <geometry_msgs/Polygon.h>
+
+#include <visualization_msgs/Marker.h>
+#include <visualization_msgs/MarkerArray.h>
+
+namespace nut_ros {
+
+/**
+ * @brief 多数の図形を少数のマーカーにまとめたvisualization_msgs::MarkerArrayを生成する
+ * @details 追加した点・姿勢・線分・ポリゴンは種類（POINTS, LINE_LIST, TRIANGLE_LIST）と太さが同じものごとに1つのマーカーにまとめられ，
+ *          色は頂点ごとの色（colors）で表現する（全頂点が同じ色の場合はcolorのみを使用する）
+ *          build()では前回のbuild()から内容が変化したマーカーのみを出力し，空になったマーカーは削除（DELETE）として出力する
+ *          （lifetimeはゼロなので，変化していないマーカーはrviz上にそのまま残る）
+ *          内部の配列は使い回すため，定常状態ではメモリの確保が発生しない
+ * @code
+ * nut_ros::MarkerArrayBuilder builder("map_lines");
+ * builder.addLines(lines, MsgGenerator::toColorRGBA(1, 0, 0, 1));
+ * builder.addPoses(particles, MsgGenerator::toColorRGBA(0, 0, 1, 1));
+ * if (builder.build(MsgGenerator::toHeader("map"), marker_array) > 0)
+ *     publisher.publish(marker_array);
+ * @endcode
+**/
+class MarkerArrayBuilder
+{
+public:
+    /**
+     * @brief コンストラクタ
+     * @param ns: マーカーの名前空間
+     */
+    explicit MarkerArrayBuilder(const std::string &ns = "nut_ros") : _ns(ns) {}
+
+    /**
+     * @brief 点を追加する（POINTS）
+     * @param point: 点
+     * @param color: 色
+     * @param size: 点の大きさ[m]
+     */
+    template <typename T>
+    void addPoint(const Vector2<T> &point, const std_msgs::ColorRGBA &color, double size = 0.05)
+    {
+        batch_t &batch = getBatch(visualization_msgs::Marker::POINTS, size);
+        pushVertex(batch, (double)point.x, (double)point.y, color);
+    }
+
+    /**
+     * @brief 点群を追加する（POINTS）
+     * @param points: 点群
+     * @param color: 色
+     * @param size: 点の大きさ[m]
+     */
+    template <typename T>
+    void addPoints(const Vector2Array<T> &points, const std_msgs::ColorRGBA &color, double size = 0.05)
+    {
+        batch_t &batch = getBatch(visualization_msgs::Marker::POINTS, size);
+        reserve(batch, points.size());
+        for (size_t i = 0; i < points.size(); ++i)
+            pushVertex(batch, (double)points.x[i], (double)points.y[i], color);
+    }
+
+    /**
+     * @brief 姿勢を矢印として追加する（LINE_LIST）
+     * @param pose: 姿勢
+     * @param color: 色
+     * @param length: 矢印の長さ[m]
+     * @param width: 線の太さ[m]
+     */
+    template <typename T>
+    void addPose(const Pose2D<T> &pose, const std_msgs::ColorRGBA &color, double length = 0.3, double width = 0.02)
+    {
+        batch_t &batch = getBatch(visualization_msgs::Marker::LINE_LIST, width);
+        pushArrow(batch, (double)pose.x, (double)pose.y, (double)pose.theta, length, color);
+    }
+
+    /**
+     * @brief 姿勢群を矢印として追加する（LINE_LIST）
+     * @param poses: 姿勢群
+     * @param color: 色
+     * @param length: 矢印の長さ[m]
+     * @param width: 線の太さ[m]
+     */
+    template <typename T>
+    void addPoses(const Pose2DArray<T> &poses, const std_msgs::ColorRGBA &color, double length = 0.3, double width = 0.02)
+    {
+        batch_t &batch = getBatch(visualization_msgs::Marker::LINE_LIST, width);
+        reserve(batch, poses.size() * 6);
+        for (size_t i = 0; i < poses.size(); ++i)
+            pushArrow(batch, (double)poses.x[i], (double)poses.y[i], (double)poses.theta[i], length, color);
+    }
+
+    /**
+     * @brief 線分を追加する（LINE_LIST）
+     * @param line: 線分
+     * @param color: 色
+     * @param width: 線の太さ[m]
+     */
+    template <typename T>
+    void addLine(const Line2D<T> &line, const std_msgs::ColorRGBA &color, double width = 0.02)
+    {
+        batch_t &batch = getBatch(visualization_msgs::Marker::LINE_LIST, width);
+        pushVertex(batch, (double)line.getStart().x, (double)line.getStart().y, color);
+        pushVertex(batch, (double)line.getEnd().x, (double)line.getEnd().y, color);
+    }
+
+    /**
+     * @brief 線分群を追加する（LINE_LIST）
+     * @param lines: 線分群
+     * @param color: 色
+     * @param width: 線の太さ[m]
+     */
+    template <typename T>
+    void addLines(const std::vector<Line2D<T>> &lines, const std_msgs::ColorRGBA &color, double width = 0.02)
+    {
+        batch_t &batch = getBatch(visualization_msgs::Marker::LINE_LIST, width);
+        reserve(batch, lines.size() * 2);
+        for (const Line2D<T> &line : lines)
+        {
+            pushVertex(batch, (double)line.getStart().x, (double)line.getStart().y, color);
+            pushVertex(batch, (double)line.getEnd().x, (double)line.getEnd().y, color);
+        }
+    }
+
+    /**
+     * @brief ポリゴンの輪郭を追加する（LINE_LIST）
+     * @param points: 頂点（geometry_msgs::Point32, geometry_msgs::Point, nut_ros::Vector2などの配列）
+     * @param color: 色
+     * @param width: 線の太さ[m]
+     */
+    template <typename Points>
+    void addPolygon(const Points &points, const std_msgs::ColorRGBA &color, double width = 0.02)
+    {
+        const size_t n = points.size();
+        if (n < 2)
+            return;
+        batch_t &batch = getBatch(visualization_msgs::Marker::LINE_LIST, width);
+        reserve(batch, n * 2);
+        for (size_t i = 0, j = n - 1; i < n; j = i++)
+        {
+            pushVertex(batch, (double)points[j].x, (double)points[j].y, color);
+            pushVertex(batch, (double)points[i].x, (double)points[i].y, color);
+        }
+    }
+
+    /**
+     * @brief ポリゴンの輪郭を追加する（LINE_LIST）
+     * @param polygon: geometry_msgs::Polygon型
+     * @param color: 色
+     * @param width: 線の太さ[m]
+     */
+    void addPolygon(const geometry_msgs::Polygon &polygon, const std_msgs::ColorRGBA &color, double width = 0.02)
+    {
+        addPolygon(polygon.points, color, width);
+    }
+
+    /**
+     * @brief 塗りつぶしたポリゴンを追加する（TRIANGLE_LIST）
+     * @details 最初の頂点を中心とした扇形に三角形分割するため，凸ポリゴン（または最初の頂点から全体が見えるもの）のみに対応する
+     * @param points: 頂点（geometry_msgs::Point32, geometry_msgs::Point, nut_ros::Vector2などの配列）
+     * @param color: 色
+     */
+    template <typename Points>
+    void addFilledPolygon(const Points &points, const std_msgs::ColorRGBA &color)
+    {
+        const size_t n = points.size();
+        if (n < 3)
+            return;
+        batch_t &batch = getBatch(visualization_msgs::Marker::TRIANGLE_LIST, 1.0);
+        reserve(batch, (n - 2) * 3);
+        for (size_t i = 1; i + 1 < n; ++i)
+        {
+            pushVertex(batch, (double)points[0].x, (double)points[0].y, color);
+            pushVertex(batch, (double)points[i].x, (double)points[i].y, color);
+            pushVertex(batch, (double)points[i + 1].x, (double)points[i + 1].y, color);
+        }
+    }
+
+    /**
+     * @brief 塗りつぶしたポリゴンを追加する（TRIANGLE_LIST）
+     * @param polygon: geometry_msgs::Polygon型（凸）
+     * @param color: 色
+     */
+    void addFilledPolygon(const geometry_msgs::Polygon &polygon, const std_msgs::ColorRGBA &color)
+    {
+        addFilledPolygon(polygon.points, color);
+    }
+
+    /**
+     * @brief 追加した図形からvisualization_msgs::MarkerArrayを生成する
+     * @details 前回のbuild()から変化したマーカーと，空になって削除するマーカーのみを出力する
+     *          build()の後は追加した図形は空になり，次のフレームの追加を受け付ける
+     * @param header: ヘッダー（frame_idが前回と異なる場合は全てのマーカーを出力する）
+     * @param marker_array: 出力先（markersの確保済み領域は再利用される）
+     * @param only_changed: 変化したマーカーのみを出力するかどうか（falseの場合は空でない全てのマーカーを出力する）
+     * @return 出力したマーカーの数（ゼロの場合はpublishする必要がない）
+     */
+    size_t build(const std_msgs::Header &header, visualization_msgs::MarkerArray &marker_array, bool only_changed = true)
+    {
+        const bool frame_changed = header.frame_id != _last_frame_id;
+        if (frame_changed)
+            _last_frame_id = header.frame_id;
+
+        size_t count = 0;
+        for (size_t i = 0; i < _batches.size(); ++i)
+        {
+            batch_t &batch = _batches[i];
+            const bool empty = batch.points.empty();
+            const bool changed = !only_changed || frame_changed || !isEqual(batch.points, batch.last_points) || !isEqual(batch.colors, batch.last_colors);
+
+            if (empty && batch.published)
+            {
+                visualization_msgs::Marker &marker = getMarker(marker_array, count++);
+                setMarkerHeader(marker, header, (int)i, batch.type);
+                marker.action = visualization_msgs::Marker::DELETE;
+                marker.points.clear();
+                marker.colors.clear();
+                batch.published = false;
+            }
+            else if (!empty && changed)
+            {
+                visualization_msgs::Marker &marker = getMarker(marker_array, count++);
+                setMarkerHeader(marker, header, (int)i, batch.type);
+                marker.action = visualization_msgs::Marker::ADD;
+                MsgGenerator::fill(marker.pose, 0.0, 0.0, 0.0);
+                marker.scale.x = batch.scale;
+                marker.scale.y = batch.type == visualization_msgs::Marker::LINE_LIST ? 0.0 : batch.scale;
+                marker.scale.z = batch.type == visualization_msgs::Marker::TRIANGLE_LIST ? 1.0 : 0.0;
+                marker.lifetime = ros::Duration();
+                marker.points.assign(batch.points.begin(), batch.points.end());
+                marker.color = batch.colors.front();
+                if (isUniform(batch.colors))
+                    marker.colors.clear();
+                else
+                    marker.colors.assign(batch.colors.begin(), batch.colors.end());
+                batch.published = true;
+            }
+
+            // 今回の内容を次回の比較用に残し，確保済み領域を使い回して次のフレームを始める
+            batch.points.swap(batch.last_points);
+            batch.colors.swap(batch.last_colors);
+            batch.points.clear();
+            batch.colors.clear();
+        }
+        marker_array.markers.resize(count);
+        return count;
+    }
+
+    /**
+     * @brief 追加した図形を破棄する
+     * @details 前回のbuild()の内容は保持されるため，次のbuild()では全てのマーカーが削除として出力される
+     */
+    void clear()
+    {
+        for (batch_t &batch : _batches)
+        {
+            batch.points.clear();
+            batch.colors.clear();
+        }
+    }
+
+    /**
+     * @brief 現在までに使用したマーカー（種類と太さの組）の数を返す
+     * @return マーカーの数
+     */
+    size_t getMarkerCount() const
+    {
+        return _batches.size();
+    }
+
+private:
+    // 種類と太さが同じ図形をまとめる1つのマーカー（idは_batchesの添字で，フレーム間で不変）
+    struct batch_t
+    {
+        int type;
+        double scale;
+        std::vector<geometry_msgs::Point> points, last_points;
+        std::vector<std_msgs::ColorRGBA> colors, last_colors;
+        bool published = false;
+    };
+
+    std::string _ns;
+    std::string _last_frame_id;
+    std::vector<batch_t> _batches;
+    size_t _last_batch = 0;
+
+    batch_t &getBatch(const int type, const double scale)
+    {
+        // 同じ種類の図形を続けて追加することが多いので，直前のものから確認する
+        if (_last_batch < _batches.size() && _batches[_last_batch].type == type && _batches[_last_batch].scale == scale)
+            return _batches[_last_batch];
+        for (size_t i = 0; i < _batches.size(); ++i)
+        {
+            if (_batches[i].type == type && _batches[i].scale == scale)
+            {
+                _last_batch = i;
+                return _batches[i];
+            }
+        }
+        _batches.emplace_back();
+        _batches.back().type = type;
+        _batches.back().scale = scale;
+        _last_batch = _batches.size() - 1;
+        return _batches.back();
+    }
+
+    // 図形を追加するたびに必要な分だけ確保すると再確保が毎回起こるため，不足する場合は少なくとも倍に広げる
+    static void reserve(batch_t &batch, const size_t n)
+    {
+        const size_t size = batch.points.size() + n;
+        if (size > batch.points.capacity())
+            batch.points.reserve(std::max(size, 2 * batch.points.capacity()));
+        if (size > batch.colors.capacity())
+            batch.colors.reserve(std::max(size, 2 * batch.colors.capacity()));
+    }
+
+    static void pushVertex(batch_t &batch, double x, double y, const std_msgs::ColorRGBA &color)
+    {
+        batch.points.emplace_back();
+        MsgGenerator::fill(batch.points.back(), x, y, 0.0);
+        batch.colors.push_back(color);
+    }
+
+    // 軸と2本の矢じりの3本の線分
+    static void pushArrow(batch_t &batch, double x, double y, double theta, double length, const std_msgs::ColorRGBA &color)
+    {
+        constexpr double HEAD_RATIO = 0.3;
+        constexpr double HEAD_COS = 0.86602540378443865; // cos(30deg)
+        constexpr double HEAD_SIN = 0.5;                 // sin(30deg)
+        const double c = std::cos(theta), s = std::sin(theta);
+        const double tip_x = x + length * c, tip_y = y + length * s;
+        const double h = length * HEAD_RATIO;
+        pushVertex(batch, x, y, color);
+        pushVertex(batch, tip_x, tip_y, color);
+        pushVertex(batch, tip_x, tip_y, color);
+        pushVertex(batch, tip_x - h * (c * HEAD_COS - s * HEAD_SIN), tip_y - h * (s * HEAD_COS + c * HEAD_SIN), color);
+        pushVertex(batch, tip_x, tip_y, color);
+        pushVertex(batch, tip_x - h * (c * HEAD_COS + s * HEAD_SIN), tip_y - h * (s * HEAD_COS - c * HEAD_SIN), color);
+    }
+
+    visualization_msgs::Marker &getMarker(visualization_msgs::MarkerArray &marker_array, const size_t index)
+    {
+        if (marker_array.markers.size() <= index)
+            marker_array.markers.emplace_back();
+        return marker_array.markers[index];
+    }
+
+    void setMarkerHeader(visualization_msgs::Marker &marker, const std_msgs::Header &header, const int id, const int type) const
+    {
+        MsgGenerator::fill(marker.header, header);
+        if (marker.ns != _ns)
+            marker.ns = _ns;
+        marker.id = id;
+        marker.type = type;
+    }
+
+    static bool isEqual(const std_msgs::ColorRGBA &a, const std_msgs::ColorRGBA &b)
+    {
+        return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+    }
+
+    static bool isEqual(const std::vector<geometry_msgs::Point> &a, const std::vector<geometry_msgs::Point> &b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].x != b[i].x || a[i].y != b[i].y || a[i].z != b[i].z)
+                return false;
+        }
+        return true;
+    }
+
+    static bool isEqual(const std::vector<std_msgs::ColorRGBA> &a, const std::vector<std_msgs::ColorRGBA> &b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (!isEqual(a[i], b[i]))
+                return false;
+        }
+        return true;
+    }
+
+    static bool isUniform(const std::vector<std_msgs::ColorRGBA> &colors)
+    {
+        for (size_t i = 1; i < colors.size(); ++i)
+        {
+            if (!isEqual(colors[i], colors[0]))
+                return false;
+        }
+        return true;
+    }
+};
+}
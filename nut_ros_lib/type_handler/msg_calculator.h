@@ -6,9 +6,16 @@
 **/
 #pragma once
 
-#include "./../nut_generic.h"
+#include "./../nut_generic_core.h"
 #include "./msg_generator.h"
 
+#include <geometry_msgs/Point.h>
+#include <geometry_msgs/Point32.h>
+#include <geometry_msgs/Pose.h>
+#include <geometry_msgs/PoseStamped.h>
+#include <geometry_msgs/Twist.h>
+#include <geometry_msgs/Vector3.h>
+
 namespace nut_ros {
 
 /**
@@ -6,9 +6,25 @@
 **/
 #pragma once
 
-#include "./../nut_generic.h"
+#include "./../nut_generic_core.h"
 #include "./../vector/vector2.h"
 #include "./../vector/pose_2D.h"
+#include "./../vector/vector2_array.h"
+#include "./../vector/pose_2D_array.h"
+
+#include <geometry_msgs/Accel.h>
+#include <geometry_msgs/Point.h>
+#include <geometry_msgs/Polygon.h>
+#include <geometry_msgs/Pose.h>
+#include <geometry_msgs/PoseArray.h>
+#include <geometry_msgs/PoseStamped.h>
+#include <geometry_msgs/Quaternion.h>
+#include <geometry_msgs/Twist.h>
+#include <geometry_msgs/Vector3.h>
+
+#include <nav_msgs/Path.h>
+
+#include <tf/transform_datatypes.h>
 
 namespace nut_ros {
 
@@ -19,15 +35,16 @@ class MsgDecoder{
 private:
 public:
     ///////////////// vector /////////////////
+    // std::vectorを返す関数は呼び出し毎にヒープ確保が発生するため，周期処理ではarray, Vector2, Pose2D版を使用すること
     /**
      * @brief geometry_msgs::Vector3型のメッセージをstd::vector（x, y, z）として取得する
      * @param vector3: geometry_msgs::Vector3のメッセージ
      * @return std::vector（x, y, z）
     **/
-    static std::vector<double> getLinearVector(geometry_msgs::Vector3 vector3)
+    static std::vector<double> getLinearVector(const geometry_msgs::Vector3 &vector3)
     {
-        std::vector<double> vector3_vector = {vector3.x, vector3.y, vector3.z};
-        return vector3_vector;
+        const auto vector3_array = getLinearArray(vector3);
+        return std::vector<double>(vector3_array.begin(), vector3_array.end());
     }
 
     /**
@@ -35,10 +52,10 @@ public:
      * @param point: geometry_msgs::Pointのメッセージ
      * @return std::vector（x, y, z）
     **/
-    static std::vector<double> getLinearVector(geometry_msgs::Point point)
+    static std::vector<double> getLinearVector(const geometry_msgs::Point &point)
     {
-        std::vector<double> point_vector = {point.x, point.y, point.z};
-        return point_vector;
+        const auto point_array = getLinearArray(point);
+        return std::vector<double>(point_array.begin(), point_array.end());
     }
 
     /**
@@ -46,7 +63,7 @@ public:
      * @param pose: geometry_msgs::Poseのメッセージ
      * @return std::vector（x, y, z）
     **/
-    static std::vector<double> getLinearVector(geometry_msgs::Pose pose)
+    static std::vector<double> getLinearVector(const geometry_msgs::Pose &pose)
     {
         return getLinearVector(pose.position);
     }
@@ -56,7 +73,7 @@ public:
      * @param pose: geometry_msgs::PoseStampedのメッセージ
      * @return std::vector（x, y, z）
     **/
-    static std::vector<double> getLinearVector(geometry_msgs::PoseStamped pose_stamped)
+    static std::vector<double> getLinearVector(const geometry_msgs::PoseStamped &pose_stamped)
     {
         return getLinearVector(pose_stamped.pose);
     }
@@ -66,7 +83,7 @@ public:
      * @param twist: geometry_msgs::Twistのメッセージ
      * @return std::vector（x, y, z）
     **/
-    static std::vector<double> getLinearVector(geometry_msgs::Twist twist)
+    static std::vector<double> getLinearVector(const geometry_msgs::Twist &twist)
     {
         return getLinearVector(twist.linear);
     }
@@ -76,7 +93,7 @@ public:
      * @param accel: geometry_msgs::Accelのメッセージ
      * @return std::vector（x, y, z）
     **/
-    static std::vector<double> getLinearVector(geometry_msgs::Accel accel)
+    static std::vector<double> getLinearVector(const geometry_msgs::Accel &accel)
     {
         return getLinearVector(accel.linear);
     }
@@ -86,14 +103,10 @@ public:
      * @param quaternion: geometry_msgs::Quaternionのメッセージ
      * @return std::vector（Roll, Pitch, Yaw）
     **/
-    static std::vector<double> getAngularVector(geometry_msgs::Quaternion quaternion)
+    static std::vector<double> getAngularVector(const geometry_msgs::Quaternion &quaternion)
     {
-        double roll, pitch, yaw;
-        tf::Quaternion tf_quaternion;
-        quaternionMsgToTF(quaternion, tf_quaternion);
-        tf::Matrix3x3(tf_quaternion).getRPY(roll, pitch, yaw);
-        std::vector<double> quaternion_vector = {roll, pitch, yaw};
-        return quaternion_vector;
+        const auto quaternion_array = getAngularArray(quaternion);
+        return std::vector<double>(quaternion_array.begin(), quaternion_array.end());
     }
 
     /**
@@ -101,7 +114,7 @@ public:
      * @param pose: geometry_msgs::Poseのメッセージ
      * @return std::vector（Roll, Pitch, Yaw）
     **/
-    static std::vector<double> getAngularVector(geometry_msgs::Pose pose)
+    static std::vector<double> getAngularVector(const geometry_msgs::Pose &pose)
     {
         return getAngularVector(pose.orientation);
     }
@@ -111,7 +124,7 @@ public:
      * @param pose_stamped: geometry_msgs::PoseStampedのメッセージ
      * @return std::vector（Roll, Pitch, Yaw）
     **/
-    static std::vector<double> getAngularVector(geometry_msgs::PoseStamped pose_stamped)
+    static std::vector<double> getAngularVector(const geometry_msgs::PoseStamped &pose_stamped)
     {
         return getAngularVector(pose_stamped.pose);
     }
@@ -121,7 +134,7 @@ public:
      * @param twist: geometry_msgs::Accelのメッセージ
      * @return std::vector（Roll, Pitch, Yaw）
     **/
-    static std::vector<double> getAngularVector(geometry_msgs::Twist twist)
+    static std::vector<double> getAngularVector(const geometry_msgs::Twist &twist)
     {
         return getLinearVector(twist.angular);
     }
@@ -131,7 +144,7 @@ public:
      * @param accel: geometry_msgs::Twistのメッセージ
      * @return std::vector（Roll, Pitch, Yaw）
     **/
-    static std::vector<double> getAngularVector(geometry_msgs::Accel accel)
+    static std::vector<double> getAngularVector(const geometry_msgs::Accel &accel)
     {
         return getLinearVector(accel.angular);
     }
@@ -141,12 +154,10 @@ public:
      * @param pose: geometry_msgs::Poseのメッセージ
      * @return std::vector（x, y, Yaw）
     **/
-    static std::vector<double> get2DVector(geometry_msgs::Pose pose)
+    static std::vector<double> get2DVector(const geometry_msgs::Pose &pose)
     {
-        auto linear_vector  = getLinearVector(pose);
-        auto angular_vector = getAngularVector(pose);
-        std::vector<double> return_vector = {linear_vector[0], linear_vector[1], angular_vector[2]};
-        return return_vector;
+        const auto pose_array = get2DArray(pose);
+        return std::vector<double>(pose_array.begin(), pose_array.end());
     }
 
     /**
@@ -154,7 +165,7 @@ public:
      * @param pose: geometry_msgs::PoseStampedのメッセージ
      * @return std::vector（x, y, Yaw）
     **/
-    static std::vector<double> get2DVector(geometry_msgs::PoseStamped pose_stamped)
+    static std::vector<double> get2DVector(const geometry_msgs::PoseStamped &pose_stamped)
     {
         return get2DVector(pose_stamped.pose);
     }
@@ -164,12 +175,57 @@ public:
      * @param twist: geometry_msgs::Twistのメッセージ
      * @return std::vector（x, y, Yaw）
     **/
-    static std::vector<double> get2DVector(geometry_msgs::Twist twist)
+    static std::vector<double> get2DVector(const geometry_msgs::Twist &twist)
+    {
+        const auto twist_array = get2DArray(twist);
+        return std::vector<double>(twist_array.begin(), twist_array.end());
+    }
+
+    /**
+     * @brief geometry_msgs::Accel型のメッセージをstd::vector（x, y, Yaw）として取得する
+     * @param accel: geometry_msgs::Accelのメッセージ
+     * @return std::vector（x, y, Yaw）
+    **/
+    static std::vector<double> get2DVector(const geometry_msgs::Accel &accel)
     {
-        auto linear_vector  = getLinearVector(twist);
-        auto angular_vector = getAngularVector(twist);
-        std::vector<double> return_vector = {linear_vector[0], linear_vector[1], angular_vector[2]};
-        return return_vector;
+        const auto accel_array = get2DArray(accel);
+        return std::vector<double>(accel_array.begin(), accel_array.end());
+    }
+
+    ///////////////// yaw /////////////////
+    /**
+     * @brief geometry_msgs::Quaternion型のメッセージからYaw角のみを取得する
+     * @details Roll, Pitchを計算せずatan2一回で求める（平面上の姿勢向け）
+     *          atan2の両引数がクォータニオンの大きさの2乗に比例する形で計算するため，正規化されていない入力でも結果は変わらない
+     * @param quaternion: geometry_msgs::Quaternionのメッセージ
+     * @return Yaw[rad]（-pi～+pi）
+     * @attention Pitchが±pi/2付近（ジンバルロック）ではtf::Matrix3x3::getRPYと結果が異なる
+    **/
+    static double getYaw(const geometry_msgs::Quaternion &quaternion)
+    {
+        const double siny_cosp = 2.0 * (quaternion.w * quaternion.z + quaternion.x * quaternion.y);
+        const double cosy_cosp = quaternion.w * quaternion.w + quaternion.x * quaternion.x - quaternion.y * quaternion.y - quaternion.z * quaternion.z;
+        return std::atan2(siny_cosp, cosy_cosp);
+    }
+
+    /**
+     * @brief geometry_msgs::Pose型のメッセージからYaw角のみを取得する
+     * @param pose: geometry_msgs::Poseのメッセージ
+     * @return Yaw[rad]（-pi～+pi）
+    **/
+    static double getYaw(const geometry_msgs::Pose &pose)
+    {
+        return getYaw(pose.orientation);
+    }
+
+    /**
+     * @brief geometry_msgs::PoseStamped型のメッセージからYaw角のみを取得する
+     * @param pose_stamped: geometry_msgs::PoseStampedのメッセージ
+     * @return Yaw[rad]（-pi～+pi）
+    **/
+    static double getYaw(const geometry_msgs::PoseStamped &pose_stamped)
+    {
+        return getYaw(pose_stamped.pose);
     }
 
     ///////////////// nut_ros::Vector2 /////////////////
@@ -178,7 +234,7 @@ public:
      * @param vector3: geometry_msgs::Vector3のメッセージ
      * @return nut_ros::Vector2（x, y）
     **/
-    static nut_ros::Vector2<double> getLinearVector2(geometry_msgs::Vector3 vector3)
+    static nut_ros::Vector2<double> getLinearVector2(const geometry_msgs::Vector3 &vector3)
     {
         nut_ros::Vector2<double> vector3_vector2(vector3.x, vector3.y);
         return vector3_vector2;
@@ -189,7 +245,7 @@ public:
      * @param point: geometry_msgs::Pointのメッセージ
      * @return nut_ros::Vector2（x, y）
     **/
-    static nut_ros::Vector2<double> getLinearVector2(geometry_msgs::Point point)
+    static nut_ros::Vector2<double> getLinearVector2(const geometry_msgs::Point &point)
     {
         nut_ros::Vector2<double> point_vector2(point.x, point.y);
         return point_vector2;
@@ -200,7 +256,7 @@ public:
      * @param pose: geometry_msgs::Poseのメッセージ
      * @return nut_ros::Vector2（x, y）
     **/
-    static nut_ros::Vector2<double> getLinearVector2(geometry_msgs::Pose pose)
+    static nut_ros::Vector2<double> getLinearVector2(const geometry_msgs::Pose &pose)
     {
         return getLinearVector2(pose.position);
     }
@@ -210,7 +266,7 @@ public:
      * @param pose: geometry_msgs::PoseStampedのメッセージ
      * @return nut_ros::Vector2（x, y）
     **/
-    static nut_ros::Vector2<double> getLinearVector2(geometry_msgs::PoseStamped pose_stamped)
+    static nut_ros::Vector2<double> getLinearVector2(const geometry_msgs::PoseStamped &pose_stamped)
     {
         return getLinearVector2(pose_stamped.pose);
     }
@@ -220,11 +276,21 @@ public:
      * @param twist: geometry_msgs::Twistのメッセージ
      * @return nut_ros::Vector2（x, y）
     **/
-    static nut_ros::Vector2<double> getLinearVector2(geometry_msgs::Twist twist)
+    static nut_ros::Vector2<double> getLinearVector2(const geometry_msgs::Twist &twist)
     {
         return getLinearVector2(twist.linear);
     }
 
+    /**
+     * @brief geometry_msgs::Accel型のメッセージをnut_ros::Vector2（x, y）として取得する
+     * @param accel: geometry_msgs::Accelのメッセージ
+     * @return nut_ros::Vector2（x, y）
+    **/
+    static nut_ros::Vector2<double> getLinearVector2(const geometry_msgs::Accel &accel)
+    {
+        return getLinearVector2(accel.linear);
+    }
+
 
     ///////////////// nut_ros::Pose2D /////////////////
     /**
@@ -232,9 +298,9 @@ public:
      * @param pose: geometry_msgs::Poseのメッセージ
      * @return nut_ros::Pose2D（x, y, Yaw）
     **/
-    static nut_ros::Pose2D<double> getPose2D(geometry_msgs::Pose pose)
+    static nut_ros::Pose2D<double> getPose2D(const geometry_msgs::Pose &pose)
     {
-        nut_ros::Pose2D<double> pose_2d(pose.position.x, pose.position.y, getAngularVector(pose)[2]);
+        nut_ros::Pose2D<double> pose_2d(pose.position.x, pose.position.y, getYaw(pose.orientation));
         return pose_2d;
     }
 
@@ -243,7 +309,7 @@ public:
      * @param pose: geometry_msgs::PoseStampedのメッセージ
      * @return nut_ros::Pose2D（x, y, Yaw）
     **/
-    static nut_ros::Pose2D<double> getPose2D(geometry_msgs::PoseStamped pose_stamped)
+    static nut_ros::Pose2D<double> getPose2D(const geometry_msgs::PoseStamped &pose_stamped)
     {
         return getPose2D(pose_stamped.pose);
     }
@@ -253,9 +319,9 @@ public:
      * @param accel: geometry_msgs::Accelのメッセージ
      * @return nut_ros::Pose2D（x, y, Yaw）
     **/
-    static nut_ros::Pose2D<double> getPose2D(geometry_msgs::Accel accel)
+    static nut_ros::Pose2D<double> getPose2D(const geometry_msgs::Accel &accel)
     {
-        nut_ros::Pose2D<double> pose_2d(getLinearVector(accel)[0], getLinearVector(accel)[1], getAngularVector(accel)[2]);
+        nut_ros::Pose2D<double> pose_2d(accel.linear.x, accel.linear.y, accel.angular.z);
         return pose_2d;
     }
 
@@ -264,20 +330,77 @@ public:
      * @param twist: geometry_msgs::Twistのメッセージ
      * @return nut_ros::Pose2D（x, y, Yaw）
     **/
-    static nut_ros::Pose2D<double> getPose2D(geometry_msgs::Twist twist)
+    static nut_ros::Pose2D<double> getPose2D(const geometry_msgs::Twist &twist)
     {
-        nut_ros::Pose2D<double> pose_2d(getLinearVector(twist)[0], getLinearVector(twist)[1], getAngularVector(twist)[2]);
+        nut_ros::Pose2D<double> pose_2d(twist.linear.x, twist.linear.y, twist.angular.z);
         return pose_2d;
     }
 
 
+    ///////////////// nut_ros::Vector2Array, nut_ros::Pose2DArray /////////////////
+    /**
+     * @brief geometry_msgs::Polygon型のメッセージをnut_ros::Vector2Array（x, y）として取得する
+     * @param polygon: geometry_msgs::Polygonのメッセージ
+     * @param vector2_array: 出力先（確保済みの領域は再利用される）
+    **/
+    template <typename T>
+    static void getVector2Array(const geometry_msgs::Polygon &polygon, nut_ros::Vector2Array<T> &vector2_array)
+    {
+        const size_t n = polygon.points.size();
+        vector2_array.resize(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            vector2_array.x[i] = (T)polygon.points[i].x;
+            vector2_array.y[i] = (T)polygon.points[i].y;
+        }
+    }
+
+    /**
+     * @brief geometry_msgs::PoseArray型のメッセージをnut_ros::Pose2DArray（x, y, Yaw）として取得する
+     * @param pose_array: geometry_msgs::PoseArrayのメッセージ
+     * @param pose_2d_array: 出力先（確保済みの領域は再利用される）
+    **/
+    template <typename T>
+    static void getPose2DArray(const geometry_msgs::PoseArray &pose_array, nut_ros::Pose2DArray<T> &pose_2d_array)
+    {
+        const size_t n = pose_array.poses.size();
+        pose_2d_array.resize(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            const geometry_msgs::Pose &pose = pose_array.poses[i];
+            pose_2d_array.x[i] = (T)pose.position.x;
+            pose_2d_array.y[i] = (T)pose.position.y;
+            pose_2d_array.theta[i] = (T)getYaw(pose.orientation);
+        }
+    }
+
+    /**
+     * @brief nav_msgs::Path型のメッセージをnut_ros::Pose2DArray（x, y, Yaw）として取得する
+     * @param path: nav_msgs::Pathのメッセージ
+     * @param pose_2d_array: 出力先（確保済みの領域は再利用される）
+    **/
+    template <typename T>
+    static void getPose2DArray(const nav_msgs::Path &path, nut_ros::Pose2DArray<T> &pose_2d_array)
+    {
+        const size_t n = path.poses.size();
+        pose_2d_array.resize(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            const geometry_msgs::Pose &pose = path.poses[i].pose;
+            pose_2d_array.x[i] = (T)pose.position.x;
+            pose_2d_array.y[i] = (T)pose.position.y;
+            pose_2d_array.theta[i] = (T)getYaw(pose.orientation);
+        }
+    }
+
+
     ///////////////// array /////////////////
     /**
      * @brief geometry_msgs::Vector3型のメッセージをstd::array（x, y, z）として取得する
      * @param vector3: geometry_msgs::Vector3のメッセージ
      * @return std::array（x, y, z）
     **/
-    static std::array<double, 3> getLinearArray(geometry_msgs::Vector3 vector3)
+    static std::array<double, 3> getLinearArray(const geometry_msgs::Vector3 &vector3)
     {
         std::array<double, 3> vector3_array = {vector3.x, vector3.y, vector3.z};
         return vector3_array;
@@ -288,7 +411,7 @@ public:
      * @param point: geometry_msgs::Pointのメッセージ
      * @return std::array（x, y, z）
     **/
-    static std::array<double, 3> getLinearArray(geometry_msgs::Point point)
+    static std::array<double, 3> getLinearArray(const geometry_msgs::Point &point)
     {
         std::array<double, 3> point_array = {point.x, point.y, point.z};
         return point_array;
@@ -299,7 +422,7 @@ public:
      * @param pose: geometry_msgs::Poseのメッセージ
      * @return std::array（x, y, z）
     **/
-    static std::array<double, 3> getLinearArray(geometry_msgs::Pose pose)
+    static std::array<double, 3> getLinearArray(const geometry_msgs::Pose &pose)
     {
         return getLinearArray(pose.position);
     }
@@ -309,7 +432,7 @@ public:
      * @param pose_stamped: geometry_msgs::PoseStampedのメッセージ
      * @return std::array（x, y, z）
     **/
-    static std::array<double, 3> getLinearArray(geometry_msgs::PoseStamped pose_stamped)
+    static std::array<double, 3> getLinearArray(const geometry_msgs::PoseStamped &pose_stamped)
     {
         return getLinearArray(pose_stamped.pose);
     }
@@ -319,17 +442,27 @@ public:
      * @param twist: geometry_msgs::Twistのメッセージ
      * @return std::array（x, y, z）
     **/
-    static std::array<double, 3> getLinearArray(geometry_msgs::Twist twist)
+    static std::array<double, 3> getLinearArray(const geometry_msgs::Twist &twist)
     {
         return getLinearArray(twist.linear);
     }
 
+    /**
+     * @brief geometry_msgs::Accel型のメッセージをstd::array（x, y, z）として取得する
+     * @param accel: geometry_msgs::Accelのメッセージ
+     * @return std::array（x, y, z）
+    **/
+    static std::array<double, 3> getLinearArray(const geometry_msgs::Accel &accel)
+    {
+        return getLinearArray(accel.linear);
+    }
+
     /**
      * @brief geometry_msgs::Quaternion型のメッセージをstd::array（Roll, Pitch, Yaw）として取得する
      * @param quaternion: geometry_msgs::Quaternionのメッセージ
      * @return std::array（Roll, Pitch, Yaw）
     **/
-    static std::array<double, 3> getAngularArray(geometry_msgs::Quaternion quaternion)
+    static std::array<double, 3> getAngularArray(const geometry_msgs::Quaternion &quaternion)
     {
         double roll, pitch, yaw;
         tf::Quaternion tf_quaternion;
@@ -344,7 +477,7 @@ public:
      * @param pose: geometry_msgs::Poseのメッセージ
      * @return std::array（Roll, Pitch, Yaw）
     **/
-    static std::array<double, 3> getAngularArray(geometry_msgs::Pose pose)
+    static std::array<double, 3> getAngularArray(const geometry_msgs::Pose &pose)
     {
         return getAngularArray(pose.orientation);
     }
@@ -354,7 +487,7 @@ public:
      * @param pose_stamped: geometry_msgs::PoseStampedのメッセージ
      * @return std::array（Roll, Pitch, Yaw）
     **/
-    static std::array<double, 3> getAngularArray(geometry_msgs::PoseStamped pose_stamped)
+    static std::array<double, 3> getAngularArray(const geometry_msgs::PoseStamped &pose_stamped)
     {
         return getAngularArray(pose_stamped.pose);
     }
@@ -364,21 +497,29 @@ public:
      * @param twist: geometry_msgs::Twistのメッセージ
      * @return std::array（Roll, Pitch, Yaw）
     **/
-    static std::array<double, 3> getAngularArray(geometry_msgs::Twist twist)
+    static std::array<double, 3> getAngularArray(const geometry_msgs::Twist &twist)
     {
         return getLinearArray(twist.angular);
     }
 
+    /**
+     * @brief geometry_msgs::Accel型のメッセージをstd::array（Roll, Pitch, Yaw）として取得する
+     * @param accel: geometry_msgs::Accelのメッセージ
+     * @return std::array（Roll, Pitch, Yaw）
+    **/
+    static std::array<double, 3> getAngularArray(const geometry_msgs::Accel &accel)
+    {
+        return getLinearArray(accel.angular);
+    }
+
     /**
      * @brief geometry_msgs::Pose型のメッセージをstd::array（x, y, Yaw）として取得する
      * @param pose: geometry_msgs::Poseのメッセージ
      * @return std::array（x, y, Yaw）
     **/
-    static std::array<double, 3> get2DArray(geometry_msgs::Pose pose)
+    static std::array<double, 3> get2DArray(const geometry_msgs::Pose &pose)
     {
-        auto linear_array  = getLinearArray(pose);
-        auto angular_array = getAngularArray(pose);
-        std::array<double, 3> return_array = {linear_array[0], linear_array[1], angular_array[2]};
+        std::array<double, 3> return_array = {pose.position.x, pose.position.y, getYaw(pose.orientation)};
         return return_array;
     }
 
@@ -387,7 +528,7 @@ public:
      * @param pose: geometry_msgs::PoseStampedのメッセージ
      * @return std::array（x, y, Yaw）
     **/
-    static std::array<double, 3> get2DArray(geometry_msgs::PoseStamped pose_stamped)
+    static std::array<double, 3> get2DArray(const geometry_msgs::PoseStamped &pose_stamped)
     {
         return get2DArray(pose_stamped.pose);
     }
@@ -397,11 +538,20 @@ public:
      * @param twist: geometry_msgs::Twistのメッセージ
      * @return std::array（x, y, Yaw）
     **/
-    static std::array<double, 3> get2DArray(geometry_msgs::Twist twist)
+    static std::array<double, 3> get2DArray(const geometry_msgs::Twist &twist)
+    {
+        std::array<double, 3> return_array = {twist.linear.x, twist.linear.y, twist.angular.z};
+        return return_array;
+    }
+
+    /**
+     * @brief geometry_msgs::Accel型のメッセージをstd::array（x, y, Yaw）として取得する
+     * @param accel: geometry_msgs::Accelのメッセージ
+     * @return std::array（x, y, Yaw）
+    **/
+    static std::array<double, 3> get2DArray(const geometry_msgs::Accel &accel)
     {
-        auto linear_array  = getLinearArray(twist);
-        auto angular_array = getAngularArray(twist);
-        std::array<double, 3> return_array = {linear_array[0], linear_array[1], angular_array[2]};
+        std::array<double, 3> return_array = {accel.linear.x, accel.linear.y, accel.angular.z};
         return return_array;
     }
 
@@ -6,17 +6,55 @@
 **/
 #pragma once
 
-#include "./../nut_generic.h"
+#include "./../nut_generic_core.h"
+#include "./../vector/pose_2D.h"
+#include "./../vector/pose_2D_array.h"
+#include "./../vector/rotation_2D.h"
+
+#include <ros/time.h>
+
+#include <std_msgs/ColorRGBA.h>
+#include <std_msgs/Header.h>
+
+#include <geometry_msgs/Accel.h>
+#include <geometry_msgs/Point.h>
+#include <geometry_msgs/Point32.h>
+#include <geometry_msgs/Pose.h>
+#include <geometry_msgs/Pose2D.h>
+#include <geometry_msgs/PoseArray.h>
+#include <geometry_msgs/PoseStamped.h>
+#include <geometry_msgs/PoseWithCovariance.h>
+#include <geometry_msgs/PoseWithCovarianceStamped.h>
+#include <geometry_msgs/Quaternion.h>
+#include <geometry_msgs/Transform.h>
+#include <geometry_msgs/TransformStamped.h>
+#include <geometry_msgs/Twist.h>
+#include <geometry_msgs/Vector3.h>
+
+#include <nav_msgs/Odometry.h>
+#include <nav_msgs/Path.h>
+
+#include <tf/transform_datatypes.h>
 
 namespace nut_ros
 {
 
     /**
  * @brief ROSのさまざまなメッセージ型を簡単に生成できるようにする
+ * @details to〜()は新しいメッセージを生成して返す
+ *          高頻度でpublishする場合は，使い回すメッセージ（またはMsgPoolから取得したboost::shared_ptrの中身）にfill()で直接書き込むことで，
+ *          中間オブジェクトの生成やframe_idの再確保を避けられる
 **/
     class MsgGenerator
     {
     private:
+        // frame_idが変化した場合のみ代入する（同じ文字列の再代入によるコピーを避ける）
+        static void setFrameId(std::string &dst, const std::string &frame_id)
+        {
+            if (dst != frame_id)
+                dst = frame_id;
+        }
+
     public:
         /**
      * @brief 引数に応じたstd_msgs::Header型のメッセージを返す
@@ -24,12 +62,11 @@ namespace nut_ros
      * @param seq: シーケンス番号（任意）
      * @return std_msgs::Header型のメッセージ
     **/
-        static std_msgs::Header toHeader(std::string frame_id, const uint32_t seq = 0)
+        static std_msgs::Header toHeader(const std::string &frame_id, const uint32_t seq = 0)
         {
             std_msgs::Header header;
             header.seq = seq;
-            header.stamp = ros::Time::now();
-            header.frame_id = frame_id;
+            fill(header, frame_id);
             return header;
         }
 
@@ -44,10 +81,7 @@ namespace nut_ros
         static std_msgs::ColorRGBA toColorRGBA(double r, double g, double b, double a)
         {
             std_msgs::ColorRGBA color;
-            color.r = r;
-            color.g = g;
-            color.b = b;
-            color.a = a;
+            fill(color, r, g, b, a);
             return color;
         }
 
@@ -61,9 +95,7 @@ namespace nut_ros
         static geometry_msgs::Point toPoint(double x, double y, double z)
         {
             geometry_msgs::Point point;
-            point.x = x;
-            point.y = y;
-            point.z = z;
+            fill(point, x, y, z);
             return point;
         }
 
@@ -77,9 +109,7 @@ namespace nut_ros
         static geometry_msgs::Point32 toPoint32(float x, float y, float z)
         {
             geometry_msgs::Point32 point32;
-            point32.x = x;
-            point32.y = y;
-            point32.z = z;
+            fill(point32, x, y, z);
             return point32;
         }
 
@@ -92,7 +122,22 @@ namespace nut_ros
     **/
         static geometry_msgs::Quaternion toQuaternion(double roll, double pitch, double yaw)
         {
-            return tf::createQuaternionMsgFromRollPitchYaw(roll, pitch, yaw);
+            geometry_msgs::Quaternion quaternion;
+            fill(quaternion, roll, pitch, yaw);
+            return quaternion;
+        }
+
+        /**
+     * @brief Yaw角のみを指定してgeometry_msgs::Quaternion型のメッセージを返す
+     * @details Roll, Pitchはゼロとして三角関数2回のみで求める
+     * @param yaw: ヨー角度[rad]
+     * @return geometry_msgs::Quaternion型のメッセージ
+    **/
+        static geometry_msgs::Quaternion toQuaternion(double yaw)
+        {
+            geometry_msgs::Quaternion quaternion;
+            fill(quaternion, yaw);
+            return quaternion;
         }
 
         /**
@@ -107,10 +152,7 @@ namespace nut_ros
         static geometry_msgs::Quaternion toQuaternion(double x, double y, double z, double w)
         {
             geometry_msgs::Quaternion quaternion;
-            quaternion.x = x;
-            quaternion.y = y;
-            quaternion.z = z;
-            quaternion.w = w;
+            fill(quaternion, x, y, z, w);
             return quaternion;
         }
 
@@ -120,7 +162,7 @@ namespace nut_ros
      * @param orientation: 方向成分
      * @return geometry_msgs::Pose型のメッセージ
     **/
-        static geometry_msgs::Pose toPose(geometry_msgs::Point position, geometry_msgs::Quaternion orientation)
+        static geometry_msgs::Pose toPose(const geometry_msgs::Point &position, const geometry_msgs::Quaternion &orientation)
         {
             geometry_msgs::Pose pose;
             pose.position = position;
@@ -140,7 +182,9 @@ namespace nut_ros
     **/
         static geometry_msgs::Pose toPose(double x, double y, double z, double roll, double pitch, double yaw)
         {
-            return toPose(toPoint(x, y, z), toQuaternion(roll, pitch, yaw));
+            geometry_msgs::Pose pose;
+            fill(pose, x, y, z, roll, pitch, yaw);
+            return pose;
         }
 
         /**
@@ -152,7 +196,9 @@ namespace nut_ros
     **/
         static geometry_msgs::Pose toPose(double x, double y, double yaw)
         {
-            return toPose(x, y, 0.0, 0.0, 0.0, yaw);
+            geometry_msgs::Pose pose;
+            fill(pose, x, y, yaw);
+            return pose;
         }
 
         /**
@@ -161,7 +207,7 @@ namespace nut_ros
      * @param pose: 姿勢（位置と方向を持つもの）
      * @return geometry_msgs::PoseStamped型のメッセージ
     **/
-        static geometry_msgs::PoseStamped toPoseStamped(std_msgs::Header header, geometry_msgs::Pose pose)
+        static geometry_msgs::PoseStamped toPoseStamped(const std_msgs::Header &header, const geometry_msgs::Pose &pose)
         {
             geometry_msgs::PoseStamped pose_stamped;
             pose_stamped.header = header;
@@ -176,9 +222,13 @@ namespace nut_ros
      * @param orientation: 方向成分
      * @return geometry_msgs::PoseStamped型のメッセージ
     **/
-        static geometry_msgs::PoseStamped toPoseStamped(std_msgs::Header header, geometry_msgs::Point position, geometry_msgs::Quaternion orientation)
+        static geometry_msgs::PoseStamped toPoseStamped(const std_msgs::Header &header, const geometry_msgs::Point &position, const geometry_msgs::Quaternion &orientation)
         {
-            return toPoseStamped(header, toPose(position, orientation));
+            geometry_msgs::PoseStamped pose_stamped;
+            pose_stamped.header = header;
+            pose_stamped.pose.position = position;
+            pose_stamped.pose.orientation = orientation;
+            return pose_stamped;
         }
 
         /**
@@ -192,9 +242,12 @@ namespace nut_ros
      * @param yaw: ヨー角度[rad]
      * @return geometry_msgs::PoseStamped型のメッセージ
     **/
-        static geometry_msgs::PoseStamped toPoseStamped(std_msgs::Header header, double x, double y, double z, double roll, double pitch, double yaw)
+        static geometry_msgs::PoseStamped toPoseStamped(const std_msgs::Header &header, double x, double y, double z, double roll, double pitch, double yaw)
         {
-            return toPoseStamped(header, toPose(x, y, z, roll, pitch, yaw));
+            geometry_msgs::PoseStamped pose_stamped;
+            pose_stamped.header = header;
+            fill(pose_stamped.pose, x, y, z, roll, pitch, yaw);
+            return pose_stamped;
         }
 
         /**
@@ -208,9 +261,11 @@ namespace nut_ros
      * @param yaw: ヨー角度[rad]
      * @return geometry_msgs::PoseStamped型のメッセージ
     **/
-        static geometry_msgs::PoseStamped toPoseStamped(std::string frame_id, double x, double y, double z, double roll, double pitch, double yaw)
+        static geometry_msgs::PoseStamped toPoseStamped(const std::string &frame_id, double x, double y, double z, double roll, double pitch, double yaw)
         {
-            return toPoseStamped(toHeader(frame_id), x, y, z, roll, pitch, yaw);
+            geometry_msgs::PoseStamped pose_stamped;
+            fill(pose_stamped, frame_id, x, y, z, roll, pitch, yaw);
+            return pose_stamped;
         }
 
         /**
@@ -221,9 +276,11 @@ namespace nut_ros
      * @param yaw: ヨー角度[rad]
      * @return geometry_msgs::PoseStamped型のメッセージ
     **/
-        static geometry_msgs::PoseStamped toPoseStamped(std::string frame_id, double x, double y, double yaw)
+        static geometry_msgs::PoseStamped toPoseStamped(const std::string &frame_id, double x, double y, double yaw)
         {
-            return toPoseStamped(frame_id, x, y, 0.0, 0.0, 0.0, yaw);
+            geometry_msgs::PoseStamped pose_stamped;
+            fill(pose_stamped, frame_id, x, y, yaw);
+            return pose_stamped;
         }
 
         /**
@@ -236,9 +293,7 @@ namespace nut_ros
         static geometry_msgs::Vector3 toVector3(double x, double y, double z)
         {
             geometry_msgs::Vector3 vector3;
-            vector3.x = x;
-            vector3.y = y;
-            vector3.z = z;
+            fill(vector3, x, y, z);
             return vector3;
         }
 
@@ -248,7 +303,7 @@ namespace nut_ros
      * @param angular: 回転速度[rad/s]
      * @return geometry_msgs::Twist型のメッセージ
     **/
-        static geometry_msgs::Twist toTwist(geometry_msgs::Vector3 linear, geometry_msgs::Vector3 angular)
+        static geometry_msgs::Twist toTwist(const geometry_msgs::Vector3 &linear, const geometry_msgs::Vector3 &angular)
         {
             geometry_msgs::Twist twist;
             twist.linear = linear;
@@ -268,7 +323,9 @@ namespace nut_ros
     **/
         static geometry_msgs::Twist toTwist(double x, double y, double z, double roll, double pitch, double yaw)
         {
-            return toTwist(toVector3(x, y, z), toVector3(roll, pitch, yaw));
+            geometry_msgs::Twist twist;
+            fill(twist, x, y, z, roll, pitch, yaw);
+            return twist;
         }
 
         /**
@@ -280,7 +337,9 @@ namespace nut_ros
     **/
         static geometry_msgs::Twist toTwist(double x, double y, double yaw)
         {
-            return toTwist(x, y, 0.0, 0.0, 0.0, yaw);
+            geometry_msgs::Twist twist;
+            fill(twist, x, y, yaw);
+            return twist;
         }
 
         /**
@@ -289,7 +348,7 @@ namespace nut_ros
      * @param angular: 回転速度[rad/s]
      * @return geometry_msgs::Accel型のメッセージ
     **/
-        static geometry_msgs::Accel toAccel(geometry_msgs::Vector3 linear, geometry_msgs::Vector3 angular)
+        static geometry_msgs::Accel toAccel(const geometry_msgs::Vector3 &linear, const geometry_msgs::Vector3 &angular)
         {
             geometry_msgs::Accel accel;
             accel.linear = linear;
@@ -309,7 +368,9 @@ namespace nut_ros
     **/
         static geometry_msgs::Accel toAccel(double x, double y, double z, double roll, double pitch, double yaw)
         {
-            return toAccel(toVector3(x, y, z), toVector3(roll, pitch, yaw));
+            geometry_msgs::Accel accel;
+            fill(accel, x, y, z, roll, pitch, yaw);
+            return accel;
         }
 
         /**
@@ -321,7 +382,9 @@ namespace nut_ros
     **/
         static geometry_msgs::Accel toAccel(double x, double y, double yaw)
         {
-            return toAccel(x, y, 0.0, 0.0, 0.0, yaw);
+            geometry_msgs::Accel accel;
+            fill(accel, x, y, yaw);
+            return accel;
         }
 
         /**
@@ -330,7 +393,7 @@ namespace nut_ros
          * @param rotation: 回転成分
          * @return geometry_msgs::Transform型のメッセージ
         **/
-        static geometry_msgs::Transform toTransform(geometry_msgs::Vector3 translation, geometry_msgs::Quaternion rotation)
+        static geometry_msgs::Transform toTransform(const geometry_msgs::Vector3 &translation, const geometry_msgs::Quaternion &rotation)
         {
             geometry_msgs::Transform transform;
             transform.translation = translation;
@@ -350,7 +413,9 @@ namespace nut_ros
         **/
         static geometry_msgs::Transform toTransform(double x, double y, double z, double roll, double pitch, double yaw)
         {
-            return toTransform(toVector3(x, y, z), toQuaternion(roll, pitch, yaw));
+            geometry_msgs::Transform transform;
+            fill(transform, x, y, z, roll, pitch, yaw);
+            return transform;
         }
 
         /**
@@ -362,101 +427,891 @@ namespace nut_ros
         **/
         static geometry_msgs::Transform toTransform(double x, double y, double yaw)
         {
-            return toTransform(x, y, 0, 0, 0, yaw);
+            geometry_msgs::Transform transform;
+            fill(transform, x, y, yaw);
+            return transform;
+        }
+
+        ///////////////// nut_ros::Pose2D /////////////////
+        /**
+     * @brief nut_ros::Pose2Dからgeometry_msgs::Accel型のメッセージを返す
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+     * @return geometry_msgs::Accel型のメッセージ
+    **/
+        template <typename T>
+        static geometry_msgs::Accel toAccel(const Pose2D<T> &pose)
+        {
+            return toAccel((double)pose.x, (double)pose.y, (double)pose.theta);
+        }
+
+        /**
+     * @brief nut_ros::Pose2Dからgeometry_msgs::Point型のメッセージを返す
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+     * @return geometry_msgs::Point型のメッセージ
+    **/
+        template <typename T>
+        static geometry_msgs::Point toPoint(const Pose2D<T> &pose)
+        {
+            return toPoint((double)pose.x, (double)pose.y, 0.0);
+        }
+
+        /**
+     * @brief nut_ros::Pose2Dからgeometry_msgs::Point32型のメッセージを返す
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+     * @return geometry_msgs::Point32型のメッセージ
+    **/
+        template <typename T>
+        static geometry_msgs::Point32 toPoint32(const Pose2D<T> &pose)
+        {
+            return toPoint32((float)pose.x, (float)pose.y, 0.0);
+        }
+
+        /**
+     * @brief nut_ros::Pose2Dからgeometry_msgs::Pose型のメッセージを返す
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+     * @return geometry_msgs::Pose型のメッセージ
+    **/
+        template <typename T>
+        static geometry_msgs::Pose toPose(const Pose2D<T> &pose)
+        {
+            return toPose((double)pose.x, (double)pose.y, (double)pose.theta);
+        }
+
+        /**
+     * @brief nut_ros::Pose2Dからgeometry_msgs::Pose2D型のメッセージを返す
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+     * @return geometry_msgs::Pose2D型のメッセージ
+    **/
+        template <typename T>
+        static geometry_msgs::Pose2D toPose2D(const Pose2D<T> &pose)
+        {
+            geometry_msgs::Pose2D pose2d;
+            fill(pose2d, pose);
+            return pose2d;
+        }
+
+        /**
+     * @brief nut_ros::Pose2Dの角度成分からgeometry_msgs::Quaternion型のメッセージを返す
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+     * @return geometry_msgs::Quaternion型のメッセージ
+    **/
+        template <typename T>
+        static geometry_msgs::Quaternion toQuaternion(const Pose2D<T> &pose)
+        {
+            return toQuaternion((double)pose.theta);
+        }
+
+        /**
+     * @brief nut_ros::Pose2Dからgeometry_msgs::Transform型のメッセージを返す
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+     * @return geometry_msgs::Transform型のメッセージ
+    **/
+        template <typename T>
+        static geometry_msgs::Transform toTransform(const Pose2D<T> &pose)
+        {
+            return toTransform((double)pose.x, (double)pose.y, (double)pose.theta);
+        }
+
+        /**
+     * @brief nut_ros::Pose2Dからgeometry_msgs::Twist型のメッセージを返す
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+     * @return geometry_msgs::Twist型のメッセージ
+    **/
+        template <typename T>
+        static geometry_msgs::Twist toTwist(const Pose2D<T> &pose)
+        {
+            return toTwist((double)pose.x, (double)pose.y, (double)pose.theta);
+        }
+
+        /**
+     * @brief nut_ros::Pose2Dからgeometry_msgs::Vector3型のメッセージを返す
+     * @details vector3のx,y,zはPose2Dのx,y,thetaに対応して格納される
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+     * @return geometry_msgs::Vector3型のメッセージ
+    **/
+        template <typename T>
+        static geometry_msgs::Vector3 toVector3(const Pose2D<T> &pose)
+        {
+            return toVector3((double)pose.x, (double)pose.y, (double)pose.theta);
+        }
+
+        ///////////////// nut_ros::Pose2DArray /////////////////
+        /**
+     * @brief nut_ros::Pose2DArrayからgeometry_msgs::PoseArray型のメッセージを返す
+     * @param header: ヘッダー
+     * @param pose_2d_array: nut_ros::Pose2DArray（x, y, Yaw）
+     * @return geometry_msgs::PoseArray型のメッセージ
+    **/
+        template <typename T>
+        static geometry_msgs::PoseArray toPoseArray(const std_msgs::Header &header, const Pose2DArray<T> &pose_2d_array)
+        {
+            geometry_msgs::PoseArray pose_array;
+            fill(pose_array, header, pose_2d_array);
+            return pose_array;
+        }
+
+        /**
+     * @brief nut_ros::Pose2DArrayからnav_msgs::Path型のメッセージを返す
+     * @param header: ヘッダー（各点のヘッダーにも同じものが設定される）
+     * @param pose_2d_array: nut_ros::Pose2DArray（x, y, Yaw）
+     * @return nav_msgs::Path型のメッセージ
+    **/
+        template <typename T>
+        static nav_msgs::Path toPath(const std_msgs::Header &header, const Pose2DArray<T> &pose_2d_array)
+        {
+            nav_msgs::Path path;
+            fill(path, header, pose_2d_array);
+            return path;
+        }
+
+        ///////////////// fill（既存のメッセージに直接書き込む） /////////////////
+        /**
+     * @brief 既存のstd_msgs::Header型のメッセージに書き込む
+     * @details frame_idは変化した場合のみ代入するため，同じメッセージを使い回す場合は文字列の再確保が発生しない
+     *          seqは変更しない
+     * @param header: 書き込み先
+     * @param frame_id: 基準フレームのID
+     * @param stamp: タイムスタンプ
+    **/
+        static void fill(std_msgs::Header &header, const std::string &frame_id, const ros::Time &stamp)
+        {
+            header.stamp = stamp;
+            setFrameId(header.frame_id, frame_id);
+        }
+
+        /**
+     * @brief 既存のstd_msgs::Header型のメッセージに現在時刻で書き込む
+     * @param header: 書き込み先
+     * @param frame_id: 基準フレームのID
+    **/
+        static void fill(std_msgs::Header &header, const std::string &frame_id)
+        {
+            fill(header, frame_id, ros::Time::now());
+        }
+
+        /**
+     * @brief 既存のstd_msgs::Header型のメッセージに別のヘッダーの内容を書き込む
+     * @details frame_idは変化した場合のみ代入する
+     * @param header: 書き込み先
+     * @param src: 書き込む内容
+    **/
+        static void fill(std_msgs::Header &header, const std_msgs::Header &src)
+        {
+            header.seq = src.seq;
+            fill(header, src.frame_id, src.stamp);
+        }
+
+        /**
+     * @brief 既存のstd_msgs::ColorRGBA型のメッセージに書き込む
+     * @param color: 書き込み先
+     * @param r: 赤色値（0.0 to 1.0）
+     * @param g: 緑色値（0.0 to 1.0）
+     * @param b: 青色値（0.0 to 1.0）
+     * @param a: 透明度（0.0 to 1.0）
+    **/
+        static void fill(std_msgs::ColorRGBA &color, double r, double g, double b, double a)
+        {
+            color.r = r;
+            color.g = g;
+            color.b = b;
+            color.a = a;
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Point型のメッセージに書き込む
+     * @param point: 書き込み先
+     * @param x: x[m]
+     * @param y: y[m]
+     * @param z: z[m]
+    **/
+        static void fill(geometry_msgs::Point &point, double x, double y, double z)
+        {
+            point.x = x;
+            point.y = y;
+            point.z = z;
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Point32型のメッセージに書き込む
+     * @param point32: 書き込み先
+     * @param x: x[m]
+     * @param y: y[m]
+     * @param z: z[m]
+    **/
+        static void fill(geometry_msgs::Point32 &point32, float x, float y, float z)
+        {
+            point32.x = x;
+            point32.y = y;
+            point32.z = z;
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Vector3型のメッセージに書き込む
+     * @param vector3: 書き込み先
+     * @param x: x
+     * @param y: y
+     * @param z: z
+    **/
+        static void fill(geometry_msgs::Vector3 &vector3, double x, double y, double z)
+        {
+            vector3.x = x;
+            vector3.y = y;
+            vector3.z = z;
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Quaternion型のメッセージに書き込む
+     * @param quaternion: 書き込み先
+     * @param x: x
+     * @param y: y
+     * @param z: z
+     * @param w: w
+     * @attention Quaternionのノルムは必ず1となるようにしなければならない
+    **/
+        static void fill(geometry_msgs::Quaternion &quaternion, double x, double y, double z, double w)
+        {
+            quaternion.x = x;
+            quaternion.y = y;
+            quaternion.z = z;
+            quaternion.w = w;
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Quaternion型のメッセージにRoll, Pitch, Yaw角から書き込む
+     * @details tf::createQuaternionMsgFromRollPitchYaw()と同じ式を用いるが，tf::Quaternionを経由しない
+     * @param quaternion: 書き込み先
+     * @param roll: ロール角度[rad]
+     * @param pitch: ピッチ角度[rad]
+     * @param yaw: ヨー角度[rad]
+    **/
+        static void fill(geometry_msgs::Quaternion &quaternion, double roll, double pitch, double yaw)
+        {
+            const double cr = std::cos(roll * 0.5), sr = std::sin(roll * 0.5);
+            const double cp = std::cos(pitch * 0.5), sp = std::sin(pitch * 0.5);
+            const double cy = std::cos(yaw * 0.5), sy = std::sin(yaw * 0.5);
+            quaternion.x = sr * cp * cy - cr * sp * sy;
+            quaternion.y = cr * sp * cy + sr * cp * sy;
+            quaternion.z = cr * cp * sy - sr * sp * cy;
+            quaternion.w = cr * cp * cy + sr * sp * sy;
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Quaternion型のメッセージにYaw角のみから書き込む
+     * @details Roll, Pitchはゼロとして三角関数2回のみで求める
+     * @param quaternion: 書き込み先
+     * @param yaw: ヨー角度[rad]
+    **/
+        static void fill(geometry_msgs::Quaternion &quaternion, double yaw)
+        {
+            quaternion.x = 0.0;
+            quaternion.y = 0.0;
+            quaternion.z = std::sin(yaw * 0.5);
+            quaternion.w = std::cos(yaw * 0.5);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Pose型のメッセージに書き込む
+     * @param pose: 書き込み先
+     * @param x: x[m]
+     * @param y: y[m]
+     * @param z: z[m]
+     * @param roll: ロール角度[rad]
+     * @param pitch: ピッチ角度[rad]
+     * @param yaw: ヨー角度[rad]
+    **/
+        static void fill(geometry_msgs::Pose &pose, double x, double y, double z, double roll, double pitch, double yaw)
+        {
+            fill(pose.position, x, y, z);
+            fill(pose.orientation, roll, pitch, yaw);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Pose型のメッセージに平面上の位置姿勢を書き込む
+     * @param pose: 書き込み先
+     * @param x: x[m]
+     * @param y: y[m]
+     * @param yaw: ヨー角度[rad]
+    **/
+        static void fill(geometry_msgs::Pose &pose, double x, double y, double yaw)
+        {
+            fill(pose.position, x, y, 0.0);
+            fill(pose.orientation, yaw);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::PoseStamped型のメッセージに現在時刻で書き込む
+     * @param pose_stamped: 書き込み先
+     * @param frame_id: 基準フレームのID
+     * @param x: x[m]
+     * @param y: y[m]
+     * @param z: z[m]
+     * @param roll: ロール角度[rad]
+     * @param pitch: ピッチ角度[rad]
+     * @param yaw: ヨー角度[rad]
+    **/
+        static void fill(geometry_msgs::PoseStamped &pose_stamped, const std::string &frame_id, double x, double y, double z, double roll, double pitch, double yaw)
+        {
+            fill(pose_stamped.header, frame_id);
+            fill(pose_stamped.pose, x, y, z, roll, pitch, yaw);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::PoseStamped型のメッセージに現在時刻で平面上の位置姿勢を書き込む
+     * @param pose_stamped: 書き込み先
+     * @param frame_id: 基準フレームのID
+     * @param x: x[m]
+     * @param y: y[m]
+     * @param yaw: ヨー角度[rad]
+    **/
+        static void fill(geometry_msgs::PoseStamped &pose_stamped, const std::string &frame_id, double x, double y, double yaw)
+        {
+            fill(pose_stamped.header, frame_id);
+            fill(pose_stamped.pose, x, y, yaw);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Twist型のメッセージに書き込む
+     * @param twist: 書き込み先
+     * @param x: x速度[m/s]
+     * @param y: y速度[m/s]
+     * @param z: z速度[m/s]
+     * @param roll: ロール角速度[rad/s]
+     * @param pitch: ピッチ角速度[rad/s]
+     * @param yaw: ヨー角速度[rad/s]
+    **/
+        static void fill(geometry_msgs::Twist &twist, double x, double y, double z, double roll, double pitch, double yaw)
+        {
+            fill(twist.linear, x, y, z);
+            fill(twist.angular, roll, pitch, yaw);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Twist型のメッセージに平面上の速度を書き込む
+     * @param twist: 書き込み先
+     * @param x: x速度[m/s]
+     * @param y: y速度[m/s]
+     * @param yaw: ヨー角速度[rad/s]
+    **/
+        static void fill(geometry_msgs::Twist &twist, double x, double y, double yaw)
+        {
+            fill(twist, x, y, 0.0, 0.0, 0.0, yaw);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Accel型のメッセージに書き込む
+     * @param accel: 書き込み先
+     * @param x: x加速度[m/s^2]
+     * @param y: y加速度[m/s^2]
+     * @param z: z加速度[m/s^2]
+     * @param roll: ロール角加速度[rad/s^2]
+     * @param pitch: ピッチ角加速度[rad/s^2]
+     * @param yaw: ヨー角加速度[rad/s^2]
+    **/
+        static void fill(geometry_msgs::Accel &accel, double x, double y, double z, double roll, double pitch, double yaw)
+        {
+            fill(accel.linear, x, y, z);
+            fill(accel.angular, roll, pitch, yaw);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Accel型のメッセージに平面上の加速度を書き込む
+     * @param accel: 書き込み先
+     * @param x: x加速度[m/s^2]
+     * @param y: y加速度[m/s^2]
+     * @param yaw: ヨー角加速度[rad/s^2]
+    **/
+        static void fill(geometry_msgs::Accel &accel, double x, double y, double yaw)
+        {
+            fill(accel, x, y, 0.0, 0.0, 0.0, yaw);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Transform型のメッセージに書き込む
+     * @param transform: 書き込み先
+     * @param x: x[m]
+     * @param y: y[m]
+     * @param z: z[m]
+     * @param roll: ロール角度[rad]
+     * @param pitch: ピッチ角度[rad]
+     * @param yaw: ヨー角度[rad]
+    **/
+        static void fill(geometry_msgs::Transform &transform, double x, double y, double z, double roll, double pitch, double yaw)
+        {
+            fill(transform.translation, x, y, z);
+            fill(transform.rotation, roll, pitch, yaw);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Transform型のメッセージに平面上の変換を書き込む
+     * @param transform: 書き込み先
+     * @param x: x[m]
+     * @param y: y[m]
+     * @param yaw: ヨー角度[rad]
+    **/
+        static void fill(geometry_msgs::Transform &transform, double x, double y, double yaw)
+        {
+            fill(transform.translation, x, y, 0.0);
+            fill(transform.rotation, yaw);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::TransformStamped型のメッセージに現在時刻で平面上の変換を書き込む
+     * @details frame_id, child_frame_idは変化した場合のみ代入する（tfのbroadcast用）
+     * @param transform_stamped: 書き込み先
+     * @param frame_id: 親フレームのID
+     * @param child_frame_id: 子フレームのID
+     * @param x: x[m]
+     * @param y: y[m]
+     * @param yaw: ヨー角度[rad]
+    **/
+        static void fill(geometry_msgs::TransformStamped &transform_stamped, const std::string &frame_id, const std::string &child_frame_id, double x, double y, double yaw)
+        {
+            fill(transform_stamped.header, frame_id);
+            setFrameId(transform_stamped.child_frame_id, child_frame_id);
+            fill(transform_stamped.transform, x, y, yaw);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Point型のメッセージにnut_ros::Pose2Dの位置を書き込む
+     * @param point: 書き込み先
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+    **/
+        template <typename T>
+        static void fill(geometry_msgs::Point &point, const Pose2D<T> &pose)
+        {
+            fill(point, (double)pose.x, (double)pose.y, 0.0);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Pose型のメッセージにnut_ros::Pose2Dを書き込む
+     * @param pose_msg: 書き込み先
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+    **/
+        template <typename T>
+        static void fill(geometry_msgs::Pose &pose_msg, const Pose2D<T> &pose)
+        {
+            fill(pose_msg, (double)pose.x, (double)pose.y, (double)pose.theta);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Pose2D型のメッセージにnut_ros::Pose2Dを書き込む
+     * @param pose_msg: 書き込み先
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+    **/
+        template <typename T>
+        static void fill(geometry_msgs::Pose2D &pose_msg, const Pose2D<T> &pose)
+        {
+            pose_msg.x = (double)pose.x;
+            pose_msg.y = (double)pose.y;
+            pose_msg.theta = (double)pose.theta;
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::PoseStamped型のメッセージに現在時刻でnut_ros::Pose2Dを書き込む
+     * @param pose_stamped: 書き込み先
+     * @param frame_id: 基準フレームのID
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+    **/
+        template <typename T>
+        static void fill(geometry_msgs::PoseStamped &pose_stamped, const std::string &frame_id, const Pose2D<T> &pose)
+        {
+            fill(pose_stamped, frame_id, (double)pose.x, (double)pose.y, (double)pose.theta);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Twist型のメッセージにnut_ros::Pose2Dを書き込む
+     * @param twist: 書き込み先
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+    **/
+        template <typename T>
+        static void fill(geometry_msgs::Twist &twist, const Pose2D<T> &pose)
+        {
+            fill(twist, (double)pose.x, (double)pose.y, (double)pose.theta);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::Transform型のメッセージにnut_ros::Pose2Dを書き込む
+     * @param transform: 書き込み先
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+    **/
+        template <typename T>
+        static void fill(geometry_msgs::Transform &transform, const Pose2D<T> &pose)
+        {
+            fill(transform, (double)pose.x, (double)pose.y, (double)pose.theta);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::TransformStamped型のメッセージに現在時刻でnut_ros::Pose2Dを書き込む
+     * @param transform_stamped: 書き込み先
+     * @param frame_id: 親フレームのID
+     * @param child_frame_id: 子フレームのID
+     * @param pose: nut_ros::Pose2D（x, y, Yaw）
+    **/
+        template <typename T>
+        static void fill(geometry_msgs::TransformStamped &transform_stamped, const std::string &frame_id, const std::string &child_frame_id, const Pose2D<T> &pose)
+        {
+            fill(transform_stamped, frame_id, child_frame_id, (double)pose.x, (double)pose.y, (double)pose.theta);
+        }
+
+        /**
+     * @brief 既存のnav_msgs::Odometry型のメッセージに位置姿勢と速度を書き込む
+     * @details frame_id, child_frame_idは変化した場合のみ代入する．共分散は変更しない
+     * @param odometry: 書き込み先
+     * @param frame_id: 基準フレームのID
+     * @param child_frame_id: ロボットのフレームのID
+     * @param stamp: タイムスタンプ
+     * @param pose: 位置姿勢（x, y, Yaw）
+     * @param twist: ロボット座標系の速度（x, y, Yaw）
+    **/
+        template <typename T>
+        static void fill(nav_msgs::Odometry &odometry, const std::string &frame_id, const std::string &child_frame_id, const ros::Time &stamp,
+                         const Pose2D<T> &pose, const Pose2D<T> &twist)
+        {
+            fill(odometry.header, frame_id, stamp);
+            setFrameId(odometry.child_frame_id, child_frame_id);
+            fill(odometry.pose.pose, pose);
+            fill(odometry.twist.twist, twist);
+        }
+
+        /**
+     * @brief 既存のnav_msgs::Odometry型のメッセージに現在時刻で位置姿勢と速度を書き込む
+     * @details frame_id, child_frame_idは変化した場合のみ代入する．共分散は変更しない
+     * @param odometry: 書き込み先
+     * @param frame_id: 基準フレームのID
+     * @param child_frame_id: ロボットのフレームのID
+     * @param pose: 位置姿勢（x, y, Yaw）
+     * @param twist: ロボット座標系の速度（x, y, Yaw）
+    **/
+        template <typename T>
+        static void fill(nav_msgs::Odometry &odometry, const std::string &frame_id, const std::string &child_frame_id,
+                         const Pose2D<T> &pose, const Pose2D<T> &twist)
+        {
+            fill(odometry, frame_id, child_frame_id, ros::Time::now(), pose, twist);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::PoseWithCovariance型のメッセージに位置姿勢と共分散を書き込む
+     * @details 6x6の共分散行列のx, y, Yawの成分のみを書き込み，z, Roll, Pitchの成分は変更しない
+     * @param pose_msg: 書き込み先
+     * @param pose: 位置姿勢（x, y, Yaw）
+     * @param covariance: 共分散行列（x, y, Yawの3x3，行優先）
+    **/
+        template <typename T>
+        static void fill(geometry_msgs::PoseWithCovariance &pose_msg, const Pose2D<T> &pose, const std::array<T, 9> &covariance)
+        {
+            static const size_t index[3] = {0, 1, 5};
+            fill(pose_msg.pose, pose);
+            for (size_t r = 0; r < 3; ++r)
+                for (size_t c = 0; c < 3; ++c)
+                    pose_msg.covariance[index[r] * 6 + index[c]] = covariance[r * 3 + c];
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::PoseWithCovarianceStamped型のメッセージに位置姿勢と共分散を書き込む
+     * @details frame_idは変化した場合のみ代入する
+     * @param pose_msg: 書き込み先
+     * @param frame_id: フレームID
+     * @param stamp: タイムスタンプ
+     * @param pose: 位置姿勢（x, y, Yaw）
+     * @param covariance: 共分散行列（x, y, Yawの3x3，行優先）
+    **/
+        template <typename T>
+        static void fill(geometry_msgs::PoseWithCovarianceStamped &pose_msg, const std::string &frame_id, const ros::Time &stamp,
+                         const Pose2D<T> &pose, const std::array<T, 9> &covariance)
+        {
+            fill(pose_msg.header, frame_id, stamp);
+            fill(pose_msg.pose, pose, covariance);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::PoseWithCovarianceStamped型のメッセージに現在時刻で位置姿勢と共分散を書き込む
+     * @details frame_idは変化した場合のみ代入する
+     * @param pose_msg: 書き込み先
+     * @param frame_id: フレームID
+     * @param pose: 位置姿勢（x, y, Yaw）
+     * @param covariance: 共分散行列（x, y, Yawの3x3，行優先）
+    **/
+        template <typename T>
+        static void fill(geometry_msgs::PoseWithCovarianceStamped &pose_msg, const std::string &frame_id,
+                         const Pose2D<T> &pose, const std::array<T, 9> &covariance)
+        {
+            fill(pose_msg, frame_id, ros::Time::now(), pose, covariance);
+        }
+
+        /**
+     * @brief 既存のgeometry_msgs::PoseArray型のメッセージにnut_ros::Pose2DArrayを書き込む
+     * @details posesの確保済み領域は再利用される
+     * @param pose_array: 書き込み先
+     * @param header: ヘッダー
+     * @param pose_2d_array: nut_ros::Pose2DArray（x, y, Yaw）
+    **/
+        template <typename T>
+        static void fill(geometry_msgs::PoseArray &pose_array, const std_msgs::Header &header, const Pose2DArray<T> &pose_2d_array)
+        {
+            fill(pose_array.header, header);
+            pose_array.poses.resize(pose_2d_array.size());
+            for (size_t i = 0; i < pose_2d_array.size(); ++i)
+                fill(pose_array.poses[i], (double)pose_2d_array.x[i], (double)pose_2d_array.y[i], (double)pose_2d_array.theta[i]);
+        }
+
+        /**
+     * @brief 既存のnav_msgs::Path型のメッセージにnut_ros::Pose2DArrayを書き込む
+     * @details posesの確保済み領域と各点のframe_idは再利用される
+     * @param path: 書き込み先
+     * @param header: ヘッダー（各点のヘッダーにも同じものが設定される）
+     * @param pose_2d_array: nut_ros::Pose2DArray（x, y, Yaw）
+    **/
+        template <typename T>
+        static void fill(nav_msgs::Path &path, const std_msgs::Header &header, const Pose2DArray<T> &pose_2d_array)
+        {
+            fill(path.header, header);
+            path.poses.resize(pose_2d_array.size());
+            for (size_t i = 0; i < pose_2d_array.size(); ++i)
+            {
+                fill(path.poses[i].header, header);
+                fill(path.poses[i].pose, (double)pose_2d_array.x[i], (double)pose_2d_array.y[i], (double)pose_2d_array.theta[i]);
+            }
         }
 
         /**
      * @brief 原点中心に指定した角度だけ回転させたgeometry_msgs::Point型のメッセージを返す
      * @param point: geometry_msgs::Point
-     * @param angle: 回転角度[rad/s]
+     * @param angle: 回転角度[rad]
      * @return 原点中心に指定した角度だけ回転させたgeometry_msgs::Point型のメッセージ
     **/
-        static geometry_msgs::Point
-        rotate(geometry_msgs::Point point, double angle)
+        static geometry_msgs::Point rotate(const geometry_msgs::Point &point, double angle)
         {
-            geometry_msgs::Point reutrn_point;
-            reutrn_point.x = point.x * std::cos(angle) - point.y * std::sin(angle);
-            reutrn_point.y = point.x * std::sin(angle) + point.y * std::cos(angle);
-            reutrn_point.z = point.z;
-            return reutrn_point;
+            return rotate(point, Rotation2D<double>(angle));
         }
 
         /**
-     * @brief 原点中心に指定した角度だけ回転させたgeometry_msgs::Point型のメッセージを返す
-     * @param point32: geometry_msgs::Point
-     * @param angle32: 回転角度[rad/s]
-     * @return 原点中心に指定した角度だけ回転させたgeometry_msgs::Point型のメッセージ
+     * @brief 原点中心に回転させたgeometry_msgs::Point型のメッセージを返す
+     * @details 同じ角度で多数のメッセージを回転させる場合はRotation2Dを使い回すことで三角関数の再計算を省ける
+     * @param point: geometry_msgs::Point
+     * @param rotation: 回転
+     * @return 原点中心に回転させたgeometry_msgs::Point型のメッセージ
+    **/
+        static geometry_msgs::Point rotate(const geometry_msgs::Point &point, const Rotation2D<double> &rotation)
+        {
+            geometry_msgs::Point return_point = point;
+            rotateInPlace(return_point, rotation);
+            return return_point;
+        }
+
+        /**
+     * @brief 原点中心に指定した角度だけ回転させたgeometry_msgs::Point32型のメッセージを返す
+     * @param point32: geometry_msgs::Point32
+     * @param angle: 回転角度[rad]
+     * @return 原点中心に指定した角度だけ回転させたgeometry_msgs::Point32型のメッセージ
     **/
-        static geometry_msgs::Point32 rotate(geometry_msgs::Point32 point32, float angle)
+        static geometry_msgs::Point32 rotate(const geometry_msgs::Point32 &point32, float angle)
         {
-            geometry_msgs::Point32 reutrn_point;
-            reutrn_point.x = point32.x * std::cos(angle) - point32.y * std::sin(angle);
-            reutrn_point.y = point32.x * std::sin(angle) + point32.y * std::cos(angle);
-            reutrn_point.z = point32.z;
-            return reutrn_point;
+            return rotate(point32, Rotation2D<float>(angle));
+        }
+
+        /**
+     * @brief 原点中心に回転させたgeometry_msgs::Point32型のメッセージを返す
+     * @param point32: geometry_msgs::Point32
+     * @param rotation: 回転
+     * @return 原点中心に回転させたgeometry_msgs::Point32型のメッセージ
+    **/
+        static geometry_msgs::Point32 rotate(const geometry_msgs::Point32 &point32, const Rotation2D<float> &rotation)
+        {
+            geometry_msgs::Point32 return_point = point32;
+            rotateInPlace(return_point, rotation);
+            return return_point;
         }
 
         /**
      * @brief 原点中心に指定した角度だけ回転させたgeometry_msgs::Pose型のメッセージを返す
      * @param pose: geometry_msgs::Pose
-     * @param angle: 回転角度[rad/s]
+     * @param angle: 回転角度[rad]
      * @return 原点中心に指定した角度だけ回転させたgeometry_msgs::Pose型のメッセージ
     **/
-        static geometry_msgs::Pose rotate(geometry_msgs::Pose pose, double angle)
+        static geometry_msgs::Pose rotate(const geometry_msgs::Pose &pose, double angle)
         {
-            pose.position = rotate(pose.position, angle);
-            return pose;
+            return rotate(pose, Rotation2D<double>(angle));
+        }
+
+        /**
+     * @brief 原点中心に回転させたgeometry_msgs::Pose型のメッセージを返す
+     * @param pose: geometry_msgs::Pose
+     * @param rotation: 回転
+     * @return 原点中心に回転させたgeometry_msgs::Pose型のメッセージ
+    **/
+        static geometry_msgs::Pose rotate(const geometry_msgs::Pose &pose, const Rotation2D<double> &rotation)
+        {
+            geometry_msgs::Pose return_pose = pose;
+            rotateInPlace(return_pose, rotation);
+            return return_pose;
         }
 
         /**
      * @brief 原点中心に指定した角度だけ回転させたgeometry_msgs::PoseStamped型のメッセージを返す
      * @param pose_stamped: geometry_msgs::PoseStamped
-     * @param angle: 回転角度[rad/s]
+     * @param angle: 回転角度[rad]
      * @return 原点中心に指定した角度だけ回転させたgeometry_msgs::PoseStamped型のメッセージ
     **/
-        static geometry_msgs::PoseStamped rotate(geometry_msgs::PoseStamped pose_stamped, double angle)
+        static geometry_msgs::PoseStamped rotate(const geometry_msgs::PoseStamped &pose_stamped, double angle)
         {
-            pose_stamped.pose = rotate(pose_stamped.pose, angle);
-            return pose_stamped;
+            return rotate(pose_stamped, Rotation2D<double>(angle));
+        }
+
+        /**
+     * @brief 原点中心に回転させたgeometry_msgs::PoseStamped型のメッセージを返す
+     * @param pose_stamped: geometry_msgs::PoseStamped
+     * @param rotation: 回転
+     * @return 原点中心に回転させたgeometry_msgs::PoseStamped型のメッセージ
+    **/
+        static geometry_msgs::PoseStamped rotate(const geometry_msgs::PoseStamped &pose_stamped, const Rotation2D<double> &rotation)
+        {
+            geometry_msgs::PoseStamped return_pose_stamped = pose_stamped;
+            rotateInPlace(return_pose_stamped, rotation);
+            return return_pose_stamped;
         }
 
         /**
      * @brief 原点中心に指定した角度だけ回転させたgeometry_msgs::Vector3型のメッセージを返す
      * @param vector3: geometry_msgs::Vector3
-     * @param angle: 回転角度[rad/s]
+     * @param angle: 回転角度[rad]
      * @return 原点中心に指定した角度だけ回転させたgeometry_msgs::Vector3型のメッセージ
     **/
-        static geometry_msgs::Vector3 rotate(geometry_msgs::Vector3 vector3, double angle)
+        static geometry_msgs::Vector3 rotate(const geometry_msgs::Vector3 &vector3, double angle)
         {
-            geometry_msgs::Vector3 reutrn_vector3;
-            reutrn_vector3.x = vector3.x * std::cos(angle) - vector3.y * std::sin(angle);
-            reutrn_vector3.y = vector3.x * std::sin(angle) + vector3.y * std::cos(angle);
-            reutrn_vector3.z = vector3.z;
-            return reutrn_vector3;
+            return rotate(vector3, Rotation2D<double>(angle));
+        }
+
+        /**
+     * @brief 原点中心に回転させたgeometry_msgs::Vector3型のメッセージを返す
+     * @param vector3: geometry_msgs::Vector3
+     * @param rotation: 回転
+     * @return 原点中心に回転させたgeometry_msgs::Vector3型のメッセージ
+    **/
+        static geometry_msgs::Vector3 rotate(const geometry_msgs::Vector3 &vector3, const Rotation2D<double> &rotation)
+        {
+            geometry_msgs::Vector3 return_vector3 = vector3;
+            rotateInPlace(return_vector3, rotation);
+            return return_vector3;
         }
 
         /**
      * @brief 原点中心に指定した角度だけ回転させたgeometry_msgs::Twist型のメッセージを返す
-     * @param vector3: geometry_msgs::Twist
-     * @param angle: 回転角度[rad/s]
+     * @param twist: geometry_msgs::Twist
+     * @param angle: 回転角度[rad]
      * @return 原点中心に指定した角度だけ回転させたgeometry_msgs::Twist型のメッセージ
     **/
-        static geometry_msgs::Twist rotate(geometry_msgs::Twist twist, double angle)
+        static geometry_msgs::Twist rotate(const geometry_msgs::Twist &twist, double angle)
         {
-            twist.linear = rotate(twist.linear, angle);
-            return twist;
+            return rotate(twist, Rotation2D<double>(angle));
+        }
+
+        /**
+     * @brief 原点中心に回転させたgeometry_msgs::Twist型のメッセージを返す
+     * @param twist: geometry_msgs::Twist
+     * @param rotation: 回転
+     * @return 原点中心に回転させたgeometry_msgs::Twist型のメッセージ
+    **/
+        static geometry_msgs::Twist rotate(const geometry_msgs::Twist &twist, const Rotation2D<double> &rotation)
+        {
+            geometry_msgs::Twist return_twist = twist;
+            rotateInPlace(return_twist, rotation);
+            return return_twist;
         }
 
         /**
      * @brief 原点中心に指定した角度だけ回転させたgeometry_msgs::Accel型のメッセージを返す
-     * @param vector3: geometry_msgs::Accel
-     * @param angle: 回転角度[rad/s]
+     * @param accel: geometry_msgs::Accel
+     * @param angle: 回転角度[rad]
      * @return 原点中心に指定した角度だけ回転させたgeometry_msgs::Accel型のメッセージ
     **/
-        static geometry_msgs::Accel rotate(geometry_msgs::Accel accel, double angle)
+        static geometry_msgs::Accel rotate(const geometry_msgs::Accel &accel, double angle)
         {
-            accel.linear = rotate(accel.linear, angle);
-            return accel;
+            return rotate(accel, Rotation2D<double>(angle));
+        }
+
+        /**
+     * @brief 原点中心に回転させたgeometry_msgs::Accel型のメッセージを返す
+     * @param accel: geometry_msgs::Accel
+     * @param rotation: 回転
+     * @return 原点中心に回転させたgeometry_msgs::Accel型のメッセージ
+    **/
+        static geometry_msgs::Accel rotate(const geometry_msgs::Accel &accel, const Rotation2D<double> &rotation)
+        {
+            geometry_msgs::Accel return_accel = accel;
+            rotateInPlace(return_accel, rotation);
+            return return_accel;
+        }
+
+        ///////////////// rotateInPlace（既存のメッセージを直接回転させる） /////////////////
+        /**
+     * @brief geometry_msgs::Point型のメッセージを原点中心に直接回転させる
+     * @param point: 回転させるメッセージ
+     * @param rotation: 回転
+    **/
+        static void rotateInPlace(geometry_msgs::Point &point, const Rotation2D<double> &rotation)
+        {
+            rotation.apply(point.x, point.y);
+        }
+
+        /**
+     * @brief geometry_msgs::Point32型のメッセージを原点中心に直接回転させる
+     * @param point32: 回転させるメッセージ
+     * @param rotation: 回転
+    **/
+        static void rotateInPlace(geometry_msgs::Point32 &point32, const Rotation2D<float> &rotation)
+        {
+            rotation.apply(point32.x, point32.y);
+        }
+
+        /**
+     * @brief geometry_msgs::Pose型のメッセージの位置を原点中心に直接回転させる
+     * @details 既存の実装に合わせ，方向成分は回転させない
+     * @param pose: 回転させるメッセージ
+     * @param rotation: 回転
+    **/
+        static void rotateInPlace(geometry_msgs::Pose &pose, const Rotation2D<double> &rotation)
+        {
+            rotateInPlace(pose.position, rotation);
+        }
+
+        /**
+     * @brief geometry_msgs::PoseStamped型のメッセージの位置を原点中心に直接回転させる
+     * @param pose_stamped: 回転させるメッセージ
+     * @param rotation: 回転
+    **/
+        static void rotateInPlace(geometry_msgs::PoseStamped &pose_stamped, const Rotation2D<double> &rotation)
+        {
+            rotateInPlace(pose_stamped.pose, rotation);
+        }
+
+        /**
+     * @brief geometry_msgs::Vector3型のメッセージを原点中心に直接回転させる
+     * @param vector3: 回転させるメッセージ
+     * @param rotation: 回転
+    **/
+        static void rotateInPlace(geometry_msgs::Vector3 &vector3, const Rotation2D<double> &rotation)
+        {
+            rotation.apply(vector3.x, vector3.y);
+        }
+
+        /**
+     * @brief geometry_msgs::Twist型のメッセージの並進速度を原点中心に直接回転させる
+     * @param twist: 回転させるメッセージ
+     * @param rotation: 回転
+    **/
+        static void rotateInPlace(geometry_msgs::Twist &twist, const Rotation2D<double> &rotation)
+        {
+            rotateInPlace(twist.linear, rotation);
+        }
+
+        /**
+     * @brief geometry_msgs::Accel型のメッセージの並進加速度を原点中心に直接回転させる
+     * @param accel: 回転させるメッセージ
+     * @param rotation: 回転
+    **/
+        static void rotateInPlace(geometry_msgs::Accel &accel, const Rotation2D<double> &rotation)
+        {
+            rotateInPlace(accel.linear, rotation);
         }
     };
 }
@@ -0,0 +1,180 @@
+/**
+ * @file msg_pool.h
+ * @brief intra-process通信でpublishするメッセージを使い回すためのプール
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+
+#include <mutex>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace nut_ros {
+
+/**
+ * @brief intra-process通信でpublishするメッセージを使い回すためのプール
+ * @details nodeletなどのintra-process通信ではboost::shared_ptrでpublishするとシリアライズもコピーも発生しない
+ *          acquire()は購読側が手放した（プール以外から参照されていない）メッセージを再利用して返すため，
+ *          プールが温まった後はメッセージの確保が発生しない
+ *          返されるメッセージには前回の内容が残っているので，MsgGenerator::fill()などで上書きして使用する
+ *          （vectorの確保済み領域やframe_idの文字列もそのまま再利用される）
+ * @attention publishしたメッセージは購読側から参照されている間は書き換えてはならない
+ *            （acquire()はそのようなメッセージを返さないので，毎回acquire()し直せばよい）
+ * @code
+ * nut_ros::MsgPool<nav_msgs::Path> pool;
+ * boost::shared_ptr<nav_msgs::Path> path = pool.acquire();
+ * nut_ros::MsgGenerator::fill(*path, header, pose_2d_array);
+ * publisher.publish(path);
+ * @endcode
+**/
+template <typename Msg>
+class MsgPool
+{
+public:
+    using msg_ptr = boost::shared_ptr<Msg>;
+
+    /**
+     * @brief コンストラクタ
+     * @param capacity: プールに保持するメッセージの最大数（購読側のキュー長より大きくする）
+     * @param preallocate: 最初に確保しておくメッセージの数
+     */
+    explicit MsgPool(const size_t capacity = 8, const size_t preallocate = 0)
+        : _capacity(capacity)
+    {
+        _pool.reserve(capacity);
+        for (size_t i = 0; i < preallocate && i < capacity; ++i)
+            _pool.push_back(boost::make_shared<Msg>());
+    }
+
+    MsgPool(const MsgPool &) = delete;
+    MsgPool &operator=(const MsgPool &) = delete;
+
+    /**
+     * @brief 再利用可能なメッセージを取得する
+     * @details プール以外から参照されていないメッセージがあればそれを返す（ヒット）
+     *          なければ新しく確保し，容量に空きがあればプールに加える（ミス）
+     * @return メッセージ（前回の内容が残っている場合がある）
+     */
+    msg_ptr acquire()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const size_t size = _pool.size();
+        for (size_t k = 0; k < size; ++k)
+        {
+            // 前回返したものの次から探すことで，直前にpublishしたものを避ける
+            const size_t i = (_next + k) % size;
+            // 参照しているのがプールのみであれば，購読側は既に手放している
+            if (_pool[i].use_count() == 1)
+            {
+                _next = (i + 1) % size;
+                ++_hit_count;
+                return _pool[i];
+            }
+        }
+
+        ++_miss_count;
+        msg_ptr msg = boost::make_shared<Msg>();
+        if (size < _capacity)
+        {
+            _pool.push_back(msg);
+            _next = 0;
+        }
+        return msg;
+    }
+
+    /**
+     * @brief プールに保持しているメッセージの数を返す
+     * @return メッセージの数
+     */
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _pool.size();
+    }
+
+    /**
+     * @brief プールに保持できるメッセージの最大数を返す
+     * @return 最大数
+     */
+    size_t getCapacity() const
+    {
+        return _capacity;
+    }
+
+    /**
+     * @brief プール内でpublish中（プール以外から参照されている）のメッセージの数を返す
+     * @return メッセージの数
+     */
+    size_t getInUseCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        size_t count = 0;
+        for (const msg_ptr &msg : _pool)
+            count += msg.use_count() > 1;
+        return count;
+    }
+
+    /**
+     * @brief 再利用できた回数を返す
+     * @return ヒット回数
+     */
+    uint64_t getHitCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _hit_count;
+    }
+
+    /**
+     * @brief 新しく確保した回数を返す
+     * @return ミス回数
+     */
+    uint64_t getMissCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _miss_count;
+    }
+
+    /**
+     * @brief ヒット率を返す
+     * @return ヒット率（0.0 to 1.0，一度もacquire()していない場合は0）
+     */
+    double getHitRate() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const uint64_t total = _hit_count + _miss_count;
+        return total > 0 ? (double)_hit_count / total : 0.0;
+    }
+
+    /**
+     * @brief ヒット・ミスの回数をリセットする
+     */
+    void resetCounters()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _hit_count = 0;
+        _miss_count = 0;
+    }
+
+    /**
+     * @brief プールを空にする
+     * @details publish中のメッセージは購読側が手放した時点で解放される
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pool.clear();
+        _next = 0;
+    }
+
+private:
+    mutable std::mutex _mutex;
+    std::vector<msg_ptr> _pool;
+    size_t _capacity;
+    size_t _next = 0;
+    uint64_t _hit_count = 0;
+    uint64_t _miss_count = 0;
+};
+}
@@ -0,0 +1,211 @@
+/**
+ * @file polygon_calculator.h
+ * @brief geometry_msgs::Polygon型に対する幾何計算
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./../vector/polygon_geometry.h"
+
+#include <geometry_msgs/Point.h>
+#include <geometry_msgs/Point32.h>
+#include <geometry_msgs/Polygon.h>
+
+namespace nut_ros {
+
+/**
+ * @brief geometry_msgs::Polygon型に対する幾何計算
+ * @details 計算はPolygonGeometry（vector/polygon_geometry.h）をpointsに直接適用して行うため，独自の型への変換は発生しない
+**/
+class PolygonCalculator{
+private:
+public:
+
+    /**
+     * @brief 点がポリゴンの内部にあるかどうか
+     * @param polygon: geometry_msgs::Polygon型
+     * @param point: geometry_msgs::Point32型
+     * @return 内部にあるかどうか
+    **/
+    static bool isPointInside(const geometry_msgs::Polygon &polygon, const geometry_msgs::Point32 &point)
+    {
+        return PolygonGeometry::isPointInside(polygon.points, point.x, point.y);
+    }
+
+    /**
+     * @brief 点がポリゴンの内部にあるかどうか
+     * @param polygon: geometry_msgs::Polygon型
+     * @param point: geometry_msgs::Point型
+     * @return 内部にあるかどうか
+    **/
+    static bool isPointInside(const geometry_msgs::Polygon &polygon, const geometry_msgs::Point &point)
+    {
+        return PolygonGeometry::isPointInside(polygon.points, point.x, point.y);
+    }
+
+    /**
+     * @brief 点がポリゴンの内部にあるかどうか
+     * @param polygon: geometry_msgs::Polygon型
+     * @param pose: nut_ros::Pose2D
+     * @return 内部にあるかどうか
+    **/
+    template <typename T>
+    static bool isPointInside(const geometry_msgs::Polygon &polygon, const Pose2D<T> &pose)
+    {
+        return PolygonGeometry::isPointInside(polygon.points, pose);
+    }
+
+    /**
+     * @brief 多数の点がポリゴンの内部にあるかどうかを一括判定
+     * @param polygon: geometry_msgs::Polygon型
+     * @param points: 点群
+     * @param out: 各点の判定結果（1: 内部, 0: 外部）
+     * @return 内部にある点の数
+    **/
+    template <typename T>
+    static size_t isPointInside(const geometry_msgs::Polygon &polygon, const Vector2Array<T> &points, std::vector<uint8_t> &out)
+    {
+        return PolygonGeometry::isPointInside(polygon.points, points, out);
+    }
+
+    /**
+     * @brief 点群のいずれかがポリゴンの内部にあるかどうか
+     * @param polygon: geometry_msgs::Polygon型
+     * @param points: 点群
+     * @return 内部にある点が1つでもあるかどうか
+    **/
+    template <typename T>
+    static bool isAnyPointInside(const geometry_msgs::Polygon &polygon, const Vector2Array<T> &points)
+    {
+        return PolygonGeometry::isAnyPointInside(polygon.points, points);
+    }
+
+    /**
+     * @brief 2つの凸ポリゴンが重なっているかどうか
+     * @param polygon1: geometry_msgs::Polygon型（凸）
+     * @param polygon2: geometry_msgs::Polygon型（凸）
+     * @return 重なっているかどうか
+    **/
+    static bool isOverlapping(const geometry_msgs::Polygon &polygon1, const geometry_msgs::Polygon &polygon2)
+    {
+        return PolygonGeometry::isOverlapping(polygon1.points, polygon2.points);
+    }
+
+    /**
+     * @brief 1つの凸ポリゴンと多数の凸ポリゴンとの重なりを一括判定
+     * @param polygon: geometry_msgs::Polygon型（凸）
+     * @param others: geometry_msgs::Polygon型（凸）の配列
+     * @param out: 各ポリゴンの判定結果（1: 重なっている, 0: 重なっていない）
+     * @return 重なっているポリゴンの数
+    **/
+    static size_t isOverlapping(const geometry_msgs::Polygon &polygon, const std::vector<geometry_msgs::Polygon> &others, std::vector<uint8_t> &out)
+    {
+        out.assign(others.size(), 0);
+        double min_x, min_y, max_x, max_y;
+        if (!PolygonGeometry::getBounds(polygon.points, min_x, min_y, max_x, max_y))
+            return 0;
+        size_t count = 0;
+        for (size_t i = 0; i < others.size(); ++i)
+        {
+            // 外接矩形が重ならないものは分離軸を調べずに除外する
+            double bmin_x, bmin_y, bmax_x, bmax_y;
+            if (!PolygonGeometry::getBounds(others[i].points, bmin_x, bmin_y, bmax_x, bmax_y) ||
+                bmax_x < min_x || max_x < bmin_x || bmax_y < min_y || max_y < bmin_y)
+                continue;
+            out[i] = PolygonGeometry::isOverlapping(polygon.points, others[i].points);
+            count += out[i];
+        }
+        return count;
+    }
+
+    /**
+     * @brief 線分とポリゴンが重なっているかどうか
+     * @param polygon: geometry_msgs::Polygon型
+     * @param line: nut_ros::Line2D
+     * @return 重なっているかどうか
+    **/
+    template <typename T>
+    static bool isOverlapping(const geometry_msgs::Polygon &polygon, const Line2D<T> &line)
+    {
+        return PolygonGeometry::isOverlapping(polygon.points, line);
+    }
+
+    /**
+     * @brief 多数の線分とポリゴンとの重なりを一括判定
+     * @param polygon: geometry_msgs::Polygon型
+     * @param lines: nut_ros::Line2Dの配列
+     * @param out: 各線分の判定結果（1: 重なっている, 0: 重なっていない）
+     * @return 重なっている線分の数
+    **/
+    template <typename T>
+    static size_t isOverlapping(const geometry_msgs::Polygon &polygon, const std::vector<Line2D<T>> &lines, std::vector<uint8_t> &out)
+    {
+        return PolygonGeometry::isOverlapping(polygon.points, lines, out);
+    }
+
+    /**
+     * @brief ポリゴンの面積を取得
+     * @param polygon: geometry_msgs::Polygon型
+     * @return 面積[m^2]
+    **/
+    static double getArea(const geometry_msgs::Polygon &polygon)
+    {
+        return PolygonGeometry::getArea(polygon.points);
+    }
+
+    /**
+     * @brief ポリゴンの重心を取得
+     * @param polygon: geometry_msgs::Polygon型
+     * @return 重心
+    **/
+    static geometry_msgs::Point32 getCentroid(const geometry_msgs::Polygon &polygon)
+    {
+        const Vector2<double> c = PolygonGeometry::getCentroid(polygon.points);
+        geometry_msgs::Point32 point;
+        point.x = (float)c.x;
+        point.y = (float)c.y;
+        point.z = 0.0;
+        return point;
+    }
+
+    /**
+     * @brief 点群の凸包をポリゴンとして取得
+     * @param points: 点群（geometry_msgs::Point32, geometry_msgs::Point, nut_ros::Vector2などの配列，またはnut_ros::Vector2Array）
+     * @return 凸包（反時計回り）
+    **/
+    template <typename Points>
+    static geometry_msgs::Polygon getConvexHull(const Points &points)
+    {
+        geometry_msgs::Polygon hull;
+        PolygonGeometry::getConvexHull(points, hull.points);
+        return hull;
+    }
+
+    /**
+     * @brief 2つの凸ポリゴンのミンコフスキー和を取得
+     * @param polygon1: geometry_msgs::Polygon型（凸）
+     * @param polygon2: geometry_msgs::Polygon型（凸）
+     * @return ミンコフスキー和（反時計回り）
+    **/
+    static geometry_msgs::Polygon getMinkowskiSum(const geometry_msgs::Polygon &polygon1, const geometry_msgs::Polygon &polygon2)
+    {
+        geometry_msgs::Polygon sum;
+        PolygonGeometry::getMinkowskiSum(polygon1.points, polygon2.points, sum.points);
+        return sum;
+    }
+
+    /**
+     * @brief 凸ポリゴン（フットプリントなど）を指定距離だけ膨張させたポリゴンを取得
+     * @param polygon: geometry_msgs::Polygon型（凸）
+     * @param radius: 膨張させる距離[m]
+     * @param resolution: 円を近似する頂点数（デフォルト:16）
+     * @return 膨張後のポリゴン（反時計回り）
+    **/
+    static geometry_msgs::Polygon inflate(const geometry_msgs::Polygon &polygon, double radius, int resolution = 16)
+    {
+        geometry_msgs::Polygon inflated;
+        PolygonGeometry::inflate(polygon.points, radius, inflated.points, resolution);
+        return inflated;
+    }
+};
+}
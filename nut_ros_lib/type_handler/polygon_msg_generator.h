@@ -6,31 +6,89 @@
 **/
 #pragma once
 
-#include "./../nut_generic.h"
+#include "./../nut_generic_core.h"
 #include "./msg_generator.h"
+#include "./../vector/vector2_array.h"
+
+#include <geometry_msgs/Point32.h>
+#include <geometry_msgs/Polygon.h>
+#include <map>
 
 namespace nut_ros {
 
 /**
  * @brief さまざまな図形のgeometry_msgs::Polygon型を簡単に生成できるようにする
+ * @details to~()は新しいメッセージを返し，fill~()は引数のメッセージに上書きする（確保済みの領域を再利用する）
+ *          楕円，円の単位図形（cos, sin）は頂点数毎にスレッド毎にキャッシュされる
 **/
 class PolygonMsgGenerator{
 private:
+    // 頂点数毎の単位円の頂点（cos, sin）をスレッド毎にキャッシュする
+    static const std::vector<std::array<double, 2>> &getUnitCircle(const int resolution)
+    {
+        thread_local std::map<int, std::vector<std::array<double, 2>>> cache;
+        auto it = cache.find(resolution);
+        if (it == cache.end())
+        {
+            std::vector<std::array<double, 2>> vertices(resolution > 0 ? resolution : 0);
+            for (int i = 0; i < resolution; ++i)
+                vertices[i] = {std::cos(i * 2*M_PI / (float)resolution), std::sin(i * 2*M_PI / (float)resolution)};
+            it = cache.emplace(resolution, std::move(vertices)).first;
+        }
+        return it->second;
+    }
+
+    static inline void setPoint32(geometry_msgs::Point32 &point, float x, float y)
+    {
+        point.x = x;
+        point.y = y;
+        point.z = 0.0;
+    }
+
 public:
 
+    /**
+     * @brief ポリゴンをその場で指定座標だけ平行移動
+     * @param polygon: 平行移動するポリゴン（入出力）
+     * @param x: x座標[m]
+     * @param y: y座標[m]
+    **/
+    static void translate(geometry_msgs::Polygon &polygon, float x, float y)
+    {
+        for (auto &point : polygon.points)
+        {
+            point.x += x;
+            point.y += y;
+            point.z = 0.0;
+        }
+    }
+
     /**
      * @brief 指定座標だけ平行移動したポリゴンを生成
+     * @param polygon: 元のポリゴン
      * @param x: x座標[m]
      * @param y: y座標[m]
-     * @param width: 幅[m]
-     * @param height: 高さ[m]
      * @return geometry_msgs::Polygon型のメッセージ
     **/
-    static geometry_msgs::Polygon translation(geometry_msgs::Polygon polygon, float x, float y)
+    static geometry_msgs::Polygon translation(const geometry_msgs::Polygon &polygon, float x, float y)
     {
-        for (int i = 0; i < polygon.points.size(); ++i)
-            polygon.points[i] = MsgGenerator::toPoint32(polygon.points[i].x + x, polygon.points[i].y + y, 0.0);
-        return polygon;
+        geometry_msgs::Polygon result;
+        result.points.resize(polygon.points.size());
+        for (size_t i = 0; i < polygon.points.size(); ++i)
+            setPoint32(result.points[i], polygon.points[i].x + x, polygon.points[i].y + y);
+        return result;
+    }
+
+    /**
+     * @brief std::vector<std::vector<float>>で定義されるポイントリストでgeometry_msgs::Polygon型のメッセージを上書き
+     * @param polygon: 出力先
+     * @param std_vector: std::vector<std::vector<float>>で定義されるポイントリスト
+    **/
+    static void fillFromVector(geometry_msgs::Polygon &polygon, const std::vector<std::vector<float>> &std_vector)
+    {
+        polygon.points.resize(std_vector.size());
+        for (size_t i = 0; i < std_vector.size(); ++i)
+            setPoint32(polygon.points[i], std_vector[i][0], std_vector[i][1]);
     }
 
     /**
@@ -38,14 +96,54 @@ public:
      * @param std_vector: std::vector<std::vector<float>>で定義されるポイントリスト
      * @return geometry_msgs::Polygon型のメッセージ
     **/
-    static geometry_msgs::Polygon fromVector(std::vector<std::vector<float>> std_vector)
+    static geometry_msgs::Polygon fromVector(const std::vector<std::vector<float>> &std_vector)
     {
         geometry_msgs::Polygon polygon;
-        for (int i = 0; i < std_vector.size(); ++i)
-            polygon.points.push_back(MsgGenerator::toPoint32(std_vector[i][0], std_vector[i][1], 0.0));
+        fillFromVector(polygon, std_vector);
         return polygon;
     }
 
+    /**
+     * @brief nut_ros::Vector2Arrayで定義されるポイントリストでgeometry_msgs::Polygon型のメッセージを上書き
+     * @param polygon: 出力先
+     * @param vector2_array: nut_ros::Vector2Arrayで定義されるポイントリスト
+    **/
+    template <typename T>
+    static void fillFromVector2Array(geometry_msgs::Polygon &polygon, const Vector2Array<T> &vector2_array)
+    {
+        polygon.points.resize(vector2_array.size());
+        for (size_t i = 0; i < vector2_array.size(); ++i)
+            setPoint32(polygon.points[i], (float)vector2_array.x[i], (float)vector2_array.y[i]);
+    }
+
+    /**
+     * @brief nut_ros::Vector2Arrayで定義されるポイントリストからgeometry_msgs::Polygon型のメッセージを生成
+     * @param vector2_array: nut_ros::Vector2Arrayで定義されるポイントリスト
+     * @return geometry_msgs::Polygon型のメッセージ
+    **/
+    template <typename T>
+    static geometry_msgs::Polygon fromVector2Array(const Vector2Array<T> &vector2_array)
+    {
+        geometry_msgs::Polygon polygon;
+        fillFromVector2Array(polygon, vector2_array);
+        return polygon;
+    }
+
+    /**
+     * @brief 始点と終点の座標を指定して直線でgeometry_msgs::Polygon型のメッセージを上書き
+     * @param polygon: 出力先
+     * @param x1: 始点のx座標[m]
+     * @param y1: 始点のy座標[m]
+     * @param x2: 終点のx座標[m]
+     * @param y2: 終点のy座標[m]
+    **/
+    static void fillLine(geometry_msgs::Polygon &polygon, float x1, float y1, float x2, float y2)
+    {
+        polygon.points.resize(2);
+        setPoint32(polygon.points[0], x1, y1);
+        setPoint32(polygon.points[1], x2, y2);
+    }
+
     /**
      * @brief 始点と終点の座標を指定して直線を生成
      * @param x1: 始点のx座標[m]
@@ -57,11 +155,28 @@ public:
     static geometry_msgs::Polygon toLine(float x1, float y1, float x2, float y2)
     {
         geometry_msgs::Polygon polygon;
-        polygon.points.push_back(MsgGenerator::toPoint32(x1, y1, 0.0)); 
-        polygon.points.push_back(MsgGenerator::toPoint32(x2, y2, 0.0)); 
+        fillLine(polygon, x1, y1, x2, y2);
         return polygon;
     }
 
+    /**
+     * @brief 3点の座標を指定して三角形でgeometry_msgs::Polygon型のメッセージを上書き
+     * @param polygon: 出力先
+     * @param x1: 頂点1のx座標[m]
+     * @param y1: 頂点1のy座標[m]
+     * @param x2: 頂点2のx座標[m]
+     * @param y2: 頂点2のy座標[m]
+     * @param x3: 頂点3のx座標[m]
+     * @param y3: 頂点3のy座標[m]
+    **/
+    static void fillTriangle(geometry_msgs::Polygon &polygon, float x1, float y1, float x2, float y2, float x3, float y3)
+    {
+        polygon.points.resize(3);
+        setPoint32(polygon.points[0], x1, y1);
+        setPoint32(polygon.points[1], x2, y2);
+        setPoint32(polygon.points[2], x3, y3);
+    }
+
     /**
      * @brief 3点の座標を指定して三角形を生成
      * @param x1: 頂点1のx座標[m]
@@ -75,12 +190,29 @@ public:
     static geometry_msgs::Polygon toTriangle(float x1, float y1, float x2, float y2, float x3, float y3)
     {
         geometry_msgs::Polygon polygon;
-        polygon.points.push_back(MsgGenerator::toPoint32(x1, y1, 0.0)); 
-        polygon.points.push_back(MsgGenerator::toPoint32(x2, y2, 0.0)); 
-        polygon.points.push_back(MsgGenerator::toPoint32(x3, y3, 0.0)); 
+        fillTriangle(polygon, x1, y1, x2, y2, x3, y3);
         return polygon;
     }
 
+    /**
+     * @brief 中心座標，幅，高さを指定して長方形でgeometry_msgs::Polygon型のメッセージを上書き
+     * @param polygon: 出力先
+     * @param x: x座標[m]
+     * @param y: y座標[m]
+     * @param width: 幅[m]
+     * @param height: 高さ[m]
+    **/
+    static void fillRect(geometry_msgs::Polygon &polygon, float x, float y, float width, float height)
+    {
+        const float half_w = width/2.0;
+        const float half_h = height/2.0;
+        polygon.points.resize(4);
+        setPoint32(polygon.points[0],  half_w + x,  half_h + y);
+        setPoint32(polygon.points[1], -half_w + x,  half_h + y);
+        setPoint32(polygon.points[2], -half_w + x, -half_h + y);
+        setPoint32(polygon.points[3],  half_w + x, -half_h + y);
+    }
+
     /**
      * @brief 中心座標，幅，高さを指定して長方形を生成
      * @param x: x座標[m]
@@ -92,16 +224,33 @@ public:
     static geometry_msgs::Polygon toRect(float x, float y, float width, float height)
     {
         geometry_msgs::Polygon polygon;
-        polygon.points.push_back(MsgGenerator::toPoint32( width/2.0,  height/2.0, 0.0));
-        polygon.points.push_back(MsgGenerator::toPoint32(-width/2.0,  height/2.0, 0.0));
-        polygon.points.push_back(MsgGenerator::toPoint32(-width/2.0, -height/2.0, 0.0));
-        polygon.points.push_back(MsgGenerator::toPoint32( width/2.0, -height/2.0, 0.0));
-        polygon = translation(polygon, x, y);
+        fillRect(polygon, x, y, width, height);
         return polygon;
     }
 
     /**
-     * @brief 3点の座標を指定して四角形を生成
+     * @brief 4点の座標を指定して四角形でgeometry_msgs::Polygon型のメッセージを上書き
+     * @param polygon: 出力先
+     * @param x1: 頂点1のx座標[m]
+     * @param y1: 頂点1のy座標[m]
+     * @param x2: 頂点2のx座標[m]
+     * @param y2: 頂点2のy座標[m]
+     * @param x3: 頂点3のx座標[m]
+     * @param y3: 頂点3のy座標[m]
+     * @param x4: 頂点4のx座標[m]
+     * @param y4: 頂点4のy座標[m]
+    **/
+    static void fillQuad(geometry_msgs::Polygon &polygon, float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4)
+    {
+        polygon.points.resize(4);
+        setPoint32(polygon.points[0], x1, y1);
+        setPoint32(polygon.points[1], x2, y2);
+        setPoint32(polygon.points[2], x3, y3);
+        setPoint32(polygon.points[3], x4, y4);
+    }
+
+    /**
+     * @brief 4点の座標を指定して四角形を生成
      * @param x1: 頂点1のx座標[m]
      * @param y1: 頂点1のy座標[m]
      * @param x2: 頂点2のx座標[m]
@@ -115,13 +264,30 @@ public:
     static geometry_msgs::Polygon toQuad(float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4)
     {
         geometry_msgs::Polygon polygon;
-        polygon.points.push_back(MsgGenerator::toPoint32(x1, y1, 0.0)); 
-        polygon.points.push_back(MsgGenerator::toPoint32(x2, y2, 0.0)); 
-        polygon.points.push_back(MsgGenerator::toPoint32(x3, y3, 0.0)); 
-        polygon.points.push_back(MsgGenerator::toPoint32(x4, y4, 0.0)); 
+        fillQuad(polygon, x1, y1, x2, y2, x3, y3, x4, y4);
         return polygon;
     }
 
+    /**
+     * @brief 中心座標，幅，高さを指定して楕円でgeometry_msgs::Polygon型のメッセージを上書き
+     * @param polygon: 出力先
+     * @param x: x座標[m]
+     * @param y: y座標[m]
+     * @param width: 幅[m]
+     * @param height: 高さ[m]
+     * @param resolution: 頂点数（デフォルト:16）
+    **/
+    static void fillEllipse(geometry_msgs::Polygon &polygon, float x, float y, float width, float height, const int resolution = 16)
+    {
+        const std::vector<std::array<double, 2>> &unit = getUnitCircle(resolution);
+        polygon.points.resize(unit.size());
+        for (size_t i = 0; i < unit.size(); ++i)
+        {
+            const float px = width/2  * unit[i][0];
+            const float py = height/2 * unit[i][1];
+            setPoint32(polygon.points[i], px + x, py + y);
+        }
+    }
 
     /**
      * @brief 中心座標，幅，高さを指定して楕円を生成
@@ -135,15 +301,23 @@ public:
     static geometry_msgs::Polygon toEllipse(float x, float y, float width, float height, const int resolution = 16)
     {
         geometry_msgs::Polygon polygon;
-        for (int i = 0; i < resolution; ++i) {
-            polygon.points.push_back(MsgGenerator::toPoint32(width/2  * std::cos(i * 2*M_PI / (float)resolution),
-                                                             height/2 * std::sin(i * 2*M_PI / (float)resolution),
-                                                             0.0));
-        }
-        polygon = translation(polygon, x, y);
+        fillEllipse(polygon, x, y, width, height, resolution);
         return polygon;
     }
 
+    /**
+     * @brief 中心座標，半径を指定して円でgeometry_msgs::Polygon型のメッセージを上書き
+     * @param polygon: 出力先
+     * @param x: x座標[m]
+     * @param y: y座標[m]
+     * @param r: 半径[m]
+     * @param resolution: 頂点数（デフォルト:16）
+    **/
+    static void fillCircle(geometry_msgs::Polygon &polygon, float x, float y, float r, const int resolution = 16)
+    {
+        fillEllipse(polygon, x, y, r*2.0, r*2.0, resolution);
+    }
+
     /**
      * @brief 中心座標，半径を指定して円を生成
      * @param x: x座標[m]
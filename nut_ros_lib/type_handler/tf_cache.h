@@ -0,0 +1,358 @@
+/**
+ * @file tf_cache.h
+ * @brief 登録したフレーム間の座標関係をキャッシュし待ち時間なしで取得できるようにする
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./../angles/angles.h"
+#include "./../vector/pose_2D.h"
+#include "./msg_decoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+#include <ros/ros.h>
+
+#include <geometry_msgs/TransformStamped.h>
+
+#include <tf2_ros/buffer.h>
+#include <tf2_ros/transform_listener.h>
+
+namespace nut_ros {
+
+/**
+ * @brief 登録したフレーム間の座標関係をキャッシュし待ち時間なしで取得できるようにする
+ * @details registerFrame()で登録したフレームの組をupdate()（またはstart()で起動したタイマ）で更新し，
+ *          制御ループからはロックも待ちもなくgetPose2D()で取得できる
+ *          書き込み側はリングバッファの次の位置にサンプルを書いてから書き込み回数を公開するため，読み出し側は書き込み中の位置を読まず，
+ *          更新の完了を待つこともない（読み出し中にHISTORY_SIZE - 1回以上更新された場合のみ読み直す）
+ *          getPose2D(id)とgetStamp()は最新のサンプルのみを読む
+**/
+class TfCache
+{
+public:
+    static constexpr size_t HISTORY_SIZE = 16; /**< 補間用に保持する1組あたりのサンプル数 */
+
+    /**
+     * @brief コンストラクタ
+     * @param capacity: 登録できるフレームの組の最大数
+     */
+    explicit TfCache(const size_t capacity = 32)
+        : _tf_listener(_tf_buffer), _entries(new entry_t[capacity]), _capacity(capacity), _size(0) {}
+
+    TfCache(const TfCache &) = delete;
+    TfCache &operator=(const TfCache &) = delete;
+
+    /**
+     * @brief フレームの組を登録する
+     * @param parent_frame: 親フレームのID
+     * @param child_frame: 子フレームのID
+     * @return 取得時に使用するID（登録済みの場合は既存のID，容量超過時は-1）
+     */
+    int registerFrame(const std::string &parent_frame, const std::string &child_frame)
+    {
+        std::lock_guard<std::mutex> lock(_register_mutex);
+        const size_t size = _size.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (_entries[i].parent_frame == parent_frame && _entries[i].child_frame == child_frame)
+                return (int)i;
+        }
+        if (size >= _capacity)
+            return -1;
+
+        _entries[size].parent_frame = parent_frame;
+        _entries[size].child_frame = child_frame;
+        _size.store(size + 1, std::memory_order_release);
+        return (int)size;
+    }
+
+    /**
+     * @brief 一定周期でupdate()を呼び出すタイマを起動する
+     * @param nh: タイマを生成するノードハンドル
+     * @param rate: 更新周期[Hz]
+     */
+    void start(ros::NodeHandle &nh, const double rate)
+    {
+        _timer = nh.createTimer(ros::Duration(1.0 / rate), &TfCache::timerCallback, this);
+    }
+
+    /**
+     * @brief 登録済みの全てのフレームの組を最新のTFで更新する
+     * @details TFバッファを待ち時間なしで参照し，新しいデータがあるときのみキャッシュに追加する
+     */
+    void update()
+    {
+        std::lock_guard<std::mutex> lock(_register_mutex);
+        const size_t size = _size.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < size; ++i)
+            updateEntry(_entries[i]);
+    }
+
+    /**
+     * @brief 指定したフレームの組のみを最新のTFで更新する
+     * @param id: registerFrame()で取得したID
+     */
+    void update(const int id)
+    {
+        if (!isValidId(id))
+            return;
+        std::lock_guard<std::mutex> lock(_register_mutex);
+        updateEntry(_entries[id]);
+    }
+
+    /**
+     * @brief 指定したフレームの組を，TFが届くまで最大timeoutだけ待って更新する
+     * @details 起動時の初期化など，制御ループ外で最初の値を待つ場合に使用する
+     * @param id: registerFrame()で取得したID
+     * @param timeout: 最大の待ち時間
+     * @return 一度でも受信しているか
+     * @attention 待ち時間が発生するため制御ループ内では使用しないこと
+     */
+    bool update(const int id, const ros::Duration &timeout)
+    {
+        if (!isValidId(id))
+            return false;
+        entry_t &entry = _entries[id];
+        geometry_msgs::TransformStamped tf;
+        try
+        {
+            tf = _tf_buffer.lookupTransform(entry.parent_frame, entry.child_frame, ros::Time(0), timeout);
+        }
+        catch (tf2::TransformException &)
+        {
+            return entry.count.load(std::memory_order_acquire) > 0;
+        }
+        std::lock_guard<std::mutex> lock(_register_mutex);
+        addSample(entry, tf);
+        return true;
+    }
+
+    /**
+     * @brief 最新の座標関係をPose2D型のデータで取得する（待ち時間なし）
+     * @param id: registerFrame()で取得したID
+     * @return 一度でも受信しているか, Pose2D型の座標関係データ
+     */
+    std::tuple<bool, Pose2D<double>> getPose2D(const int id) const
+    {
+        sample_t latest;
+        if (!isValidId(id) || !readLatest(_entries[id], latest))
+            return std::forward_as_tuple(false, Pose2D<double>(0, 0, 0));
+        return std::forward_as_tuple(true, latest.pose);
+    }
+
+    /**
+     * @brief TFバッファから最新の座標関係を待ち時間ありで取得する（キャッシュは使用しない）
+     * @details 登録できなかった（容量超過の）フレームの組や，まだ一度も受信していないフレームの組を取得する場合に使用する
+     * @param parent_frame: 親フレームのID
+     * @param child_frame: 子フレームのID
+     * @param timeout: 最大の待ち時間
+     * @return 取得できたか, Pose2D型の座標関係データ（取得できなかった場合は(0, 0, 0)）
+     */
+    std::tuple<bool, Pose2D<double>> lookupPose2D(const std::string &parent_frame, const std::string &child_frame, const ros::Duration &timeout) const
+    {
+        try
+        {
+            const geometry_msgs::TransformStamped tf = _tf_buffer.lookupTransform(parent_frame, child_frame, ros::Time(0), timeout);
+            return std::forward_as_tuple(true, Pose2D<double>(tf.transform.translation.x, tf.transform.translation.y, MsgDecoder::getYaw(tf.transform.rotation)));
+        }
+        catch (tf2::TransformException &)
+        {
+            return std::forward_as_tuple(false, Pose2D<double>(0, 0, 0));
+        }
+    }
+
+    /**
+     * @brief 指定時刻の座標関係を保持しているサンプル間で線形補間してPose2D型のデータで取得する（待ち時間なし）
+     * @param id: registerFrame()で取得したID
+     * @param stamp: 取得したい時刻
+     * @return 指定時刻が保持している範囲内か, Pose2D型の座標関係データ（範囲外の場合は最も近いサンプル）
+     */
+    std::tuple<bool, Pose2D<double>> getPose2D(const int id, const ros::Time &stamp) const
+    {
+        if (!isValidId(id))
+            return std::forward_as_tuple(false, Pose2D<double>(0, 0, 0));
+
+        const history_t history = readHistory(_entries[id]);
+        if (history.count == 0)
+            return std::forward_as_tuple(false, Pose2D<double>(0, 0, 0));
+
+        // 新しい順に並んでいるので指定時刻を挟む2点を探す
+        if (stamp > history.at(0).stamp)
+            return std::forward_as_tuple(false, history.at(0).pose);
+        for (size_t i = 1; i < history.count; ++i)
+        {
+            const sample_t &newer = history.at(i - 1);
+            const sample_t &older = history.at(i);
+            if (older.stamp <= stamp)
+            {
+                const double span = (newer.stamp - older.stamp).toSec();
+                const double t = (span > 0.0) ? (stamp - older.stamp).toSec() / span : 0.0;
+                Pose2D<double> pose;
+                pose.x = older.pose.x + (newer.pose.x - older.pose.x) * t;
+                pose.y = older.pose.y + (newer.pose.y - older.pose.y) * t;
+                pose.theta = Angles::normalize(older.pose.theta + Angles::getShortestAngle(older.pose.theta, newer.pose.theta) * t);
+                return std::forward_as_tuple(true, pose);
+            }
+        }
+        const sample_t &oldest = history.at(history.count - 1);
+        return std::forward_as_tuple(stamp == oldest.stamp, oldest.pose);
+    }
+
+    /**
+     * @brief 最新のデータのタイムスタンプを取得する
+     * @param id: registerFrame()で取得したID
+     * @return 最新のデータのタイムスタンプ（未受信の場合はros::Time(0)）
+     */
+    ros::Time getStamp(const int id) const
+    {
+        if (!isValidId(id))
+            return ros::Time();
+
+        sample_t latest;
+        return readLatest(_entries[id], latest) ? latest.stamp : ros::Time();
+    }
+
+    /**
+     * @brief 最新のデータがどれだけ古いかを取得する
+     * @param id: registerFrame()で取得したID
+     * @param now: 基準時刻（デフォルト: ros::Time::now()）
+     * @return 最新のデータの経過時間[sec]（未受信の場合は無限大）
+     */
+    double getAge(const int id, const ros::Time &now = ros::Time::now()) const
+    {
+        const ros::Time stamp = getStamp(id);
+        if (stamp.isZero())
+            return std::numeric_limits<double>::infinity();
+        return (now - stamp).toSec();
+    }
+
+private:
+    /**
+     * @brief タイムスタンプ付きの座標関係
+     */
+    struct sample_t
+    {
+        ros::Time stamp;
+        Pose2D<double> pose;
+    };
+
+    /**
+     * @brief 読み出し側が複製したサンプル履歴（新しい順）
+     */
+    struct history_t
+    {
+        std::array<sample_t, HISTORY_SIZE> samples;
+        size_t count = 0; // 有効なサンプル数
+
+        // 新しい順にi番目のサンプルを返す
+        const sample_t &at(const size_t i) const
+        {
+            return samples[i];
+        }
+    };
+
+    /**
+     * @brief 1組分のキャッシュ
+     * @details n回目（0始まり）のサンプルはsamples[n % HISTORY_SIZE]に書き込み，書き込み後にcountをn + 1にする
+     */
+    struct entry_t
+    {
+        std::string parent_frame;
+        std::string child_frame;
+        std::atomic<uint64_t> count{0}; // 書き込みが完了したサンプルの総数
+        std::array<sample_t, HISTORY_SIZE> samples;
+    };
+
+    tf2_ros::Buffer _tf_buffer;
+    tf2_ros::TransformListener _tf_listener;
+    ros::Timer _timer;
+
+    std::unique_ptr<entry_t[]> _entries;
+    const size_t _capacity;
+    std::atomic<size_t> _size;
+    std::mutex _register_mutex; // 登録と更新（書き込み側）の排他用．読み出し側は使用しない
+
+    bool isValidId(const int id) const
+    {
+        return id >= 0 && (size_t)id < _size.load(std::memory_order_acquire);
+    }
+
+    void timerCallback(const ros::TimerEvent &)
+    {
+        update();
+    }
+
+    void updateEntry(entry_t &entry)
+    {
+        if (!_tf_buffer.canTransform(entry.parent_frame, entry.child_frame, ros::Time(0)))
+            return;
+
+        geometry_msgs::TransformStamped tf;
+        try
+        {
+            tf = _tf_buffer.lookupTransform(entry.parent_frame, entry.child_frame, ros::Time(0));
+        }
+        catch (tf2::TransformException &)
+        {
+            return;
+        }
+        addSample(entry, tf);
+    }
+
+    // _register_mutexを保持して呼び出す（書き込み側は常に1つ）
+    void addSample(entry_t &entry, const geometry_msgs::TransformStamped &tf)
+    {
+        const uint64_t count = entry.count.load(std::memory_order_relaxed);
+        if (count > 0 && tf.header.stamp <= entry.samples[(count - 1) % HISTORY_SIZE].stamp)
+            return;
+
+        sample_t &sample = entry.samples[count % HISTORY_SIZE];
+        sample.stamp = tf.header.stamp;
+        sample.pose.x = tf.transform.translation.x;
+        sample.pose.y = tf.transform.translation.y;
+        sample.pose.theta = MsgDecoder::getYaw(tf.transform.rotation);
+        entry.count.store(count + 1, std::memory_order_release);
+    }
+
+    // 最新のサンプルのみを読み出す（未受信の場合はfalse）
+    static bool readLatest(const entry_t &entry, sample_t &latest)
+    {
+        while (true)
+        {
+            const uint64_t count = entry.count.load(std::memory_order_acquire);
+            if (count == 0)
+                return false;
+            latest = entry.samples[(count - 1) % HISTORY_SIZE];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // 読んだ位置はcount - 1 + HISTORY_SIZE回目のサンプルの書き込みで上書きされる
+            if (entry.count.load(std::memory_order_relaxed) < count - 1 + HISTORY_SIZE)
+                return true;
+        }
+    }
+
+    // 書き込み中の位置を除いた履歴を新しい順に複製し，複製中に上書きされた可能性のある古いサンプルを除く
+    static history_t readHistory(const entry_t &entry)
+    {
+        history_t history;
+        while (true)
+        {
+            const uint64_t count = entry.count.load(std::memory_order_acquire);
+            const size_t n = (size_t)std::min<uint64_t>(count, HISTORY_SIZE - 1);
+            for (size_t i = 0; i < n; ++i)
+                history.samples[i] = entry.samples[(count - 1 - i) % HISTORY_SIZE];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t after = entry.count.load(std::memory_order_relaxed);
+            // i番目（count - 1 - i回目）のサンプルはcount - 1 - i + HISTORY_SIZE回目の書き込みで上書きされる
+            const uint64_t valid = (count + HISTORY_SIZE - 1 > after) ? count + HISTORY_SIZE - 1 - after : 0;
+            history.count = (size_t)std::min<uint64_t>(n, valid);
+            if (history.count > 0 || count == 0)
+                return history;
+        }
+    }
+};
+}
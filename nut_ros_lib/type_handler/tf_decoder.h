@@ -6,7 +6,9 @@
 **/
 #pragma once
 
-#include "./../nut_generic.h"
+#include "./../nut_generic_core.h"
+#include "./../vector/pose_2D.h"
+#include "./tf_cache.h"
 
 namespace nut_ros {
 
@@ -14,31 +16,67 @@ namespace nut_ros {
  * @brief TFの中身を簡単に取り出せるようにする
 **/
 class TfDecoder{
-private:
 public:
+    static constexpr size_t CACHE_CAPACITY = 32; /**< getPose2DFromFrameId()でキャッシュするフレームの組の最大数 */
+
     /**
      * @brief フレームIDからTFを読み座標関係をPose2D型のデータで取得する
+     * @details 初回呼び出し時にフレームの組をTfCacheへ登録し，以降はその組ごとに最後に受信した値を待ち時間なしで返す
+     *          timeoutを指定した場合のみ，まだ一度も受信していない組と，CACHE_CAPACITY組を超えて登録できなかった組についてTFを最大timeoutだけ待つ
      * @param parent_frame: 親フレームのID
      * @param child_frame: 子フレームのID
-     * @return Pose2D型の座標関係データ
+     * @param timeout: 未受信時の最大の待ち時間（デフォルト: 待たない）
+     * @return 受信済みか, Pose2D型の座標関係データ（未受信の場合は(0, 0, 0)）
+     * @attention 周期処理ではTfCacheを直接使用し，IDで取得する方が文字列比較がなく高速
     **/
-    static Pose2D<double> getPose2DFromFrameId(const std::string parent_frame, const std::string child_frame)
+    static std::tuple<bool, Pose2D<double>> getPose2D(const std::string &parent_frame, const std::string &child_frame, const ros::Duration &timeout = ros::Duration(0))
     {
-        static tf2_ros::Buffer tfBuffer;
-        static tf2_ros::TransformListener tfListener(tfBuffer);
-        static Pose2D<double> pose(0, 0, 0);
-
-        try
+        TfCache &tf_cache = getCache();
+        const int id = tf_cache.registerFrame(parent_frame, child_frame);
+        if (id < 0)
         {
-            geometry_msgs::TransformStamped tf = tfBuffer.lookupTransform(parent_frame, child_frame, ros::Time(0), ros::Duration(0.1));
-            pose.x = tf.transform.translation.x;
-            pose.y = tf.transform.translation.y;
-            pose.theta = MsgDecoder::getAngularVector(tf.transform.rotation)[2];
+            ROS_WARN_ONCE("TfDecoder: more than %zu frame pairs requested, pairs beyond the cache are not tracked", CACHE_CAPACITY);
+            if (timeout.isZero())
+                return std::forward_as_tuple(false, Pose2D<double>(0, 0, 0));
+            return tf_cache.lookupPose2D(parent_frame, child_frame, timeout);
         }
-        catch(tf2::TransformException &ex){
 
-        }
-        return pose;
+        tf_cache.update(id);
+        std::tuple<bool, Pose2D<double>> result = tf_cache.getPose2D(id);
+        if (!std::get<0>(result) && !timeout.isZero() && tf_cache.update(id, timeout))
+            result = tf_cache.getPose2D(id);
+        return result;
+    }
+
+    /**
+     * @brief フレームIDからTFを読み座標関係をPose2D型のデータで取得する（待ち時間なし）
+     * @param parent_frame: 親フレームのID
+     * @param child_frame: 子フレームのID
+     * @return Pose2D型の座標関係データ（その組を最後に受信した値．未受信の場合は(0, 0, 0)）
+     * @attention 受信済みかどうかや古さを確認する場合はgetPose2D()とgetAge()を使用する
+    **/
+    static Pose2D<double> getPose2DFromFrameId(const std::string &parent_frame, const std::string &child_frame)
+    {
+        return std::get<1>(getPose2D(parent_frame, child_frame));
+    }
+
+    /**
+     * @brief フレームの組の最新のデータがどれだけ古いかを取得する
+     * @param parent_frame: 親フレームのID
+     * @param child_frame: 子フレームのID
+     * @return 最新のデータの経過時間[sec]（未受信または登録できなかった場合は無限大）
+    **/
+    static double getAge(const std::string &parent_frame, const std::string &child_frame)
+    {
+        TfCache &tf_cache = getCache();
+        return tf_cache.getAge(tf_cache.registerFrame(parent_frame, child_frame));
+    }
+
+private:
+    static TfCache &getCache()
+    {
+        static TfCache tf_cache(CACHE_CAPACITY);
+        return tf_cache;
     }
 };
 }
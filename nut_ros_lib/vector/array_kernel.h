@@ -0,0 +1,553 @@
+/**
+ * @file array_kernel.h
+ * @brief 座標配列（SoA）に対する一括演算カーネル
+ * @details AVX2（x86）またはNEON（AArch64）が有効な場合はSIMD命令で計算し，それ以外はスカラで計算する
+ *          NUT_ROS_DISABLE_SIMDを定義すると常にスカラで計算する
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+
+#if !defined(NUT_ROS_DISABLE_SIMD) && defined(__AVX2__)
+#define NUT_ROS_SIMD_AVX2
+#include <immintrin.h>
+#elif !defined(NUT_ROS_DISABLE_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#define NUT_ROS_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace nut_ros {
+/**
+ * @brief 座標配列（SoA）に対する一括演算カーネル
+ * @details 入力と出力に同じ配列を指定してもよい（その場で計算される）
+**/
+class ArrayKernel
+{
+public:
+    /**
+     * @brief 全ての点を原点中心に回転した後に平行移動する
+     * @details x' = c*x - s*y + tx,  y' = s*x + c*y + ty
+     * @param x: x成分の配列（入出力）
+     * @param y: y成分の配列（入出力）
+     * @param n: 要素数
+     * @param c: 回転角度のcos
+     * @param s: 回転角度のsin
+     * @param tx: 平行移動量のx成分
+     * @param ty: 平行移動量のy成分
+     */
+    template <typename T>
+    static inline void transform(T *x, T *y, size_t n, T c, T s, T tx, T ty)
+    {
+        transformScalar(x, y, 0, n, c, s, tx, ty);
+    }
+
+    /**
+     * @brief 全ての点と指定点との距離を求める
+     * @param x: x成分の配列
+     * @param y: y成分の配列
+     * @param n: 要素数
+     * @param px: 指定点のx座標
+     * @param py: 指定点のy座標
+     * @param out: 距離の出力先（n要素）
+     */
+    template <typename T>
+    static inline void distance(const T *x, const T *y, size_t n, T px, T py, T *out)
+    {
+        distanceScalar(x, y, 0, n, px, py, out);
+    }
+
+    /**
+     * @brief 全ての点（ベクトル）と指定ベクトルとの内積を求める
+     * @param x: x成分の配列
+     * @param y: y成分の配列
+     * @param n: 要素数
+     * @param vx: 指定ベクトルのx成分
+     * @param vy: 指定ベクトルのy成分
+     * @param out: 内積の出力先（n要素）
+     */
+    template <typename T>
+    static inline void dot(const T *x, const T *y, size_t n, T vx, T vy, T *out)
+    {
+        dotScalar(x, y, 0, n, vx, vy, out);
+    }
+
+    /**
+     * @brief 全ての点（ベクトル）と指定ベクトルとの外積の大きさを求める
+     * @details out = x*vy - y*vx
+     * @param x: x成分の配列
+     * @param y: y成分の配列
+     * @param n: 要素数
+     * @param vx: 指定ベクトルのx成分
+     * @param vy: 指定ベクトルのy成分
+     * @param out: 外積の出力先（n要素）
+     */
+    template <typename T>
+    static inline void cross(const T *x, const T *y, size_t n, T vx, T vy, T *out)
+    {
+        crossScalar(x, y, 0, n, vx, vy, out);
+    }
+
+    /**
+     * @brief 全ての要素にスカラ加算
+     * @param v: 配列（入出力）
+     * @param n: 要素数
+     * @param s: 加算する値
+     */
+    template <typename T>
+    static inline void add(T *v, size_t n, T s)
+    {
+        for (size_t i = 0; i < n; ++i)
+            v[i] += s;
+    }
+
+    /**
+     * @brief 極座標（距離の配列と角度のcos, sinの表）を直交座標に変換し，範囲外の距離を除いて詰めて出力する
+     * @details 距離がrange_min以上range_max以下の要素のみを出力する（NaN, 無限大も除かれる）
+     *          出力する点には回転と平行移動を同時に適用する: x = r*(c*cos_table - s*sin_table) + tx, y = r*(s*cos_table + c*sin_table) + ty
+     * @param ranges: 距離の配列（n要素）
+     * @param cos_table: 角度のcosの配列（n要素）
+     * @param sin_table: 角度のsinの配列（n要素）
+     * @param n: 要素数
+     * @param range_min: 有効な距離の最小値
+     * @param range_max: 有効な距離の最大値
+     * @param c: 回転角度のcos
+     * @param s: 回転角度のsin
+     * @param tx: 平行移動量のx成分
+     * @param ty: 平行移動量のy成分
+     * @param x: x成分の出力先（n要素の領域が必要）
+     * @param y: y成分の出力先（n要素の領域が必要）
+     * @param indices: 出力した点の元の添字の出力先（n要素の領域が必要，nullptrの場合は出力しない）
+     * @return 出力した点の数
+     */
+    template <typename T>
+    static inline size_t polarToCartesian(const float *ranges, const T *cos_table, const T *sin_table, size_t n, T range_min, T range_max,
+                                          T c, T s, T tx, T ty, T *x, T *y, uint32_t *indices)
+    {
+        return polarToCartesianScalar(ranges, cos_table, sin_table, 0, n, range_min, range_max, c, s, tx, ty, x, y, indices, 0);
+    }
+
+private:
+    template <typename T>
+    static inline void transformScalar(T *x, T *y, size_t begin, size_t n, T c, T s, T tx, T ty)
+    {
+        for (size_t i = begin; i < n; ++i)
+        {
+            const T px = x[i];
+            const T py = y[i];
+            x[i] = c * px - s * py + tx;
+            y[i] = s * px + c * py + ty;
+        }
+    }
+
+    template <typename T>
+    static inline void distanceScalar(const T *x, const T *y, size_t begin, size_t n, T px, T py, T *out)
+    {
+        for (size_t i = begin; i < n; ++i)
+        {
+            const T dx = x[i] - px;
+            const T dy = y[i] - py;
+            out[i] = std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+    template <typename T>
+    static inline void dotScalar(const T *x, const T *y, size_t begin, size_t n, T vx, T vy, T *out)
+    {
+        for (size_t i = begin; i < n; ++i)
+            out[i] = x[i] * vx + y[i] * vy;
+    }
+
+    template <typename T>
+    static inline void crossScalar(const T *x, const T *y, size_t begin, size_t n, T vx, T vy, T *out)
+    {
+        for (size_t i = begin; i < n; ++i)
+            out[i] = x[i] * vy - y[i] * vx;
+    }
+
+    template <typename T>
+    static inline size_t polarToCartesianScalar(const float *ranges, const T *cos_table, const T *sin_table, size_t begin, size_t n, T range_min, T range_max,
+                                                T c, T s, T tx, T ty, T *x, T *y, uint32_t *indices, size_t count)
+    {
+        for (size_t i = begin; i < n; ++i)
+        {
+            const T r = (T)ranges[i];
+            if (!(r >= range_min && r <= range_max))
+                continue;
+            const T dx = c * cos_table[i] - s * sin_table[i];
+            const T dy = s * cos_table[i] + c * sin_table[i];
+            x[count] = r * dx + tx;
+            y[count] = r * dy + ty;
+            if (indices)
+                indices[count] = (uint32_t)i;
+            ++count;
+        }
+        return count;
+    }
+
+    // SIMDで計算したブロックのうち有効な要素のみを詰めて書き出す
+    template <typename T>
+    static inline size_t compressBlock(const T *px, const T *py, const bool *valid, size_t width, size_t begin,
+                                       T *x, T *y, uint32_t *indices, size_t count)
+    {
+        for (size_t j = 0; j < width; ++j)
+        {
+            if (!valid[j])
+                continue;
+            x[count] = px[j];
+            y[count] = py[j];
+            if (indices)
+                indices[count] = (uint32_t)(begin + j);
+            ++count;
+        }
+        return count;
+    }
+
+    static inline void writeIndices(uint32_t *indices, size_t width, size_t begin)
+    {
+        if (indices)
+            for (size_t j = 0; j < width; ++j)
+                indices[j] = (uint32_t)(begin + j);
+    }
+};
+
+#if defined(NUT_ROS_SIMD_AVX2)
+template <>
+inline void ArrayKernel::transform<double>(double *x, double *y, size_t n, double c, double s, double tx, double ty)
+{
+    const __m256d vc = _mm256_set1_pd(c), vs = _mm256_set1_pd(s);
+    const __m256d vtx = _mm256_set1_pd(tx), vty = _mm256_set1_pd(ty);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m256d px = _mm256_loadu_pd(x + i);
+        const __m256d py = _mm256_loadu_pd(y + i);
+        _mm256_storeu_pd(x + i, _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(vc, px), _mm256_mul_pd(vs, py)), vtx));
+        _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vs, px), _mm256_mul_pd(vc, py)), vty));
+    }
+    transformScalar(x, y, i, n, c, s, tx, ty);
+}
+
+template <>
+inline void ArrayKernel::transform<float>(float *x, float *y, size_t n, float c, float s, float tx, float ty)
+{
+    const __m256 vc = _mm256_set1_ps(c), vs = _mm256_set1_ps(s);
+    const __m256 vtx = _mm256_set1_ps(tx), vty = _mm256_set1_ps(ty);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256 px = _mm256_loadu_ps(x + i);
+        const __m256 py = _mm256_loadu_ps(y + i);
+        _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(vc, px), _mm256_mul_ps(vs, py)), vtx));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vs, px), _mm256_mul_ps(vc, py)), vty));
+    }
+    transformScalar(x, y, i, n, c, s, tx, ty);
+}
+
+template <>
+inline void ArrayKernel::distance<double>(const double *x, const double *y, size_t n, double px, double py, double *out)
+{
+    const __m256d vpx = _mm256_set1_pd(px), vpy = _mm256_set1_pd(py);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), vpx);
+        const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), vpy);
+        _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy))));
+    }
+    distanceScalar(x, y, i, n, px, py, out);
+}
+
+template <>
+inline void ArrayKernel::distance<float>(const float *x, const float *y, size_t n, float px, float py, float *out)
+{
+    const __m256 vpx = _mm256_set1_ps(px), vpy = _mm256_set1_ps(py);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), vpx);
+        const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), vpy);
+        _mm256_storeu_ps(out + i, _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy))));
+    }
+    distanceScalar(x, y, i, n, px, py, out);
+}
+
+template <>
+inline void ArrayKernel::dot<double>(const double *x, const double *y, size_t n, double vx, double vy, double *out)
+{
+    const __m256d vvx = _mm256_set1_pd(vx), vvy = _mm256_set1_pd(vy);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(x + i), vvx), _mm256_mul_pd(_mm256_loadu_pd(y + i), vvy)));
+    dotScalar(x, y, i, n, vx, vy, out);
+}
+
+template <>
+inline void ArrayKernel::dot<float>(const float *x, const float *y, size_t n, float vx, float vy, float *out)
+{
+    const __m256 vvx = _mm256_set1_ps(vx), vvy = _mm256_set1_ps(vy);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(x + i), vvx), _mm256_mul_ps(_mm256_loadu_ps(y + i), vvy)));
+    dotScalar(x, y, i, n, vx, vy, out);
+}
+
+template <>
+inline void ArrayKernel::cross<double>(const double *x, const double *y, size_t n, double vx, double vy, double *out)
+{
+    const __m256d vvx = _mm256_set1_pd(vx), vvy = _mm256_set1_pd(vy);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_mul_pd(_mm256_loadu_pd(x + i), vvy), _mm256_mul_pd(_mm256_loadu_pd(y + i), vvx)));
+    crossScalar(x, y, i, n, vx, vy, out);
+}
+
+template <>
+inline void ArrayKernel::cross<float>(const float *x, const float *y, size_t n, float vx, float vy, float *out)
+{
+    const __m256 vvx = _mm256_set1_ps(vx), vvy = _mm256_set1_ps(vy);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(x + i), vvy), _mm256_mul_ps(_mm256_loadu_ps(y + i), vvx)));
+    crossScalar(x, y, i, n, vx, vy, out);
+}
+template <>
+inline size_t ArrayKernel::polarToCartesian<double>(const float *ranges, const double *cos_table, const double *sin_table, size_t n, double range_min, double range_max,
+                                                    double c, double s, double tx, double ty, double *x, double *y, uint32_t *indices)
+{
+    const __m256d vc = _mm256_set1_pd(c), vs = _mm256_set1_pd(s);
+    const __m256d vtx = _mm256_set1_pd(tx), vty = _mm256_set1_pd(ty);
+    const __m256d vmin = _mm256_set1_pd(range_min), vmax = _mm256_set1_pd(range_max);
+    size_t i = 0, count = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m256d r = _mm256_cvtps_pd(_mm_loadu_ps(ranges + i));
+        const int mask = _mm256_movemask_pd(_mm256_and_pd(_mm256_cmp_pd(r, vmin, _CMP_GE_OQ), _mm256_cmp_pd(r, vmax, _CMP_LE_OQ)));
+        if (mask == 0)
+            continue;
+        const __m256d tc = _mm256_loadu_pd(cos_table + i), ts = _mm256_loadu_pd(sin_table + i);
+        const __m256d px = _mm256_add_pd(_mm256_mul_pd(r, _mm256_sub_pd(_mm256_mul_pd(vc, tc), _mm256_mul_pd(vs, ts))), vtx);
+        const __m256d py = _mm256_add_pd(_mm256_mul_pd(r, _mm256_add_pd(_mm256_mul_pd(vs, tc), _mm256_mul_pd(vc, ts))), vty);
+        if (mask == 0xF)
+        {
+            _mm256_storeu_pd(x + count, px);
+            _mm256_storeu_pd(y + count, py);
+            writeIndices(indices ? indices + count : nullptr, 4, i);
+            count += 4;
+            continue;
+        }
+        double bx[4], by[4];
+        const bool valid[4] = {(mask & 1) != 0, (mask & 2) != 0, (mask & 4) != 0, (mask & 8) != 0};
+        _mm256_storeu_pd(bx, px);
+        _mm256_storeu_pd(by, py);
+        count = compressBlock(bx, by, valid, 4, i, x, y, indices, count);
+    }
+    return polarToCartesianScalar(ranges, cos_table, sin_table, i, n, range_min, range_max, c, s, tx, ty, x, y, indices, count);
+}
+
+template <>
+inline size_t ArrayKernel::polarToCartesian<float>(const float *ranges, const float *cos_table, const float *sin_table, size_t n, float range_min, float range_max,
+                                                   float c, float s, float tx, float ty, float *x, float *y, uint32_t *indices)
+{
+    const __m256 vc = _mm256_set1_ps(c), vs = _mm256_set1_ps(s);
+    const __m256 vtx = _mm256_set1_ps(tx), vty = _mm256_set1_ps(ty);
+    const __m256 vmin = _mm256_set1_ps(range_min), vmax = _mm256_set1_ps(range_max);
+    size_t i = 0, count = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256 r = _mm256_loadu_ps(ranges + i);
+        const int mask = _mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(r, vmin, _CMP_GE_OQ), _mm256_cmp_ps(r, vmax, _CMP_LE_OQ)));
+        if (mask == 0)
+            continue;
+        const __m256 tc = _mm256_loadu_ps(cos_table + i), ts = _mm256_loadu_ps(sin_table + i);
+        const __m256 px = _mm256_add_ps(_mm256_mul_ps(r, _mm256_sub_ps(_mm256_mul_ps(vc, tc), _mm256_mul_ps(vs, ts))), vtx);
+        const __m256 py = _mm256_add_ps(_mm256_mul_ps(r, _mm256_add_ps(_mm256_mul_ps(vs, tc), _mm256_mul_ps(vc, ts))), vty);
+        if (mask == 0xFF)
+        {
+            _mm256_storeu_ps(x + count, px);
+            _mm256_storeu_ps(y + count, py);
+            writeIndices(indices ? indices + count : nullptr, 8, i);
+            count += 8;
+            continue;
+        }
+        float bx[8], by[8];
+        bool valid[8];
+        for (size_t j = 0; j < 8; ++j)
+            valid[j] = ((mask >> j) & 1) != 0;
+        _mm256_storeu_ps(bx, px);
+        _mm256_storeu_ps(by, py);
+        count = compressBlock(bx, by, valid, 8, i, x, y, indices, count);
+    }
+    return polarToCartesianScalar(ranges, cos_table, sin_table, i, n, range_min, range_max, c, s, tx, ty, x, y, indices, count);
+}
+#elif defined(NUT_ROS_SIMD_NEON)
+template <>
+inline void ArrayKernel::transform<double>(double *x, double *y, size_t n, double c, double s, double tx, double ty)
+{
+    const float64x2_t vc = vdupq_n_f64(c), vs = vdupq_n_f64(s);
+    const float64x2_t vtx = vdupq_n_f64(tx), vty = vdupq_n_f64(ty);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        const float64x2_t px = vld1q_f64(x + i);
+        const float64x2_t py = vld1q_f64(y + i);
+        vst1q_f64(x + i, vaddq_f64(vsubq_f64(vmulq_f64(vc, px), vmulq_f64(vs, py)), vtx));
+        vst1q_f64(y + i, vaddq_f64(vaddq_f64(vmulq_f64(vs, px), vmulq_f64(vc, py)), vty));
+    }
+    transformScalar(x, y, i, n, c, s, tx, ty);
+}
+
+template <>
+inline void ArrayKernel::transform<float>(float *x, float *y, size_t n, float c, float s, float tx, float ty)
+{
+    const float32x4_t vc = vdupq_n_f32(c), vs = vdupq_n_f32(s);
+    const float32x4_t vtx = vdupq_n_f32(tx), vty = vdupq_n_f32(ty);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const float32x4_t px = vld1q_f32(x + i);
+        const float32x4_t py = vld1q_f32(y + i);
+        vst1q_f32(x + i, vaddq_f32(vsubq_f32(vmulq_f32(vc, px), vmulq_f32(vs, py)), vtx));
+        vst1q_f32(y + i, vaddq_f32(vaddq_f32(vmulq_f32(vs, px), vmulq_f32(vc, py)), vty));
+    }
+    transformScalar(x, y, i, n, c, s, tx, ty);
+}
+
+template <>
+inline void ArrayKernel::distance<double>(const double *x, const double *y, size_t n, double px, double py, double *out)
+{
+    const float64x2_t vpx = vdupq_n_f64(px), vpy = vdupq_n_f64(py);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        const float64x2_t dx = vsubq_f64(vld1q_f64(x + i), vpx);
+        const float64x2_t dy = vsubq_f64(vld1q_f64(y + i), vpy);
+        vst1q_f64(out + i, vsqrtq_f64(vaddq_f64(vmulq_f64(dx, dx), vmulq_f64(dy, dy))));
+    }
+    distanceScalar(x, y, i, n, px, py, out);
+}
+
+template <>
+inline void ArrayKernel::distance<float>(const float *x, const float *y, size_t n, float px, float py, float *out)
+{
+    const float32x4_t vpx = vdupq_n_f32(px), vpy = vdupq_n_f32(py);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const float32x4_t dx = vsubq_f32(vld1q_f32(x + i), vpx);
+        const float32x4_t dy = vsubq_f32(vld1q_f32(y + i), vpy);
+        vst1q_f32(out + i, vsqrtq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy))));
+    }
+    distanceScalar(x, y, i, n, px, py, out);
+}
+
+template <>
+inline void ArrayKernel::dot<double>(const double *x, const double *y, size_t n, double vx, double vy, double *out)
+{
+    const float64x2_t vvx = vdupq_n_f64(vx), vvy = vdupq_n_f64(vy);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        vst1q_f64(out + i, vaddq_f64(vmulq_f64(vld1q_f64(x + i), vvx), vmulq_f64(vld1q_f64(y + i), vvy)));
+    dotScalar(x, y, i, n, vx, vy, out);
+}
+
+template <>
+inline void ArrayKernel::dot<float>(const float *x, const float *y, size_t n, float vx, float vy, float *out)
+{
+    const float32x4_t vvx = vdupq_n_f32(vx), vvy = vdupq_n_f32(vy);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(out + i, vaddq_f32(vmulq_f32(vld1q_f32(x + i), vvx), vmulq_f32(vld1q_f32(y + i), vvy)));
+    dotScalar(x, y, i, n, vx, vy, out);
+}
+
+template <>
+inline void ArrayKernel::cross<double>(const double *x, const double *y, size_t n, double vx, double vy, double *out)
+{
+    const float64x2_t vvx = vdupq_n_f64(vx), vvy = vdupq_n_f64(vy);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        vst1q_f64(out + i, vsubq_f64(vmulq_f64(vld1q_f64(x + i), vvy), vmulq_f64(vld1q_f64(y + i), vvx)));
+    crossScalar(x, y, i, n, vx, vy, out);
+}
+
+template <>
+inline void ArrayKernel::cross<float>(const float *x, const float *y, size_t n, float vx, float vy, float *out)
+{
+    const float32x4_t vvx = vdupq_n_f32(vx), vvy = vdupq_n_f32(vy);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(out + i, vsubq_f32(vmulq_f32(vld1q_f32(x + i), vvy), vmulq_f32(vld1q_f32(y + i), vvx)));
+    crossScalar(x, y, i, n, vx, vy, out);
+}
+
+template <>
+inline size_t ArrayKernel::polarToCartesian<double>(const float *ranges, const double *cos_table, const double *sin_table, size_t n, double range_min, double range_max,
+                                                    double c, double s, double tx, double ty, double *x, double *y, uint32_t *indices)
+{
+    const float64x2_t vc = vdupq_n_f64(c), vs = vdupq_n_f64(s);
+    const float64x2_t vtx = vdupq_n_f64(tx), vty = vdupq_n_f64(ty);
+    const float64x2_t vmin = vdupq_n_f64(range_min), vmax = vdupq_n_f64(range_max);
+    size_t i = 0, count = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        const float64x2_t r = vcvt_f64_f32(vld1_f32(ranges + i));
+        const uint64x2_t mask = vandq_u64(vcgeq_f64(r, vmin), vcleq_f64(r, vmax));
+        const bool valid[2] = {vgetq_lane_u64(mask, 0) != 0, vgetq_lane_u64(mask, 1) != 0};
+        if (!valid[0] && !valid[1])
+            continue;
+        const float64x2_t tc = vld1q_f64(cos_table + i), ts = vld1q_f64(sin_table + i);
+        const float64x2_t px = vaddq_f64(vmulq_f64(r, vsubq_f64(vmulq_f64(vc, tc), vmulq_f64(vs, ts))), vtx);
+        const float64x2_t py = vaddq_f64(vmulq_f64(r, vaddq_f64(vmulq_f64(vs, tc), vmulq_f64(vc, ts))), vty);
+        if (valid[0] && valid[1])
+        {
+            vst1q_f64(x + count, px);
+            vst1q_f64(y + count, py);
+            writeIndices(indices ? indices + count : nullptr, 2, i);
+            count += 2;
+            continue;
+        }
+        double bx[2], by[2];
+        vst1q_f64(bx, px);
+        vst1q_f64(by, py);
+        count = compressBlock(bx, by, valid, 2, i, x, y, indices, count);
+    }
+    return polarToCartesianScalar(ranges, cos_table, sin_table, i, n, range_min, range_max, c, s, tx, ty, x, y, indices, count);
+}
+
+template <>
+inline size_t ArrayKernel::polarToCartesian<float>(const float *ranges, const float *cos_table, const float *sin_table, size_t n, float range_min, float range_max,
+                                                   float c, float s, float tx, float ty, float *x, float *y, uint32_t *indices)
+{
+    const float32x4_t vc = vdupq_n_f32(c), vs = vdupq_n_f32(s);
+    const float32x4_t vtx = vdupq_n_f32(tx), vty = vdupq_n_f32(ty);
+    const float32x4_t vmin = vdupq_n_f32(range_min), vmax = vdupq_n_f32(range_max);
+    size_t i = 0, count = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const float32x4_t r = vld1q_f32(ranges + i);
+        const uint32x4_t mask = vandq_u32(vcgeq_f32(r, vmin), vcleq_f32(r, vmax));
+        if (vmaxvq_u32(mask) == 0)
+            continue;
+        const float32x4_t tc = vld1q_f32(cos_table + i), ts = vld1q_f32(sin_table + i);
+        const float32x4_t px = vaddq_f32(vmulq_f32(r, vsubq_f32(vmulq_f32(vc, tc), vmulq_f32(vs, ts))), vtx);
+        const float32x4_t py = vaddq_f32(vmulq_f32(r, vaddq_f32(vmulq_f32(vs, tc), vmulq_f32(vc, ts))), vty);
+        if (vminvq_u32(mask) != 0)
+        {
+            vst1q_f32(x + count, px);
+            vst1q_f32(y + count, py);
+            writeIndices(indices ? indices + count : nullptr, 4, i);
+            count += 4;
+            continue;
+        }
+        float bx[4], by[4];
+        uint32_t m[4];
+        vst1q_f32(bx, px);
+        vst1q_f32(by, py);
+        vst1q_u32(m, mask);
+        const bool valid[4] = {m[0] != 0, m[1] != 0, m[2] != 0, m[3] != 0};
+        count = compressBlock(bx, by, valid, 4, i, x, y, indices, count);
+    }
+    return polarToCartesianScalar(ranges, cos_table, sin_table, i, n, range_min, range_max, c, s, tx, ty, x, y, indices, count);
+}
+#endif
+}
@@ -6,20 +6,45 @@
 **/
 #pragma once
 
-#include "./../nut_generic.h"
+#include "./../nut_generic_core.h"
 #include "./pose_2D.h"
+#include "./rotation_2D.h"
+#include "./segment_2D.h"
 
 namespace nut_ros {
+template <typename T>
+class Transform2D;
+
 /**
  * @brief 直線を扱う
+ * @details 直線の式 ax + by + c = 0 （a^2 + b^2 = 1）の係数，単位方向ベクトル，長さをset()時に計算して保持する
+ *          始点と終点はset(), rotate(), transform()でのみ変更でき，係数などはその際に再計算される
 **/
 template <typename T>
 class Line2D
 {
 private:
+    Pose2D<T> _start;          // 始点
+    Pose2D<T> _end;            // 終点
+    T _a = 0, _b = 0, _c = 0;  // ax + by + c = 0 （a^2 + b^2 = 1）
+    T _dir_x = 0, _dir_y = 0;  // 始点から終点への単位ベクトル
+    T _length = 0;             // 長さ
+
+    // 直線の係数，方向ベクトル，長さを再計算する
+    void update()
+    {
+        const T dx = _end.x - _start.x;
+        const T dy = _end.y - _start.y;
+        _length = std::sqrt(dx * dx + dy * dy);
+        const T inv = _length > 0 ? 1 / _length : 0;
+        _dir_x = dx * inv;
+        _dir_y = dy * inv;
+        _a = -_dir_y;
+        _b = _dir_x;
+        _c = -(_a * _start.x + _b * _start.y);
+    }
+
 public:
-    Pose2D<T> start;
-    Pose2D<T> end;
     constexpr static T eps = 1e-10;  // 許容誤差
 
     /**
@@ -38,12 +63,6 @@ public:
      */
     Line2D(T x1, T y1, T theta1, T x2, T y2, T theta2) {
         set(x1, y1, theta1, x2, y2, theta2);
-        start.x = x1;
-        start.y = y1;
-        start.theta = theta1;
-        end.x = x2;
-        end.y = y2;
-        end.theta = theta2;
     }
 
     /**
@@ -55,28 +74,32 @@ public:
      */
     Line2D(T x1, T y1, T x2, T y2) {
         set(x1, y1, x2, y2);
-        // start.x = x1;
-        // start.y = y1;
-        // end.x = x2;
-        // end.y = y2;
     }
 
     /**
      * @brief コンストラクタ Pose2Dでこの直線を設定
-     * @param _start: Pose2Dでの始点座標
-     * @param _end: Pose2Dでの終点座標
+     * @param start: Pose2Dでの始点座標
+     * @param end: Pose2Dでの終点座標
      */
-    Line2D(Pose2D<T> _start, Pose2D<T> _end) {
-        set(_start, _end);
+    Line2D(const Pose2D<T> &start, const Pose2D<T> &end) {
+        set(start, end);
     }
 
     /**
      * @brief コンストラクタ Vector2でこの直線を設定
-     * @param _start: Vector2での始点座標
-     * @param _end: Vector2での終点座標
+     * @param start: Vector2での始点座標
+     * @param end: Vector2での終点座標
+     */
+    Line2D(const Vector2<T> &start, const Vector2<T> &end) {
+        set(start, end);
+    }
+
+    /**
+     * @brief コンストラクタ Segment2Dでこの直線を設定
+     * @param segment: 線分
      */
-    Line2D(Vector2<T> _start, Vector2<T> _end) {
-        set(_start, _end);
+    explicit Line2D(const Segment2D<T> &segment) {
+        set(segment);
     }
 
     /**
@@ -89,12 +112,13 @@ public:
      * @param theta2: 終点のtheta座標
      */
     void set(T x1, T y1, T theta1, T x2, T y2, T theta2) {
-        start.x = x1;
-        start.y = y1;
-        start.theta = theta1;
-        end.x = x2;
-        end.y = y2;
-        end.theta = theta2;
+        _start.x = x1;
+        _start.y = y1;
+        _start.theta = theta1;
+        _end.x = x2;
+        _end.y = y2;
+        _end.theta = theta2;
+        update();
     }
 
     /**
@@ -105,50 +129,137 @@ public:
      * @param y2: 終点のy座標
      */
     void set(T x1, T y1, T x2, T y2) {
-        start.x = x1;
-        start.y = y1;
-        end.x = x2;
-        end.y = y2;
+        _start.x = x1;
+        _start.y = y1;
+        _end.x = x2;
+        _end.y = y2;
+        update();
     }
 
     /**
      * @brief Pose2Dでこの直線を設定
-     * @param _start: Pose2Dでの始点座標
-     * @param _end: Pose2Dでの終点座標
+     * @param start: Pose2Dでの始点座標
+     * @param end: Pose2Dでの終点座標
      */
-    void set(Pose2D<T> _start, Pose2D<T> _end) {
-        start = _start;
-        end = _end;
+    void set(const Pose2D<T> &start, const Pose2D<T> &end) {
+        _start = start;
+        _end = end;
+        update();
     }
 
     /**
      * @brief Vector2でこの直線を設定
-     * @param _start: Vector2での始点座標
-     * @param _end: Vector2での終点座標
+     * @param start: Vector2での始点座標
+     * @param end: Vector2での終点座標
+     */
+    void set(const Vector2<T> &start, const Vector2<T> &end) {
+        _start.x = start.x;
+        _start.y = start.y;
+        _end.x = end.x;
+        _end.y = end.y;
+        update();
+    }
+
+    /**
+     * @brief Segment2Dでこの直線を設定
+     * @param segment: 線分
+     */
+    void set(const Segment2D<T> &segment) {
+        set(segment.x1, segment.y1, segment.x2, segment.y2);
+    }
+
+    /**
+     * @brief Segment2Dに変換
+     * @return 始点と終点のみの線分
+     */
+    Segment2D<T> toSegment2D() const
+    {
+        return Segment2D<T>(_start.x, _start.y, _end.x, _end.y);
+    }
+
+    /**
+     * @brief この直線を原点中心にangle[rad]回転
+     * @param angle: 回転させる角度[rad]
+     */
+    void rotate(T angle)
+    {
+        rotate(Rotation2D<T>(angle));
+    }
+
+    /**
+     * @brief この直線を原点中心に回転
+     * @param rotation: 回転（cos, sinは計算済みのものを使用）
+     */
+    void rotate(const Rotation2D<T> &rotation)
+    {
+        _start.rotate(rotation);
+        _end.rotate(rotation);
+        update();
+    }
+
+    /**
+     * @brief この直線を剛体変換（回転した後に平行移動）
+     * @param tf: 剛体変換（vector/transform_2D.h）
+     */
+    void transform(const Transform2D<T> &tf)
+    {
+        _start.transform(tf);
+        _end.transform(tf);
+        update();
+    }
+
+    /**
+     * @brief 始点を返す
+     * @return 始点
      */
-    void set(Vector2<T> _start, Vector2<T> _end) {
-        start.x = _start.x;
-        start.y = _start.y;
-        end.x = _end.x;
-        end.y = _end.y;
+    const Pose2D<T> &getStart() const
+    {
+        return _start;
+    }
+
+    /**
+     * @brief 終点を返す
+     * @return 終点
+     */
+    const Pose2D<T> &getEnd() const
+    {
+        return _end;
     }
 
     /**
      * @brief この直線の長さを返す
      * @return この直線の長さ
      */
-    T getLength()
+    T getLength() const
     {
-        return Pose2D<T>::getDistance(start, end);
+        return _length;
     }
 
     /**
      * @brief この直線の角度を返す
      * @return この直線の角度
      */
-    T getAngle()
+    T getAngle() const
     {
-        return Pose2D<T>::getAngle(start, end);
+        return std::atan2(_end.y - _start.y, _end.x - _start.x);
+    }
+
+    /**
+     * @brief この直線の単位方向ベクトルを返す
+     * @return 始点から終点への単位ベクトル（長さゼロの場合はゼロベクトル）
+     */
+    Vector2<T> getDirection() const
+    {
+        return Vector2<T>(_dir_x, _dir_y);
+    }
+
+    /**
+     * @brief この直線の式 ax + by + c = 0 の係数を返す
+     * @return a, b, c（a^2 + b^2 = 1，長さゼロの場合は全てゼロ）
+     */
+    std::tuple<T, T, T> getCoefficients() const
+    {
+        return std::make_tuple(_a, _b, _c);
     }
 
     /**
@@ -156,60 +267,26 @@ public:
      * @param p: 指定点
      * @return この直線上に指定点が存在するかどうか
      */
-    bool isPointOnLine(Pose2D<T> p)
+    bool isPointOnLine(const Pose2D<T> &p) const
     {
-        return std::abs(Pose2D<T>::getCross(end-start, p-start)) < eps;
+        // |ap.x + bp.y + c| * 長さ は (end - start)と(p - start)の外積の大きさに等しい
+        return std::abs(_a * p.x + _b * p.y + _c) * _length < eps;
     }
 
     /**
      * @brief この線分上に指定点が存在するかどうか
      * @param p: 指定点
-     * @return この線分上に指定点が存在するかどうか
+     * @return この線分上に指定点が存在するかどうか（端点を含む）
      */
-    bool isPointOnLineWithinRange(Pose2D<T> p)
+    bool isPointOnLineWithinRange(const Pose2D<T> &p) const
     {
-        if(isPointOnLine(p))
-        {
-            // 存在する
-            bool result = true;
-            T x_min = std::min(start.x, end.x);
-            T x_max = std::max(start.x, end.x);
-            T y_min = std::min(start.y, end.y);
-            T y_max = std::max(start.y, end.y);
-
-            if (std::abs(x_max - x_min) < eps)
-            {
-                // 範囲が狭いとき
-                if (std::abs(x_max - p.x) > eps)
-                    result = false;
-            }
-            else
-            {
-                // 範囲が広い
-                if (!(x_min < p.x && p.x < x_max))
-                    result = false;
-            }
-
-            if (std::abs(y_max - y_min) < eps)
-            {
-                // 範囲が狭いとき
-                if (std::abs(y_max - p.y) > eps)
-                    result = false;
-            }
-            else
-            {
-                // 範囲が広い
-                if (!(y_min < p.y && p.y < y_max))
-                    result = false;
-            }
-
-            return result;
-        }
-        else
-        {
-            // 存在しない
-            return false;
-        }
+        const T ox = p.x - _start.x;
+        const T oy = p.y - _start.y;
+        const T t = ox * _dir_x + oy * _dir_y; // 始点からの射影長
+        const bool on_line = isPointOnLine(p);
+        const bool in_range = (t >= -eps) & (t <= _length + eps);
+        const bool not_degenerated = (_length > eps) | (ox * ox + oy * oy < eps * eps);
+        return on_line & in_range & not_degenerated;
     }
 
     /**
@@ -218,20 +295,28 @@ public:
      * @param line2: 直線2
      * @return 2直線が交差するか, 2直線の交点
      */
-    static std::tuple<bool, Pose2D<T>> getIntersection(Line2D line1, Line2D line2)
+    static std::tuple<bool, Pose2D<T>> getIntersection(const Line2D &line1, const Line2D &line2)
     {
-        if (std::abs(Pose2D<T>::getCross(line1.end - line1.start, line2.end - line2.start)) > eps)
+        const T ax = line1._end.x - line1._start.x;
+        const T ay = line1._end.y - line1._start.y;
+        const T bx = line2._end.x - line2._start.x;
+        const T by = line2._end.y - line2._start.y;
+        const T cross = ax * by - ay * bx;
+        if (std::abs(cross) > eps)
         {
             // 交差する
-            Pose2D<T> a = line1.end - line1.start;
-            Pose2D<T> b = line2.end - line2.start;
-            Pose2D<T> intersection = line1.start + a * Pose2D<T>::getCross(b, line2.start-line1.start) / Pose2D<T>::getCross(b, a);
-            return std::forward_as_tuple(true, intersection);
+            const T wx = line2._start.x - line1._start.x;
+            const T wy = line2._start.y - line1._start.y;
+            const T k = (wx * by - wy * bx) / cross;
+            Pose2D<T> intersection(line1._start.x + ax * k,
+                                   line1._start.y + ay * k,
+                                   line1._start.theta + (line1._end.theta - line1._start.theta) * k);
+            return std::make_tuple(true, intersection);
         }
         else
         {
             // 交差しない
-            return std::forward_as_tuple(false, Pose2D<T>(0, 0, 0));
+            return std::make_tuple(false, Pose2D<T>(0, 0, 0));
         }
     }
 
@@ -241,7 +326,7 @@ public:
      * @param line2: 線分2
      * @return 2線分が交差するか, 2線分の交点
      */
-    static std::tuple<bool, Pose2D<T>> getIntersectionWithinRange(Line2D line1, Line2D line2)
+    static std::tuple<bool, Pose2D<T>> getIntersectionWithinRange(const Line2D &line1, const Line2D &line2)
     {
         bool is_intersected;    // 交差判定
         Pose2D<T> intersection; // 交点
@@ -251,12 +336,12 @@ public:
         {
             // 交差する
             is_intersected = (line1.isPointOnLineWithinRange(intersection) && line2.isPointOnLineWithinRange(intersection));
-            return std::forward_as_tuple(is_intersected, intersection);
+            return std::make_tuple(is_intersected, intersection);
         }
         else
         {
             // 交差しない
-            return std::forward_as_tuple(false, intersection);
+            return std::make_tuple(false, intersection);
         }
     }
 
@@ -264,28 +349,14 @@ public:
      * @brief 点と直線との距離
      * @param pose: 点
      * @param line: 直線
-     * @return 点と直線との距離
+     * @return 点と直線との距離（長さゼロの場合は始点との距離）
      */
-    static T getDistanceFromPointToLine(Pose2D<T> pose, Line2D line)
+    static T getDistanceFromPointToLine(const Pose2D<T> &pose, const Line2D &line)
     {
-        // ax + by + c = 0 の形にする
-        T a, b, c;
-        if (std::abs(line.start.x - line.end.x) > eps)
-        {
-            a =  (line.end.y - line.start.y) / (line.end.x - line.start.x);
-            b = -1;
-            c = -(line.end.y - line.start.y) / (line.end.x - line.start.x) * line.start.x + line.start.y;
-        }
+        if (line._length > 0)
+            return std::abs(line._a * pose.x + line._b * pose.y + line._c);
         else
-        {
-            a = 1;
-            b = 0;
-            c = -line.start.x;
-        }
-        std::cout << "a:" << a <<  " b:" << b <<  " c:" << c << std::endl;
-
-        T distance = std::abs(a * pose.x + b * pose.y + c) / std::sqrt(a * a + b * b);
-        return distance;
+            return Pose2D<T>::getDistance(pose, line._start);
     }
 
     /**
@@ -294,42 +365,15 @@ public:
      * @param line: 線分
      * @return 点と線分との距離
      */
-    static T getDistanceFromPointToLineWithinRange(Pose2D<T> pose, Line2D line)
+    static T getDistanceFromPointToLineWithinRange(const Pose2D<T> &pose, const Line2D &line)
     {
-        // ax + by + c = 0 の形にする
-        T a, b, c;
-        if (std::abs(line.start.x - line.end.x) > eps)
-        {
-            a =  (line.end.y - line.start.y) / (line.end.x - line.start.x);
-            b = -1;
-            c = -(line.end.y - line.start.y) / (line.end.x - line.start.x) * line.start.x + line.start.y;
-        }
-        else
-        {
-            a = 1;
-            b = 0;
-            c = -line.start.x;
-        }
-
-        // 点から線分に垂線をおろしたときの交点の座標を求める
-        T p = pose.x;
-        T q = pose.y;
-        Pose2D<T> h;
-        h.x = (p*(a*a+b*b) - a*(a*p+b*q+c)) / (a*a+b*b);
-        h.y = (q*(a*a+b*b) - b*(a*p+b*q+c)) / (a*a+b*b);
-
-        if (line.isPointOnLineWithinRange(h))
-        {
-            // 垂線の交点が線分上に存在するとき
-            // そのまま距離を返す
-            return std::abs(a * pose.x + b * pose.y + c) / std::sqrt(a * a + b * b);
-        }
-        else
-        {
-            // 垂線の交点が線分上に存在しないとき
-            // 線分の境界のうち近い方を返す
-            return std::min(Pose2D<T>::getDistance(pose, line.start), Pose2D<T>::getDistance(pose, line.end));
-        }
+        // 線分上で最も近い点（垂線の足を線分の範囲に制限したもの）との距離
+        const T ox = pose.x - line._start.x;
+        const T oy = pose.y - line._start.y;
+        const T t = Generic::guard<T>(ox * line._dir_x + oy * line._dir_y, 0, line._length);
+        const T hx = ox - line._dir_x * t;
+        const T hy = oy - line._dir_y * t;
+        return std::sqrt(hx * hx + hy * hy);
     }
 };
 }
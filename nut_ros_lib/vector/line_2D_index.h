@@ -0,0 +1,403 @@
+/**
+ * @file line_2D_index.h
+ * @brief 多数の線分（フィールドの壁など）に対する空間インデックス
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./pose_2D.h"
+#include "./line_2D.h"
+
+#include <limits>
+
+namespace nut_ros {
+/**
+ * @brief 多数の線分（フィールドの壁など）に対する空間インデックス（一様グリッド）
+ * @details 起動時に一度だけ構築し，最近傍の線分，線分との交差，半径内の線分の検索を全探索より少ない判定回数で行う
+ *          各線分との判定には全探索と同じLine2Dの関数を使用するため，結果は全探索と完全に一致する
+ *          （同じ距離の線分が複数ある場合は添字の小さい方を返す）
+ * @attention 構築後に線分を変更した場合はbuild()を呼び直す必要がある
+**/
+template <typename T>
+class Line2DIndex
+{
+public:
+    /**
+     * @brief コンストラクタ
+     */
+    Line2DIndex() = default;
+
+    /**
+     * @brief コンストラクタ 線分群からインデックスを構築
+     * @param lines: 線分群
+     * @param cell_size: グリッドの1マスの大きさ（0以下の場合は線分の平均長さから自動で決定）
+     */
+    explicit Line2DIndex(const std::vector<Line2D<T>> &lines, T cell_size = 0)
+    {
+        build(lines, cell_size);
+    }
+
+    /**
+     * @brief 線分群からインデックスを構築
+     * @param lines: 線分群（内部にコピーされる）
+     * @param cell_size: グリッドの1マスの大きさ（0以下の場合は線分の平均長さから自動で決定）
+     */
+    void build(const std::vector<Line2D<T>> &lines, T cell_size = 0)
+    {
+        _lines = lines;
+        _cell_start.clear();
+        _cell_items.clear();
+        _nx = _ny = 0;
+        _ax.resize(_lines.size());
+        _ay.resize(_lines.size());
+        _ex.resize(_lines.size());
+        _ey.resize(_lines.size());
+        for (size_t i = 0; i < _lines.size(); ++i)
+        {
+            _ax[i] = _lines[i].getStart().x;
+            _ay[i] = _lines[i].getStart().y;
+            _ex[i] = _lines[i].getEnd().x - _lines[i].getStart().x;
+            _ey[i] = _lines[i].getEnd().y - _lines[i].getStart().y;
+        }
+        if (_lines.empty())
+            return;
+
+        // 全体の範囲
+        T min_x = std::min(_lines[0].getStart().x, _lines[0].getEnd().x);
+        T max_x = std::max(_lines[0].getStart().x, _lines[0].getEnd().x);
+        T min_y = std::min(_lines[0].getStart().y, _lines[0].getEnd().y);
+        T max_y = std::max(_lines[0].getStart().y, _lines[0].getEnd().y);
+        T length_sum = 0;
+        for (auto &line : _lines)
+        {
+            min_x = std::min(min_x, std::min(line.getStart().x, line.getEnd().x));
+            max_x = std::max(max_x, std::max(line.getStart().x, line.getEnd().x));
+            min_y = std::min(min_y, std::min(line.getStart().y, line.getEnd().y));
+            max_y = std::max(max_y, std::max(line.getStart().y, line.getEnd().y));
+            length_sum += line.getLength();
+        }
+        const T extent = std::max(max_x - min_x, max_y - min_y);
+
+        if (!(cell_size > 0))
+            cell_size = length_sum / (T)_lines.size();
+        if (!(cell_size > 0))
+            cell_size = extent > 0 ? extent : (T)1;
+        // マス数が線分数に対して大きくなりすぎないようにする
+        const T max_cells = (T)std::max<size_t>(16 * _lines.size(), 1024);
+        while (((max_x - min_x) / cell_size + 1) * ((max_y - min_y) / cell_size + 1) > max_cells)
+            cell_size *= 2;
+
+        _cell_size = cell_size;
+        _margin = Line2D<T>::eps + extent * (T)1e-6;
+        _min_x = min_x - _margin;
+        _min_y = min_y - _margin;
+        _nx = (size_t)std::floor((max_x + _margin - _min_x) / _cell_size) + 1;
+        _ny = (size_t)std::floor((max_y + _margin - _min_y) / _cell_size) + 1;
+
+        // 各線分を外接矩形（許容誤差分だけ広げる）が重なるマスに登録する
+        _cell_start.assign(_nx * _ny + 1, 0);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            std::vector<size_t> cursor;
+            if (pass == 1)
+            {
+                for (size_t i = 1; i < _cell_start.size(); ++i)
+                    _cell_start[i] += _cell_start[i - 1];
+                _cell_items.resize(_cell_start.back());
+                cursor.assign(_cell_start.begin(), _cell_start.end() - 1);
+            }
+            for (size_t i = 0; i < _lines.size(); ++i)
+            {
+                const Line2D<T> &line = _lines[i];
+                const size_t cx0 = clampX(std::min(line.getStart().x, line.getEnd().x) - _margin);
+                const size_t cx1 = clampX(std::max(line.getStart().x, line.getEnd().x) + _margin);
+                const size_t cy0 = clampY(std::min(line.getStart().y, line.getEnd().y) - _margin);
+                const size_t cy1 = clampY(std::max(line.getStart().y, line.getEnd().y) + _margin);
+                for (size_t cy = cy0; cy <= cy1; ++cy)
+                {
+                    for (size_t cx = cx0; cx <= cx1; ++cx)
+                    {
+                        const size_t cell = cy * _nx + cx;
+                        if (pass == 0)
+                            ++_cell_start[cell + 1];
+                        else
+                            _cell_items[cursor[cell]++] = (uint32_t)i;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 登録されている線分数を返す
+     * @return 線分数
+     */
+    size_t size() const { return _lines.size(); }
+
+    /**
+     * @brief 登録されている線分を返す
+     * @return 線分群
+     */
+    const std::vector<Line2D<T>> &getLines() const { return _lines; }
+
+    /**
+     * @brief 指定点から最も近い線分を求める
+     * @details 全線分に対してLine2D::getDistanceFromPointToLineWithinRange()を計算して最小値を取った結果と一致する
+     * @param p: 指定点（座標が非有限値の場合は見つからないとする）
+     * @return 線分が存在するか, 最も近い線分の添字, その線分との距離
+     */
+    std::tuple<bool, size_t, T> getNearest(const Pose2D<T> &p) const
+    {
+        bool found = false;
+        size_t best_index = 0;
+        T best_distance = 0;
+        if (_lines.empty() || !std::isfinite(p.x) || !std::isfinite(p.y))
+            return std::make_tuple(found, best_index, best_distance);
+
+        // 指定点に最も近いグリッド内のマスから探索を始め，同心の正方形状に広げていく
+        // 指定点がグリッド外にあってもリングrのマスまでの距離は(r - 1) * cell_size以上であるため，打ち切り条件はそのまま使える
+        const long long pcx = (long long)clampX(p.x);
+        const long long pcy = (long long)clampY(p.y);
+        const long long nx = (long long)_nx, ny = (long long)_ny;
+        const long long r_end = std::max({pcx, nx - 1 - pcx, pcy, ny - 1 - pcy});
+        for (long long r = 0; r <= r_end; ++r)
+        {
+            for (long long cy = pcy - r; cy <= pcy + r; ++cy)
+            {
+                if (cy < 0 || cy >= ny)
+                    continue;
+                const bool edge_row = (cy == pcy - r || cy == pcy + r);
+                const long long step = edge_row ? 1 : 2 * r;
+                for (long long cx = pcx - r; cx <= pcx + r; cx += (step > 0 ? step : 1))
+                {
+                    if (cx < 0 || cx >= nx)
+                        continue;
+                    visitCell((size_t)cy * _nx + (size_t)cx, [&](size_t i) {
+                        const T d = Line2D<T>::getDistanceFromPointToLineWithinRange(p, _lines[i]);
+                        if (!found || d < best_distance || (d == best_distance && i < best_index))
+                        {
+                            found = true;
+                            best_index = i;
+                            best_distance = d;
+                        }
+                    });
+                }
+            }
+            // 次のリング以降のマスは指定点からr * cell_size以上離れている
+            if (found && best_distance + _margin < (T)r * _cell_size)
+                break;
+        }
+        return std::make_tuple(found, best_index, best_distance);
+    }
+
+    /**
+     * @brief 線分（レイ）と交差する線分のうち，始点に最も近い交点を求める
+     * @details 全線分に対してLine2D::getIntersectionWithinRange(segment, 各線分)を計算し，
+     *          segment.getStart()との距離が最小の交点を取った結果と一致する
+     * @param segment: 線分（レイの場合は始点をセンサ位置，終点を最大距離の点とする．座標が非有限値の場合は交差しないとする）
+     * @return 交差するか, 交差した線分の添字, 交点
+     */
+    std::tuple<bool, size_t, Pose2D<T>> getIntersection(const Line2D<T> &segment) const
+    {
+        bool found = false;
+        size_t best_index = 0;
+        T best_distance = 0;
+        Pose2D<T> best_point(0, 0, 0);
+        if (_lines.empty())
+            return std::make_tuple(found, best_index, best_point);
+
+        traverse(segment, [&](size_t cell, T exit_distance) {
+            visitCell(cell, [&](size_t i) {
+                bool is_intersected;
+                Pose2D<T> intersection;
+                std::tie(is_intersected, intersection) = Line2D<T>::getIntersectionWithinRange(segment, _lines[i]);
+                if (!is_intersected)
+                    return;
+                const T d = Pose2D<T>::getDistance(segment.getStart(), intersection);
+                if (!found || d < best_distance || (d == best_distance && i < best_index))
+                {
+                    found = true;
+                    best_index = i;
+                    best_distance = d;
+                    best_point = intersection;
+                }
+            });
+            // これ以降のマスで見つかる交点は始点からexit_distance以上離れている
+            return !(found && best_distance + _margin < exit_distance);
+        });
+        return std::make_tuple(found, best_index, best_point);
+    }
+
+    /**
+     * @brief レイが最初に当たる線分までの距離を求める
+     * @details 線分の始点と方向ベクトルを構築時に計算しておき，タプルやPose2Dを生成せずに交差判定を行う
+     *          シミュレーションしたレーザースキャンなど，多数のレイを高速に処理する場合に使用する
+     * @param ox: レイの始点のx座標
+     * @param oy: レイの始点のy座標
+     * @param dir_x: レイの方向の単位ベクトルのx成分
+     * @param dir_y: レイの方向の単位ベクトルのy成分
+     * @param max_range: 最大距離（有限値）
+     * @return 最初に当たる線分までの距離（max_range以内に当たらない場合は無限大）
+     */
+    T getRayDistance(T ox, T oy, T dir_x, T dir_y, T max_range) const
+    {
+        const T inf = std::numeric_limits<T>::infinity();
+        T best = inf;
+        if (_lines.empty())
+            return best;
+
+        const Line2D<T> segment(ox, oy, ox + dir_x * max_range, oy + dir_y * max_range);
+        traverse(segment, [&](size_t cell, T exit_distance) {
+            for (size_t k = _cell_start[cell]; k < _cell_start[cell + 1]; ++k)
+            {
+                const size_t i = _cell_items[k];
+                // o + t * dir = a + u * e を解く
+                const T denom = dir_x * _ey[i] - dir_y * _ex[i];
+                if (denom == 0)
+                    continue;
+                const T wx = _ax[i] - ox;
+                const T wy = _ay[i] - oy;
+                const T t = (wx * _ey[i] - wy * _ex[i]) / denom;
+                const T u = (wx * dir_y - wy * dir_x) / denom;
+                if (t >= 0 && t <= max_range && u >= 0 && u <= 1 && t < best)
+                    best = t;
+            }
+            return !(best + _margin < exit_distance);
+        });
+        return best;
+    }
+
+    /**
+     * @brief 指定点から半径内にある線分を求める
+     * @details Line2D::getDistanceFromPointToLineWithinRange()がradius以下の線分の添字を昇順に出力する
+     * @param p: 指定点
+     * @param radius: 半径
+     * @param out: 線分の添字の出力先（上書きされる）
+     */
+    void getWithinRadius(const Pose2D<T> &p, T radius, std::vector<size_t> &out) const
+    {
+        out.clear();
+        if (_lines.empty() || !(radius >= 0) || !std::isfinite(p.x) || !std::isfinite(p.y))
+            return;
+        const size_t cx0 = clampX(p.x - radius - _margin);
+        const size_t cx1 = clampX(p.x + radius + _margin);
+        const size_t cy0 = clampY(p.y - radius - _margin);
+        const size_t cy1 = clampY(p.y + radius + _margin);
+        for (size_t cy = cy0; cy <= cy1; ++cy)
+            for (size_t cx = cx0; cx <= cx1; ++cx)
+                visitCell(cy * _nx + cx, [&](size_t i) { out.push_back(i); });
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+
+        size_t n = 0;
+        for (size_t i : out)
+            if (Line2D<T>::getDistanceFromPointToLineWithinRange(p, _lines[i]) <= radius)
+                out[n++] = i;
+        out.resize(n);
+    }
+
+private:
+    std::vector<Line2D<T>> _lines;
+    std::vector<size_t> _cell_start;  // マス毎の_cell_itemsの開始位置（CSR形式）
+    std::vector<uint32_t> _cell_items; // マスに登録された線分の添字
+    size_t _nx = 0, _ny = 0;
+    T _min_x = 0, _min_y = 0;
+    T _cell_size = 1;
+    T _margin = 0; // 浮動小数点誤差に対する余裕
+    std::vector<T> _ax, _ay, _ex, _ey; // 線分の始点と始点から終点へのベクトル（getRayDistance()用）
+
+    // 座標をグリッド内のマスに丸める（整数へ変換する前に範囲を制限するため，非常に大きな値やNaNでも未定義動作にならない．NaNは0）
+    size_t clampX(T x) const
+    {
+        return clampCell(std::floor((x - _min_x) / _cell_size), _nx);
+    }
+
+    size_t clampY(T y) const
+    {
+        return clampCell(std::floor((y - _min_y) / _cell_size), _ny);
+    }
+
+    static size_t clampCell(T c, size_t n)
+    {
+        if (!(c > 0))
+            return 0;
+        return c < (T)(n - 1) ? (size_t)c : n - 1;
+    }
+
+    template <typename F>
+    void visitCell(size_t cell, F &&f) const
+    {
+        for (size_t k = _cell_start[cell]; k < _cell_start[cell + 1]; ++k)
+            f((size_t)_cell_items[k]);
+    }
+
+    // 線分が通過するマスを始点に近い順に訪問する（Amanatides-Wooのアルゴリズム）
+    // fはマスとそのマスを抜けるときの始点からの距離を受け取り，探索を続ける場合にtrueを返す
+    template <typename F>
+    void traverse(const Line2D<T> &segment, F &&f) const
+    {
+        const T dx = segment.getEnd().x - segment.getStart().x;
+        const T dy = segment.getEnd().y - segment.getStart().y;
+        const T length = std::sqrt(dx * dx + dy * dy);
+        if (!std::isfinite(segment.getStart().x) || !std::isfinite(segment.getStart().y) || !std::isfinite(length))
+            return; // 非有限値を含む線分はどのマスも通過しないとする
+
+        // グリッドの範囲に線分をクリップする（t: 0~1）
+        const T grid_max_x = _min_x + (T)_nx * _cell_size;
+        const T grid_max_y = _min_y + (T)_ny * _cell_size;
+        T t_min = 0, t_max = 1;
+        if (!clip(segment.getStart().x, dx, _min_x, grid_max_x, t_min, t_max) ||
+            !clip(segment.getStart().y, dy, _min_y, grid_max_y, t_min, t_max))
+            return;
+
+        const T x0 = segment.getStart().x + dx * t_min;
+        const T y0 = segment.getStart().y + dy * t_min;
+        long long cx = (long long)clampX(x0);
+        long long cy = (long long)clampY(y0);
+        const long long end_cx = (long long)clampX(segment.getStart().x + dx * t_max);
+        const long long end_cy = (long long)clampY(segment.getStart().y + dy * t_max);
+
+        const long long step_x = dx > 0 ? 1 : (dx < 0 ? -1 : 0);
+        const long long step_y = dy > 0 ? 1 : (dy < 0 ? -1 : 0);
+        const T inf = std::numeric_limits<T>::infinity();
+        const T delta_x = step_x ? _cell_size / std::abs(dx) : inf;
+        const T delta_y = step_y ? _cell_size / std::abs(dy) : inf;
+        T next_x = step_x ? ((_min_x + (T)(cx + (step_x > 0 ? 1 : 0)) * _cell_size) - segment.getStart().x) / dx : inf;
+        T next_y = step_y ? ((_min_y + (T)(cy + (step_y > 0 ? 1 : 0)) * _cell_size) - segment.getStart().y) / dy : inf;
+
+        const size_t max_steps = _nx + _ny + 2;
+        for (size_t n = 0; n < max_steps; ++n)
+        {
+            const bool is_last = (cx == end_cx && cy == end_cy);
+            const T t_exit = is_last ? (T)1 : std::min(std::min(next_x, next_y), (T)1);
+            if (!f((size_t)cy * _nx + (size_t)cx, t_exit * length) || is_last)
+                return;
+            if (next_x < next_y)
+            {
+                cx += step_x;
+                next_x += delta_x;
+            }
+            else
+            {
+                cy += step_y;
+                next_y += delta_y;
+            }
+            if (cx < 0 || cy < 0 || cx >= (long long)_nx || cy >= (long long)_ny)
+                return;
+        }
+    }
+
+    static bool clip(T p, T d, T min_v, T max_v, T &t_min, T &t_max)
+    {
+        if (d == 0)
+            return min_v <= p && p <= max_v;
+        T t0 = (min_v - p) / d;
+        T t1 = (max_v - p) / d;
+        if (t0 > t1)
+            std::swap(t0, t1);
+        t_min = std::max(t_min, t0);
+        t_max = std::min(t_max, t1);
+        return t_min <= t_max;
+    }
+};
+}
@@ -0,0 +1,358 @@
+/**
+ * @file line_extractor.h
+ * @brief スキャンの点群から直線（壁など）を抽出する
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./pose_2D.h"
+#include "./vector2_array.h"
+#include "./line_2D.h"
+#include "./line_2D_index.h"
+
+#include <limits>
+
+namespace nut_ros {
+/**
+ * @brief スキャンの点群から直線（壁など）を抽出する
+ * @details ScanProjectorで変換した点群（ビームの順に並んだもの）を先頭から順にたどり，
+ *          点の平均と2次モーメントを逐次更新する最小二乗法（主成分分析）で現在の直線に点を追加していく
+ *          点が直線から離れた，残差が大きくなった，点の間隔が空いた場合に直線を区切り，最後に隣接する同一直線上の直線を統合する
+ *          1点あたりの計算量はO(1)で，出力先などの領域は次のextract()でも使い回す
+ *          抽出した直線はassociate()でLine2DIndexの地図の線分と対応付けられる
+ * @code
+ * nut_ros::LineExtractor<float> extractor(param);
+ * projector.project(*scan_msg, robot_pose * laser_pose, points); // 地図座標系
+ * extractor.extract(points);
+ * extractor.associate(field_index, 0.2f, 0.1f);
+ * for (const auto &segment : extractor.getSegments()) { ... }
+ * @endcode
+**/
+template <typename T>
+class LineExtractor
+{
+public:
+    /**
+     * @brief パラメータ構造体
+     */
+    struct param_t
+    {
+        T max_point_distance = 0.03; /**< 直線に追加する点の直線からの最大距離[m] */
+        T max_rms = 0.01;            /**< 直線の残差の二乗平均平方根の最大値[m] */
+        T max_gap = 0.2;             /**< 直線に含める隣り合う点の最大間隔[m] */
+        size_t min_points = 8;       /**< 直線とみなす最小の点の数 */
+        T min_length = 0.2;          /**< 直線とみなす最小の長さ[m] */
+        T merge_angle = 0.05;        /**< 隣り合う直線を統合する最大の角度差[rad] */
+    };
+
+    /**
+     * @brief 抽出した直線
+     */
+    struct segment_t
+    {
+        Line2D<T> line;   /**< 直線（端点はフィッティングした直線上に射影したもの） */
+        T rms;            /**< 残差の二乗平均平方根[m] */
+        size_t first;     /**< 最初の点の添字 */
+        size_t last;      /**< 最後の点の添字 */
+        size_t map_index; /**< 対応する地図の線分の添字（associate()で設定，対応しない場合はnpos） */
+        T map_distance;   /**< 対応する地図の線分までの距離（端点の平均）[m] */
+    };
+
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief コンストラクタ
+     */
+    LineExtractor() = default;
+
+    /**
+     * @brief コンストラクタ パラメータ構造体で初期化
+     * @param param: パラメータ構造体
+     */
+    explicit LineExtractor(const param_t &param) : _param(param) {}
+
+    /**
+     * @brief パラメータの設定
+     * @param param: パラメータ構造体
+     */
+    void setParam(const param_t &param)
+    {
+        _param = param;
+    }
+
+    /**
+     * @brief パラメータの取得
+     * @return パラメータ構造体
+     */
+    const param_t &getParam() const
+    {
+        return _param;
+    }
+
+    /**
+     * @brief 点群から直線を抽出する
+     * @param points: 点群（ビームの順に並んでいること）
+     * @return 抽出した直線の数
+     */
+    size_t extract(const Vector2Array<T> &points)
+    {
+        return extract(points.x.data(), points.y.data(), points.size());
+    }
+
+    /**
+     * @brief 点群から直線を抽出する
+     * @param x: x成分の配列
+     * @param y: y成分の配列
+     * @param n: 点の数
+     * @return 抽出した直線の数
+     */
+    size_t extract(const T *x, const T *y, size_t n)
+    {
+        _segments.clear();
+        _moments.clear();
+        if (n == 0)
+            return 0;
+
+        const T max_gap2 = _param.max_gap * _param.max_gap;
+        size_t first = 0;
+        moment_t m;
+        m.add(x[0], y[0]);
+        for (size_t i = 1; i < n; ++i)
+        {
+            const T gx = x[i] - x[i - 1];
+            const T gy = y[i] - y[i - 1];
+            bool accept = gx * gx + gy * gy <= max_gap2;
+            if (accept && m.n >= 2 && m.fitted)
+                accept = std::abs(m.nx * (x[i] - m.mx) + m.ny * (y[i] - m.my)) <= _param.max_point_distance;
+            if (accept)
+            {
+                moment_t next = m;
+                next.add(x[i], y[i]);
+                if (next.n >= 3 && next.getRms() > _param.max_rms)
+                    accept = false;
+                else
+                    m = next;
+            }
+            if (!accept)
+            {
+                close(x, y, first, i - 1, m);
+                first = i;
+                m = moment_t();
+                m.add(x[i], y[i]);
+            }
+        }
+        close(x, y, first, n - 1, m);
+        merge(x, y);
+        return _segments.size();
+    }
+
+    /**
+     * @brief 抽出した直線を地図の線分と対応付ける
+     * @details 直線の中点から距離max_distance以内にある地図の線分のうち，角度差がmax_angle以下で，
+     *          直線の両端点から地図の線分（を延長した直線）までの距離の平均がmax_distance以下のものの中で最も近いものを対応付ける
+     *          直線と地図は同じ座標系であること
+     * @param map: 地図の線分のインデックス
+     * @param max_distance: 対応付ける最大距離[m]
+     * @param max_angle: 対応付ける最大の角度差[rad]（向きは区別しない）
+     * @return 対応付けられた直線の数
+     */
+    size_t associate(const Line2DIndex<T> &map, T max_distance, T max_angle)
+    {
+        const T min_cos = std::cos(max_angle);
+        size_t count = 0;
+        for (auto &segment : _segments)
+        {
+            segment.map_index = npos;
+            segment.map_distance = 0;
+            const Pose2D<T> middle((segment.line.getStart().x + segment.line.getEnd().x) / 2, (segment.line.getStart().y + segment.line.getEnd().y) / 2, 0);
+            map.getWithinRadius(middle, max_distance, _candidates);
+
+            const Vector2<T> dir = segment.line.getDirection();
+            T best = max_distance;
+            for (const size_t i : _candidates)
+            {
+                const Line2D<T> &target = map.getLines()[i];
+                const Vector2<T> target_dir = target.getDirection();
+                if (std::abs(dir.x * target_dir.x + dir.y * target_dir.y) < min_cos)
+                    continue;
+                const T distance = (Line2D<T>::getDistanceFromPointToLine(segment.line.getStart(), target) +
+                                    Line2D<T>::getDistanceFromPointToLine(segment.line.getEnd(), target)) / 2;
+                if (distance <= best)
+                {
+                    best = distance;
+                    segment.map_index = i;
+                    segment.map_distance = distance;
+                }
+            }
+            if (segment.map_index != npos)
+                ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief 抽出した直線を返す
+     * @return 直線（点の順）
+     */
+    const std::vector<segment_t> &getSegments() const
+    {
+        return _segments;
+    }
+
+private:
+    // 点群の平均と平均まわりの2次モーメント（Welfordの方法で逐次更新する）
+    struct moment_t
+    {
+        size_t n = 0;
+        T mx = 0, my = 0;
+        T sxx = 0, sxy = 0, syy = 0;
+        T nx = 0, ny = 0; // 直線の単位法線ベクトル
+        bool fitted = false;
+
+        void add(T x, T y)
+        {
+            ++n;
+            const T dx = x - mx;
+            const T dy = y - my;
+            mx += dx / (T)n;
+            my += dy / (T)n;
+            sxx += dx * (x - mx);
+            sxy += dx * (y - my);
+            syy += dy * (y - my);
+            fit();
+        }
+
+        void merge(const moment_t &m)
+        {
+            const size_t total = n + m.n;
+            const T dx = m.mx - mx;
+            const T dy = m.my - my;
+            const T w = (T)n * (T)m.n / (T)total;
+            mx += dx * (T)m.n / (T)total;
+            my += dy * (T)m.n / (T)total;
+            sxx += m.sxx + dx * dx * w;
+            sxy += m.sxy + dx * dy * w;
+            syy += m.syy + dy * dy * w;
+            n = total;
+            fit();
+        }
+
+        T getMinEigenvalue() const
+        {
+            const T half_trace = (sxx + syy) / 2;
+            const T half_diff = (sxx - syy) / 2;
+            return half_trace - std::sqrt(half_diff * half_diff + sxy * sxy);
+        }
+
+        T getRms() const
+        {
+            return n > 0 ? std::sqrt(std::max<T>(getMinEigenvalue(), 0) / (T)n) : 0;
+        }
+
+        // 最小固有値の固有ベクトルを法線とする
+        void fit()
+        {
+            const T lambda = getMinEigenvalue();
+            T ax = sxy, ay = lambda - sxx;
+            const T bx = lambda - syy, by = sxy;
+            if (ax * ax + ay * ay < bx * bx + by * by)
+            {
+                ax = bx;
+                ay = by;
+            }
+            const T norm = std::sqrt(ax * ax + ay * ay);
+            fitted = norm > std::numeric_limits<T>::min();
+            if (fitted)
+            {
+                nx = ax / norm;
+                ny = ay / norm;
+            }
+        }
+    };
+
+    param_t _param;
+    std::vector<segment_t> _segments;
+    std::vector<moment_t> _moments; // _segmentsと同じ順
+    std::vector<size_t> _candidates;
+
+    // 点first〜lastを直線として出力する（条件を満たさない場合は捨てる）
+    void close(const T *x, const T *y, size_t first, size_t last, const moment_t &m)
+    {
+        if (m.n < std::max<size_t>(_param.min_points, 2) || !m.fitted)
+            return;
+        segment_t segment;
+        if (!makeLine(x, y, first, last, m, segment.line) || segment.line.getLength() < _param.min_length)
+            return;
+        segment.rms = m.getRms();
+        segment.first = first;
+        segment.last = last;
+        segment.map_index = npos;
+        segment.map_distance = 0;
+        _segments.push_back(segment);
+        _moments.push_back(m);
+    }
+
+    // 最初と最後の点をフィッティングした直線上に射影して端点とする
+    static bool makeLine(const T *x, const T *y, size_t first, size_t last, const moment_t &m, Line2D<T> &line)
+    {
+        T dx = -m.ny, dy = m.nx;
+        if (dx * (x[last] - x[first]) + dy * (y[last] - y[first]) < 0)
+        {
+            dx = -dx;
+            dy = -dy;
+        }
+        const T t0 = dx * (x[first] - m.mx) + dy * (y[first] - m.my);
+        const T t1 = dx * (x[last] - m.mx) + dy * (y[last] - m.my);
+        line.set(m.mx + dx * t0, m.my + dy * t0, m.mx + dx * t1, m.my + dy * t1);
+        return t1 > t0;
+    }
+
+    // 隣り合う直線のうち，同一直線上にあるものを統合する
+    void merge(const T *x, const T *y)
+    {
+        if (_segments.size() < 2)
+            return;
+        const T min_cos = std::cos(_param.merge_angle);
+        const T max_gap2 = _param.max_gap * _param.max_gap;
+        size_t k = 0;
+        for (size_t i = 1; i < _segments.size(); ++i)
+        {
+            segment_t &a = _segments[k];
+            const segment_t &b = _segments[i];
+            const Vector2<T> da = a.line.getDirection(), db = b.line.getDirection();
+            const T gx = x[b.first] - x[a.last];
+            const T gy = y[b.first] - y[a.last];
+            bool merged = false;
+            if (da.x * db.x + da.y * db.y >= min_cos && gx * gx + gy * gy <= max_gap2)
+            {
+                moment_t m = _moments[k];
+                m.merge(_moments[i]);
+                Line2D<T> line;
+                if (m.fitted && m.getRms() <= _param.max_rms && isNear(m, a.line.getStart()) && isNear(m, a.line.getEnd()) &&
+                    isNear(m, b.line.getStart()) && isNear(m, b.line.getEnd()) &&
+                    makeLine(x, y, a.first, b.last, m, line))
+                {
+                    a.line = line;
+                    a.rms = m.getRms();
+                    a.last = b.last;
+                    _moments[k] = m;
+                    merged = true;
+                }
+            }
+            if (!merged)
+            {
+                ++k;
+                _segments[k] = b;
+                _moments[k] = _moments[i];
+            }
+        }
+        _segments.resize(k + 1);
+        _moments.resize(k + 1);
+    }
+
+    bool isNear(const moment_t &m, const Pose2D<T> &p) const
+    {
+        return std::abs(m.nx * (p.x - m.mx) + m.ny * (p.y - m.my)) <= _param.max_point_distance;
+    }
+};
+}
@@ -0,0 +1,541 @@
+/**
+ * @file polygon_geometry.h
+ * @brief 多角形に対する幾何計算（内外判定，重なり判定，面積，重心，凸包，ミンコフスキー和）
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./vector2.h"
+#include "./pose_2D.h"
+#include "./line_2D.h"
+#include "./vector2_array.h"
+
+namespace nut_ros {
+/**
+ * @brief 多角形に対する幾何計算（内外判定，重なり判定，面積，重心，凸包，ミンコフスキー和）
+ * @details 多角形は頂点のコンテナ（要素がx, yメンバを持つもの）で表す
+ *          std::vector<Vector2<T>>, std::vector<Pose2D<T>>, geometry_msgs::Polygon::pointsなどをそのまま渡すことができる
+ *          内部の計算はdoubleで行う
+**/
+class PolygonGeometry
+{
+public:
+    /**
+     * @brief 点が多角形の内部にあるかどうか（交差数判定）
+     * @param polygon: 多角形の頂点列（向きは問わない）
+     * @param px: 点のx座標
+     * @param py: 点のy座標
+     * @return 内部にあるかどうか（境界上の点の判定は辺の向きに依存する）
+     */
+    template <typename Points>
+    static bool isPointInside(const Points &polygon, double px, double py)
+    {
+        const size_t n = polygon.size();
+        bool inside = false;
+        for (size_t i = 0, j = n - 1; i < n; j = i++)
+        {
+            const double xi = polygon[i].x, yi = polygon[i].y;
+            const double xj = polygon[j].x, yj = polygon[j].y;
+            if ((yi > py) != (yj > py) && px < (xj - xi) * (py - yi) / (yj - yi) + xi)
+                inside = !inside;
+        }
+        return inside;
+    }
+
+    /**
+     * @brief 点が多角形の内部にあるかどうか
+     * @param polygon: 多角形の頂点列
+     * @param p: 点
+     * @return 内部にあるかどうか
+     */
+    template <typename Points, typename T>
+    static bool isPointInside(const Points &polygon, const Vector2<T> &p)
+    {
+        return isPointInside(polygon, (double)p.x, (double)p.y);
+    }
+
+    /**
+     * @brief 点が多角形の内部にあるかどうか
+     * @param polygon: 多角形の頂点列
+     * @param p: 点
+     * @return 内部にあるかどうか
+     */
+    template <typename Points, typename T>
+    static bool isPointInside(const Points &polygon, const Pose2D<T> &p)
+    {
+        return isPointInside(polygon, (double)p.x, (double)p.y);
+    }
+
+    /**
+     * @brief 多数の点が多角形の内部にあるかどうかを一括判定
+     * @details 辺の係数を一度だけ計算し，外接矩形の外の点は辺を調べずに除外する
+     * @param polygon: 多角形の頂点列
+     * @param points: 点群
+     * @param out: 各点の判定結果（1: 内部, 0: 外部，要素数は自動で合わせる）
+     * @return 内部にある点の数
+     */
+    template <typename Points, typename T>
+    static size_t isPointInside(const Points &polygon, const Vector2Array<T> &points, std::vector<uint8_t> &out)
+    {
+        out.assign(points.size(), 0);
+        edges_t edges;
+        if (!edges.set(polygon))
+            return 0;
+        size_t count = 0;
+        for (size_t k = 0; k < points.size(); ++k)
+        {
+            out[k] = edges.isInside((double)points.x[k], (double)points.y[k]);
+            count += out[k];
+        }
+        return count;
+    }
+
+    /**
+     * @brief 点群のいずれかが多角形の内部にあるかどうか（フットプリントと障害物点群の衝突判定など）
+     * @param polygon: 多角形の頂点列
+     * @param points: 点群
+     * @return 内部にある点が1つでもあるかどうか（見つかった時点で判定を打ち切る）
+     */
+    template <typename Points, typename T>
+    static bool isAnyPointInside(const Points &polygon, const Vector2Array<T> &points)
+    {
+        edges_t edges;
+        if (!edges.set(polygon))
+            return false;
+        for (size_t k = 0; k < points.size(); ++k)
+            if (edges.isInside((double)points.x[k], (double)points.y[k]))
+                return true;
+        return false;
+    }
+
+    /**
+     * @brief 符号付き面積を返す
+     * @param polygon: 多角形の頂点列
+     * @return 符号付き面積（反時計回りで正）
+     */
+    template <typename Points>
+    static double getSignedArea(const Points &polygon)
+    {
+        const size_t n = polygon.size();
+        double sum = 0;
+        for (size_t i = 0, j = n - 1; i < n; j = i++)
+            sum += (double)polygon[j].x * polygon[i].y - (double)polygon[i].x * polygon[j].y;
+        return sum / 2;
+    }
+
+    /**
+     * @brief 面積を返す
+     * @param polygon: 多角形の頂点列
+     * @return 面積
+     */
+    template <typename Points>
+    static double getArea(const Points &polygon)
+    {
+        return std::abs(getSignedArea(polygon));
+    }
+
+    /**
+     * @brief 重心を返す
+     * @param polygon: 多角形の頂点列
+     * @return 重心（面積がゼロの場合は頂点の平均）
+     */
+    template <typename Points>
+    static Vector2<double> getCentroid(const Points &polygon)
+    {
+        const size_t n = polygon.size();
+        if (n == 0)
+            return Vector2<double>(0, 0);
+        double cx = 0, cy = 0, sum = 0;
+        for (size_t i = 0, j = n - 1; i < n; j = i++)
+        {
+            const double cross = (double)polygon[j].x * polygon[i].y - (double)polygon[i].x * polygon[j].y;
+            cx += (polygon[j].x + (double)polygon[i].x) * cross;
+            cy += (polygon[j].y + (double)polygon[i].y) * cross;
+            sum += cross;
+        }
+        if (sum == 0)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                cx += polygon[i].x;
+                cy += polygon[i].y;
+            }
+            return Vector2<double>(cx / n, cy / n);
+        }
+        return Vector2<double>(cx / (3 * sum), cy / (3 * sum));
+    }
+
+    /**
+     * @brief 点群の凸包を求める（Andrewのアルゴリズム，O(n log n)）
+     * @param points: 点群（要素がx, yメンバを持つコンテナ）
+     * @param hull: 凸包の頂点の出力先（反時計回り，一直線上の頂点は除く，要素数は自動で合わせる）
+     */
+    template <typename Points, typename Out>
+    static void getConvexHull(const Points &points, Out &hull)
+    {
+        std::vector<point_t> p(points.size());
+        for (size_t i = 0; i < points.size(); ++i)
+            p[i] = {(double)points[i].x, (double)points[i].y};
+        convexHull(p);
+        output(p, hull);
+    }
+
+    /**
+     * @brief 点群の凸包を求める
+     * @param points: 点群
+     * @param hull: 凸包の頂点の出力先（反時計回り，一直線上の頂点は除く，要素数は自動で合わせる）
+     */
+    template <typename T, typename Out>
+    static void getConvexHull(const Vector2Array<T> &points, Out &hull)
+    {
+        std::vector<point_t> p(points.size());
+        for (size_t i = 0; i < points.size(); ++i)
+            p[i] = {(double)points.x[i], (double)points.y[i]};
+        convexHull(p);
+        output(p, hull);
+    }
+
+    /**
+     * @brief 外接矩形（軸平行）を求める
+     * @param polygon: 多角形の頂点列
+     * @param min_x: x座標の最小値の出力先
+     * @param min_y: y座標の最小値の出力先
+     * @param max_x: x座標の最大値の出力先
+     * @param max_y: y座標の最大値の出力先
+     * @return 頂点が存在するか（存在しない場合は出力先を変更しない）
+     */
+    template <typename Points>
+    static bool getBounds(const Points &polygon, double &min_x, double &min_y, double &max_x, double &max_y)
+    {
+        if (polygon.size() == 0)
+            return false;
+        min_x = max_x = polygon[0].x;
+        min_y = max_y = polygon[0].y;
+        for (size_t i = 1; i < polygon.size(); ++i)
+        {
+            min_x = std::min(min_x, (double)polygon[i].x);
+            max_x = std::max(max_x, (double)polygon[i].x);
+            min_y = std::min(min_y, (double)polygon[i].y);
+            max_y = std::max(max_y, (double)polygon[i].y);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 2つの凸多角形が重なっているかどうか（分離軸判定）
+     * @param a: 凸多角形1の頂点列（向きは問わない）
+     * @param b: 凸多角形2の頂点列（向きは問わない）
+     * @return 重なっているかどうか（接している場合も重なっているとする）
+     */
+    template <typename PointsA, typename PointsB>
+    static bool isOverlapping(const PointsA &a, const PointsB &b)
+    {
+        if (a.size() == 0 || b.size() == 0)
+            return false;
+        return !hasSeparatingAxis(a, b) && !hasSeparatingAxis(b, a);
+    }
+
+    /**
+     * @brief 1つの凸多角形と多数の凸多角形との重なりを一括判定
+     * @param a: 凸多角形の頂点列
+     * @param others: 凸多角形群
+     * @param out: 各多角形の判定結果（1: 重なっている, 0: 重なっていない，要素数は自動で合わせる）
+     * @return 重なっている多角形の数
+     */
+    template <typename PointsA, typename PointsB>
+    static size_t isOverlapping(const PointsA &a, const std::vector<PointsB> &others, std::vector<uint8_t> &out)
+    {
+        out.assign(others.size(), 0);
+        double min_x, min_y, max_x, max_y;
+        if (!getBounds(a, min_x, min_y, max_x, max_y))
+            return 0;
+        size_t count = 0;
+        for (size_t k = 0; k < others.size(); ++k)
+        {
+            // 外接矩形が重ならないものは分離軸を調べずに除外する
+            double bmin_x, bmin_y, bmax_x, bmax_y;
+            if (!getBounds(others[k], bmin_x, bmin_y, bmax_x, bmax_y) ||
+                bmax_x < min_x || max_x < bmin_x || bmax_y < min_y || max_y < bmin_y)
+                continue;
+            out[k] = isOverlapping(a, others[k]);
+            count += out[k];
+        }
+        return count;
+    }
+
+    /**
+     * @brief 線分と多角形が重なっているかどうか（線分が辺と交差するか，多角形の内部にある）
+     * @param polygon: 多角形の頂点列
+     * @param line: 線分
+     * @return 重なっているかどうか
+     */
+    template <typename Points, typename T>
+    static bool isOverlapping(const Points &polygon, const Line2D<T> &line)
+    {
+        const size_t n = polygon.size();
+        if (n == 0)
+            return false;
+        const point_t p1 = {(double)line.getStart().x, (double)line.getStart().y};
+        const point_t p2 = {(double)line.getEnd().x, (double)line.getEnd().y};
+        if (isPointInside(polygon, p1.x, p1.y))
+            return true;
+        for (size_t i = 0, j = n - 1; i < n; j = i++)
+        {
+            const point_t q1 = {(double)polygon[j].x, (double)polygon[j].y};
+            const point_t q2 = {(double)polygon[i].x, (double)polygon[i].y};
+            if (isSegmentIntersecting(p1, p2, q1, q2))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 多数の線分と多角形との重なりを一括判定
+     * @param polygon: 多角形の頂点列
+     * @param lines: 線分群
+     * @param out: 各線分の判定結果（1: 重なっている, 0: 重なっていない，要素数は自動で合わせる）
+     * @return 重なっている線分の数
+     */
+    template <typename Points, typename T>
+    static size_t isOverlapping(const Points &polygon, const std::vector<Line2D<T>> &lines, std::vector<uint8_t> &out)
+    {
+        out.assign(lines.size(), 0);
+        double min_x, min_y, max_x, max_y;
+        if (!getBounds(polygon, min_x, min_y, max_x, max_y))
+            return 0;
+        size_t count = 0;
+        for (size_t k = 0; k < lines.size(); ++k)
+        {
+            const Line2D<T> &line = lines[k];
+            if (std::max((double)line.getStart().x, (double)line.getEnd().x) < min_x || max_x < std::min((double)line.getStart().x, (double)line.getEnd().x) ||
+                std::max((double)line.getStart().y, (double)line.getEnd().y) < min_y || max_y < std::min((double)line.getStart().y, (double)line.getEnd().y))
+                continue;
+            out[k] = isOverlapping(polygon, line);
+            count += out[k];
+        }
+        return count;
+    }
+
+    /**
+     * @brief 2つの凸多角形のミンコフスキー和を求める（O(n + m)）
+     * @param a: 凸多角形1の頂点列（向きは問わない）
+     * @param b: 凸多角形2の頂点列（向きは問わない）
+     * @param sum: ミンコフスキー和の頂点の出力先（反時計回り，要素数は自動で合わせる）
+     */
+    template <typename PointsA, typename PointsB, typename Out>
+    static void getMinkowskiSum(const PointsA &a, const PointsB &b, Out &sum)
+    {
+        std::vector<point_t> pa = toCCW(a);
+        std::vector<point_t> pb = toCCW(b);
+        std::vector<point_t> result;
+        if (pa.empty() || pb.empty())
+        {
+            output(result, sum);
+            return;
+        }
+        rotateToLowest(pa);
+        rotateToLowest(pb);
+
+        // 両者の辺を偏角順にマージする
+        result.reserve(pa.size() + pb.size());
+        size_t i = 0, j = 0;
+        const size_t n = pa.size(), m = pb.size();
+        while (i < n || j < m)
+        {
+            result.push_back({pa[i % n].x + pb[j % m].x, pa[i % n].y + pb[j % m].y});
+            const point_t ea = {pa[(i + 1) % n].x - pa[i % n].x, pa[(i + 1) % n].y - pa[i % n].y};
+            const point_t eb = {pb[(j + 1) % m].x - pb[j % m].x, pb[(j + 1) % m].y - pb[j % m].y};
+            const double cross = ea.x * eb.y - ea.y * eb.x;
+            if (cross >= 0 && i < n)
+                ++i;
+            if (cross <= 0 && j < m)
+                ++j;
+        }
+        output(result, sum);
+    }
+
+    /**
+     * @brief 凸多角形を半径radiusだけ膨張させる（フットプリントのインフレーションなど）
+     * @details 円に外接する正多角形とのミンコフスキー和を求めるため，結果は必ず真の膨張形状を包含する
+     * @param polygon: 凸多角形の頂点列
+     * @param radius: 膨張させる距離
+     * @param inflated: 膨張後の頂点の出力先（反時計回り，要素数は自動で合わせる）
+     * @param resolution: 円を近似する頂点数（デフォルト:16）
+     */
+    template <typename Points, typename Out>
+    static void inflate(const Points &polygon, double radius, Out &inflated, int resolution = 16)
+    {
+        resolution = std::max(resolution, 3);
+        const double r = radius / std::cos(M_PI / resolution);
+        std::vector<point_t> circle(resolution);
+        for (int i = 0; i < resolution; ++i)
+            circle[i] = {r * std::cos(i * 2 * M_PI / resolution), r * std::sin(i * 2 * M_PI / resolution)};
+        getMinkowskiSum(polygon, circle, inflated);
+    }
+
+private:
+    struct point_t
+    {
+        double x, y;
+    };
+
+    // 一括判定用に辺の係数を事前計算したもの
+    struct edges_t
+    {
+        std::vector<double> y0, y1, x0, slope;
+        double min_x, min_y, max_x, max_y;
+
+        template <typename Points>
+        bool set(const Points &polygon)
+        {
+            const size_t n = polygon.size();
+            if (!getBounds(polygon, min_x, min_y, max_x, max_y))
+                return false;
+            y0.clear();
+            y1.clear();
+            x0.clear();
+            slope.clear();
+            for (size_t i = 0, j = n - 1; i < n; j = i++)
+            {
+                const double xi = polygon[i].x, yi = polygon[i].y;
+                const double xj = polygon[j].x, yj = polygon[j].y;
+                if (yi == yj)
+                    continue; // 水平な辺は交差数に影響しない
+                y0.push_back(yi);
+                y1.push_back(yj);
+                x0.push_back(xi);
+                slope.push_back((xj - xi) / (yj - yi));
+            }
+            return true;
+        }
+
+        inline uint8_t isInside(double px, double py) const
+        {
+            if (px < min_x || px > max_x || py < min_y || py > max_y)
+                return 0;
+            uint8_t inside = 0;
+            for (size_t e = 0; e < y0.size(); ++e)
+                inside ^= (uint8_t)(((y0[e] > py) != (y1[e] > py)) & (px < slope[e] * (py - y0[e]) + x0[e]));
+            return inside;
+        }
+    };
+
+    // bの各辺の法線を軸として，aとbの射影が分離しているか
+    template <typename PointsA, typename PointsB>
+    static bool hasSeparatingAxis(const PointsA &a, const PointsB &b)
+    {
+        const size_t n = b.size();
+        for (size_t i = 0, j = n - 1; i < n; j = i++)
+        {
+            const double nx = -((double)b[i].y - b[j].y);
+            const double ny = (double)b[i].x - b[j].x;
+            double a_min, a_max, b_min, b_max;
+            project(a, nx, ny, a_min, a_max);
+            project(b, nx, ny, b_min, b_max);
+            if (a_max < b_min || b_max < a_min)
+                return true;
+        }
+        return false;
+    }
+
+    template <typename Points>
+    static void project(const Points &polygon, double nx, double ny, double &min_v, double &max_v)
+    {
+        min_v = max_v = nx * polygon[0].x + ny * polygon[0].y;
+        for (size_t i = 1; i < polygon.size(); ++i)
+        {
+            const double v = nx * polygon[i].x + ny * polygon[i].y;
+            min_v = std::min(min_v, v);
+            max_v = std::max(max_v, v);
+        }
+    }
+
+    static inline double cross(const point_t &o, const point_t &a, const point_t &b)
+    {
+        return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+    }
+
+    static bool isSegmentIntersecting(const point_t &p1, const point_t &p2, const point_t &q1, const point_t &q2)
+    {
+        const double d1 = cross(q1, q2, p1);
+        const double d2 = cross(q1, q2, p2);
+        const double d3 = cross(p1, p2, q1);
+        const double d4 = cross(p1, p2, q2);
+        if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0)))
+            return true;
+        // 端点が他方の線分上にある場合
+        return (d1 == 0 && isOnSegment(q1, q2, p1)) || (d2 == 0 && isOnSegment(q1, q2, p2)) ||
+               (d3 == 0 && isOnSegment(p1, p2, q1)) || (d4 == 0 && isOnSegment(p1, p2, q2));
+    }
+
+    static inline bool isOnSegment(const point_t &a, const point_t &b, const point_t &p)
+    {
+        return std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) &&
+               std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+    }
+
+    static void convexHull(std::vector<point_t> &p)
+    {
+        std::sort(p.begin(), p.end(), [](const point_t &a, const point_t &b) {
+            return a.x < b.x || (a.x == b.x && a.y < b.y);
+        });
+        p.erase(std::unique(p.begin(), p.end(), [](const point_t &a, const point_t &b) {
+                    return a.x == b.x && a.y == b.y;
+                }),
+                p.end());
+        if (p.size() < 3)
+            return;
+
+        std::vector<point_t> hull(2 * p.size());
+        size_t k = 0;
+        // 下側
+        for (size_t i = 0; i < p.size(); ++i)
+        {
+            while (k >= 2 && cross(hull[k - 2], hull[k - 1], p[i]) <= 0)
+                --k;
+            hull[k++] = p[i];
+        }
+        // 上側
+        for (size_t i = p.size() - 1, t = k + 1; i > 0; --i)
+        {
+            while (k >= t && cross(hull[k - 2], hull[k - 1], p[i - 1]) <= 0)
+                --k;
+            hull[k++] = p[i - 1];
+        }
+        hull.resize(k - 1);
+        p.swap(hull);
+    }
+
+    template <typename Points>
+    static std::vector<point_t> toCCW(const Points &polygon)
+    {
+        std::vector<point_t> p(polygon.size());
+        for (size_t i = 0; i < polygon.size(); ++i)
+            p[i] = {(double)polygon[i].x, (double)polygon[i].y};
+        if (getSignedArea(p) < 0)
+            std::reverse(p.begin(), p.end());
+        return p;
+    }
+
+    // 最も下（同じ場合は左）の頂点が先頭になるように回転する
+    static void rotateToLowest(std::vector<point_t> &p)
+    {
+        size_t lowest = 0;
+        for (size_t i = 1; i < p.size(); ++i)
+            if (p[i].y < p[lowest].y || (p[i].y == p[lowest].y && p[i].x < p[lowest].x))
+                lowest = i;
+        std::rotate(p.begin(), p.begin() + lowest, p.end());
+    }
+
+    template <typename Out>
+    static void output(const std::vector<point_t> &p, Out &out)
+    {
+        out.resize(p.size());
+        for (size_t i = 0; i < p.size(); ++i)
+        {
+            out[i].x = static_cast<decltype(out[i].x)>(p[i].x);
+            out[i].y = static_cast<decltype(out[i].y)>(p[i].y);
+        }
+    }
+};
+}
@@ -6,16 +6,25 @@
 **/
 #pragma once
 
-#include "./../nut_generic.h"
+#include "./../nut_generic_core.h"
 #include "./vector2.h"
+#include "./rotation_2D.h"
+#include "./vec_n.h"
 
 namespace nut_ros
 {
+    // メッセージ型への変換の実装（type_handler/msg_generator.h）
+    class MsgGenerator;
+
+    template <typename T>
+    class Transform2D;
+
     /**
  * @brief 2次元の座標を扱う
+ * @details 四則演算，比較，線形補間はx, y, thetaの3要素，長さ，内積，外積，距離はx, yの2要素でVecBaseが実装する
 **/
     template <typename T>
-    class Pose2D
+    class Pose2D : public VecBase<Pose2D<T>, T, 3, 2>
     {
     public:
         T x = 0;     /**< 2次元直交座標におけるx成分 */
@@ -25,44 +34,46 @@ namespace nut_ros
         /**
      * @brief コンストラクタ
      */
-        Pose2D() = default;
+        constexpr Pose2D() = default;
 
         /**
      * @brief コンストラクタ 直交座標(_x, _y, _theta)で初期化
      */
-        Pose2D(T _x, T _y, T _theta) : x(_x), y(_y), theta(_theta) {}
+        constexpr Pose2D(T _x, T _y, T _theta) : x(_x), y(_y), theta(_theta) {}
 
         /**
      * @brief コンストラクタ Vector2と角度の数値で初期化
      */
-        Pose2D(const Vector2<T> &v, T _theta)
-        {
-            x = v.x;
-            y = v.y;
-            theta = _theta;
-        }
+        constexpr Pose2D(const Vector2<T> &v, T _theta) : x(v.x), y(v.y), theta(_theta) {}
 
         /**
      * @brief コンストラクタ 直交座標(_x, _y)で初期化（角度はゼロ）
      */
-        Pose2D(T _x, T _y) : x(_x), y(_y) {}
+        constexpr Pose2D(T _x, T _y) : x(_x), y(_y) {}
 
         /**
      * @brief コンストラクタ Vector2で初期化（角度はゼロ）
      */
-        Pose2D(const Vector2<T> &v)
+        constexpr Pose2D(const Vector2<T> &v) : x(v.x), y(v.y) {}
+
+        /**
+     * @brief 要素を返す
+     * @param i: 要素の番号（0: x, 1: y, 2: theta）
+     * @return 要素
+     */
+        constexpr T &operator[](size_t i) noexcept
         {
-            x = v.x;
-            y = v.y;
+            return i == 0 ? x : (i == 1 ? y : theta);
         }
 
         /**
-     * @brief 指定されたベクトルがこのベクトルと等しい場合にtrueを返す
-     * @param v: 指定するベクトル
+     * @brief 要素を返す
+     * @param i: 要素の番号（0: x, 1: y, 2: theta）
+     * @return 要素
      */
-        bool equals(const Pose2D &v)
+        constexpr const T &operator[](size_t i) const noexcept
         {
-            return *this == v;
+            return i == 0 ? x : (i == 1 ? y : theta);
         }
 
         /**
@@ -97,10 +108,16 @@ namespace nut_ros
      */
         void rotate(T angle)
         {
-            T tmp_x = x;
-            T tmp_y = y;
-            x = tmp_x * cos(angle) - tmp_y * sin(angle);
-            y = tmp_x * sin(angle) + tmp_y * cos(angle);
+            rotate(Rotation2D<T>(angle));
+        }
+
+        /**
+     * @brief このベクトルを原点中心に回転（角度成分は変化しない）
+     * @param rotation: 回転（cos, sinは計算済みのものを使用）
+     */
+        void rotate(const Rotation2D<T> &rotation)
+        {
+            rotation.apply(x, y);
         }
 
         /**
@@ -120,366 +137,149 @@ namespace nut_ros
      * @param o: 回転中心の座標
      * @param angle: 回転させる角度[rad]
      */
-        void rotate(Vector2<T> o, T angle)
-        {
-            Vector2<T> p(x - o.x, y - o.y);
-            p.rotate(angle);
-            p.x += o.x;
-            p.y += o.y;
-            x = p.x;
-            y = p.y;
-        }
-
-        /**
-     * @brief このベクターをフォーマットした文字列を返す
-     * @return フォーマットした文字列
-     */
-        std::string toString()
-        {
-            return '(' + std::to_string(x) + ", " + std::to_string(y) + ')';
-        }
-
-        /**
-     * @brief このベクトルの長さを返す
-     * @return このベクトルの長さ
-     */
-        T length() const
+        void rotate(const Vector2<T> &o, T angle)
         {
-            return magnitude();
+            rotate(o, Rotation2D<T>(angle));
         }
 
         /**
-     * @brief このベクトルの長さを返す
-     * @return このベクトルの長さ
+     * @brief 座標oを中心に回転（角度成分は変化しない）
+     * @param o: 回転中心の座標
+     * @param rotation: 回転（cos, sinは計算済みのものを使用）
      */
-        T magnitude() const
+        void rotate(const Vector2<T> &o, const Rotation2D<T> &rotation)
         {
-            return std::sqrt(sqrMagnitude());
+            x -= o.x;
+            y -= o.y;
+            rotation.apply(x, y);
+            x += o.x;
+            y += o.y;
         }
 
         /**
-     * @brief このベクトルの長さの2乘を返す
-     * @return このベクトルの長さ2乘
+     * @brief この座標を剛体変換（回転した後に平行移動し，角度成分に回転角度を加算）
+     * @param tf: 剛体変換（vector/transform_2D.h）
      */
-        constexpr T sqrLength() const
+        void transform(const Transform2D<T> &tf)
         {
-            return sqrMagnitude();
+            tf.apply(x, y);
+            theta += tf.rotation.getAngle();
         }
 
         /**
-     * @brief このベクトルの長さの2乘を返す
-     * @return このベクトルの長さ2乘
+     * @brief このベクターをフォーマットした文字列を返す
+     * @return フォーマットした文字列
      */
-        constexpr T sqrMagnitude() const
+        std::string toString()
         {
-            return x * x + y * y;
+            return '(' + std::to_string(x) + ", " + std::to_string(y) + ')';
         }
 
         /**
      * @brief geometry_msgs::Accel型のメッセージを返す
+     * @attention ROSに依存するためtype_handler/msg_generator.hのincludeが別途必要
      * @return geometry_msgs::Accel型のメッセージ
     **/
-        geometry_msgs::Accel toAccelMsg()
+        template <typename Generator = MsgGenerator>
+        auto toAccelMsg() const
         {
-            geometry_msgs::Accel accel;
-            accel.linear.x = (double)x;
-            accel.linear.y = (double)y;
-            accel.angular.z = (double)theta;
-            return accel;
+            return Generator::toAccel(*this);
         }
 
         /**
      * @brief geometry_msgs::Point型のメッセージを返す
+     * @attention ROSに依存するためtype_handler/msg_generator.hのincludeが別途必要
      * @return geometry_msgs::Point型のメッセージ
     **/
-        geometry_msgs::Point toPointMsg()
+        template <typename Generator = MsgGenerator>
+        auto toPointMsg() const
         {
-            geometry_msgs::Point point;
-            point.x = (double)x;
-            point.y = (double)y;
-            return point;
+            return Generator::toPoint(*this);
         }
 
         /**
      * @brief geometry_msgs::Point32型のメッセージを返す
+     * @attention ROSに依存するためtype_handler/msg_generator.hのincludeが別途必要
      * @return geometry_msgs::Point32型のメッセージ
     **/
-        geometry_msgs::Point32 toPoint32Msg()
+        template <typename Generator = MsgGenerator>
+        auto toPoint32Msg() const
         {
-            geometry_msgs::Point32 point32;
-            point32.x = (float)x;
-            point32.y = (float)y;
-            return point32;
+            return Generator::toPoint32(*this);
         }
 
         /**
      * @brief geometry_msgs::Pose型のメッセージを返す
+     * @attention ROSに依存するためtype_handler/msg_generator.hのincludeが別途必要
      * @return geometry_msgs::Pose型のメッセージ
     **/
-        geometry_msgs::Pose toPoseMsg()
+        template <typename Generator = MsgGenerator>
+        auto toPoseMsg() const
         {
-            geometry_msgs::Pose pose;
-            pose.position.x = (double)x;
-            pose.position.y = (double)y;
-            pose.orientation = tf::createQuaternionMsgFromYaw((double)theta);
-            return pose;
+            return Generator::toPose(*this);
         }
 
         /**
      * @brief geometry_msgs::Pose2D型のメッセージを返す
+     * @attention ROSに依存するためtype_handler/msg_generator.hのincludeが別途必要
      * @return geometry_msgs::Pose2D型のメッセージ
     **/
-        geometry_msgs::Pose2D toPose2DMsg()
+        template <typename Generator = MsgGenerator>
+        auto toPose2DMsg() const
         {
-            geometry_msgs::Pose2D pose2d;
-            pose2d.x = (double)x;
-            pose2d.y = (double)y;
-            pose2d.theta = (double)theta;
-            return pose2d;
+            return Generator::toPose2D(*this);
         }
 
         /**
      * @brief geometry_msgs::Quaternion型のメッセージを返す
+     * @attention ROSに依存するためtype_handler/msg_generator.hのincludeが別途必要
      * @return geometry_msgs::Quaternion型のメッセージ
     **/
-        geometry_msgs::Quaternion toQuaternionMsg()
+        template <typename Generator = MsgGenerator>
+        auto toQuaternionMsg() const
         {
-            return tf::createQuaternionMsgFromYaw((double)theta);
+            return Generator::toQuaternion(*this);
         }
 
         /**
      * @brief geometry_msgs::Transform型のメッセージを返す
+     * @attention ROSに依存するためtype_handler/msg_generator.hのincludeが別途必要
      * @return geometry_msgs::Transform型のメッセージ
     **/
-        geometry_msgs::Transform toTransformMsg()
+        template <typename Generator = MsgGenerator>
+        auto toTransformMsg() const
         {
-            geometry_msgs::Transform transform;
-            transform.translation.x = (double)x;
-            transform.translation.y = (double)y;
-            transform.rotation = tf::createQuaternionMsgFromYaw((double)theta);
-            return transform;
+            return Generator::toTransform(*this);
         }
 
         /**
      * @brief geometry_msgs::Twist型のメッセージを返す
+     * @attention ROSに依存するためtype_handler/msg_generator.hのincludeが別途必要
      * @return geometry_msgs::Twist型のメッセージ
     **/
-        geometry_msgs::Twist toTwistMsg()
+        template <typename Generator = MsgGenerator>
+        auto toTwistMsg() const
         {
-            geometry_msgs::Twist twist;
-            twist.linear.x = (double)x;
-            twist.linear.y = (double)y;
-            twist.angular.z = (double)theta;
-            return twist;
+            return Generator::toTwist(*this);
         }
 
         /**
      * @brief geometry_msgs::Vector3型のメッセージを返す
      * @details vector3のx,y,zはPose2Dのx,y,thetaに対応して格納される
+     * @attention ROSに依存するためtype_handler/msg_generator.hのincludeが別途必要
      * @return geometry_msgs::Vector3型のメッセージ
     **/
-        geometry_msgs::Vector3 toVector3Msg()
-        {
-            geometry_msgs::Vector3 vector3;
-            vector3.x = (double)x;
-            vector3.y = (double)y;
-            vector3.z = (double)theta;
-            return vector3;
-        }
-
-        /**
-     * @brief 2つのベクトルの内積を返す
-     * @param a: 1つ目のベクトル
-     * @param b: 2つ目のベクトル
-     * @return 2つのベクトルの内積
-     */
-        static T getDot(Pose2D a, Pose2D b)
-        {
-            return (a.x * b.x + a.y * b.y);
-        }
-
-        /**
-     * @brief 2つのベクトルの外積の大きさを返す
-     * @param a: 1つ目のベクトル
-     * @param b: 2つ目のベクトル
-     * @return 2つのベクトルの外積の大きさ
-     */
-        static T getCross(Pose2D a, Pose2D b)
-        {
-            return (a.x * b.y - a.y * b.x);
-        }
-
-        /**
-     * @brief 2つのベクトルのなす角を弧度法で返す
-     * @param a: 1つ目のベクトル
-     * @param b: 2つ目のベクトル
-     * @return 2つのベクトルのなす角[rad]
-     */
-        static T getAngle(Pose2D a, Pose2D b)
+        template <typename Generator = MsgGenerator>
+        auto toVector3Msg() const
         {
-            return std::atan2(b.y - a.y, b.x - a.x);
+            return Generator::toVector3(*this);
         }
 
-        /**
-     * @brief 2つのベクトルの距離を返す
-     * @param a: 1つ目のベクトル
-     * @param b: 2つ目のベクトル
-     * @return 2つのベクトルの距離を返す
-     */
-        static T getDistance(Pose2D a, Pose2D b)
-        {
-            Pose2D v = (b - a);
-            return v.magnitude();
-        }
-
-    /**
-     * @brief ベクトルaとbの間をtで線形補間
-     * @param a: 1つ目のベクトル
-     * @param b: 2つ目のベクトル
-     * @param t: 媒介変数
-     * @return 補間点
-     */
-    static Pose2D lerp(Pose2D a, Pose2D b, T t)
-    {
-        t = Generic::guard(t, 0.0, 1.0);
-        Pose2D v = a;
-        v.x += (b.x - a.x) * t;
-        v.y += (b.y - a.y) * t;
-        v.theta += (b.theta - a.theta) * t;
-        return v;
-    }
-
-    /**
-     * @brief ベクトルaとbの中点を返す
-     * @param a: 1つ目のベクトル
-     * @param b: 2つ目のベクトル
-     * @return 中点
-     */
-    static Pose2D getMidpoint(Pose2D a, Pose2D b)
-    {
-        return lerp(a, b, 0.5);
-    }
-
         /**
      * @brief ベクトルの代入
+     * @details トリビアルコピー可能な型に保つためdefaultとする（LatestValueなどで使用）
      */
-        Pose2D &operator=(const Pose2D &v)
-        {
-            x = v.x;
-            y = v.y;
-            theta = v.theta;
-            return *this;
-        }
-
-        /**
-     * @brief 全ての要素にスカラ加算
-     */
-        constexpr Pose2D operator+() const
-        {
-            return *this;
-        }
-
-        /**
-     * @brief 全ての要素にスカラ減算
-     */
-        constexpr Pose2D operator-() const
-        {
-            return {-x, -y, -theta};
-        }
-
-        /**
-     * @brief ベクトルの要素同士の和
-     */
-        constexpr Pose2D operator+(const Pose2D &v) const
-        {
-            return {x + v.x, y + v.y, theta + v.theta};
-        }
-
-        /**
-     * @brief ベクトルの要素同士の差
-     */
-        constexpr Pose2D operator-(const Pose2D &v) const
-        {
-            return {x - v.x, y - v.y, theta - v.theta};
-        }
-
-        /**
-     * @brief 全ての要素にスカラ乗算
-     * @attention ベクトル同士の乗算は未定義，内積の計算はgetDot()を使用
-     */
-        constexpr Pose2D operator*(T s) const
-        {
-            return {x * s, y * s, theta * s};
-        }
-
-        /**
-     * @brief 全ての要素にスカラ除算
-     * @attention ベクトル同士の除算は未定義
-     */
-        constexpr Pose2D operator/(T s) const
-        {
-            return {x / s, y / s, theta / s};
-        }
-
-        /**
-     * @brief ベクトルの要素同士の和を代入（スカラとの和の場合は全ての要素に対して加算）
-     */
-        Pose2D &operator+=(const Pose2D &v)
-        {
-            x += v.x;
-            y += v.y;
-            theta += v.theta;
-            return *this;
-        }
-
-        /**
-     * @brief ベクトルの要素同士の差を代入（スカラとの和の場合は全ての要素に対して減算）
-     */
-        Pose2D &operator-=(const Pose2D &v)
-        {
-            x -= v.x;
-            y -= v.y;
-            theta -= v.theta;
-            return *this;
-        }
-
-        /**
-     * @brief 全ての要素に対してスカラ乗算して代入（ベクトル同士の乗算は未定義）
-     */
-        Pose2D &operator*=(T s)
-        {
-            x *= s;
-            y *= s;
-            theta *= s;
-            return *this;
-        }
-
-        /**
-     * @brief 全ての要素に対してスカラ除算して代入（ベクトル同士の除算は未定義）
-     */
-        Pose2D &operator/=(T s)
-        {
-            x /= s;
-            y /= s;
-            theta /= s;
-            return *this;
-        }
-
-        /**
-     * @brief 2つのベクトルが等しい場合にtrueを返す
-     */
-        bool operator==(const Pose2D &v) const
-        {
-            return ((x == v.x) && (y == v.y) && (theta == v.y));
-        }
-
-        /**
-     * @brief 2つのベクトルが等しい場合にfalseを返す
-     */
-        bool operator!=(const Pose2D &v) const
-        {
-            return !((x == v.x) && (y == v.y) && (theta == v.y));
-        }
+        Pose2D &operator=(const Pose2D &v) = default;
 
     private:
     };
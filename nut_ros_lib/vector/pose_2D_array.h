@@ -0,0 +1,203 @@
+/**
+ * @file pose_2D_array.h
+ * @brief 2次元の座標の配列（SoA）
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./array_kernel.h"
+#include "./vector2.h"
+#include "./pose_2D.h"
+#include "./rotation_2D.h"
+#include "./transform_2D.h"
+
+namespace nut_ros {
+/**
+ * @brief 2次元の座標の配列（SoA）
+ * @details x, y, theta成分を別々の配列で保持し，多数の座標に対する一括演算をSIMDで行う
+**/
+template <typename T>
+class Pose2DArray
+{
+public:
+    std::vector<T> x;     /**< x成分の配列 */
+    std::vector<T> y;     /**< y成分の配列 */
+    std::vector<T> theta; /**< 角度（向き）成分の配列 [rad] */
+
+    /**
+     * @brief コンストラクタ
+     */
+    Pose2DArray() = default;
+
+    /**
+     * @brief コンストラクタ 要素数を指定して初期化（全要素ゼロ）
+     * @param n: 要素数
+     */
+    explicit Pose2DArray(size_t n) : x(n), y(n), theta(n) {}
+
+    /**
+     * @brief 要素数を返す
+     * @return 要素数
+     */
+    size_t size() const
+    {
+        return x.size();
+    }
+
+    /**
+     * @brief 要素が空かどうか
+     * @return 要素が空かどうか
+     */
+    bool empty() const
+    {
+        return x.empty();
+    }
+
+    /**
+     * @brief 要素数を変更する
+     * @param n: 要素数
+     */
+    void resize(size_t n)
+    {
+        x.resize(n);
+        y.resize(n);
+        theta.resize(n);
+    }
+
+    /**
+     * @brief 領域を予約する
+     * @param n: 予約する要素数
+     */
+    void reserve(size_t n)
+    {
+        x.reserve(n);
+        y.reserve(n);
+        theta.reserve(n);
+    }
+
+    /**
+     * @brief 全ての要素を削除する（確保済みの領域は保持される）
+     */
+    void clear()
+    {
+        x.clear();
+        y.clear();
+        theta.clear();
+    }
+
+    /**
+     * @brief 要素を末尾に追加する
+     * @param pose: 追加する座標
+     */
+    void push_back(const Pose2D<T> &pose)
+    {
+        x.push_back(pose.x);
+        y.push_back(pose.y);
+        theta.push_back(pose.theta);
+    }
+
+    /**
+     * @brief i番目の要素を設定する
+     * @param i: 添字
+     * @param pose: 設定する座標
+     */
+    void set(size_t i, const Pose2D<T> &pose)
+    {
+        x[i] = pose.x;
+        y[i] = pose.y;
+        theta[i] = pose.theta;
+    }
+
+    /**
+     * @brief i番目の要素を返す
+     * @param i: 添字
+     * @return i番目の要素
+     */
+    Pose2D<T> get(size_t i) const
+    {
+        return Pose2D<T>(x[i], y[i], theta[i]);
+    }
+
+    /**
+     * @brief 全ての要素の位置を原点中心にangle[rad]回転（Pose2D::rotate()と同様に角度成分は変化しない）
+     * @param angle: 回転させる角度[rad]
+     */
+    void rotate(T angle)
+    {
+        ArrayKernel::transform(x.data(), y.data(), size(), (T)std::cos(angle), (T)std::sin(angle), (T)0, (T)0);
+    }
+
+    /**
+     * @brief 全ての要素を原点中心に回転
+     * @param rotation: 回転（cos, sinは計算済みのものを使用）
+     */
+    void rotate(const Rotation2D<T> &rotation)
+    {
+        ArrayKernel::transform(x.data(), y.data(), size(), rotation.cos(), rotation.sin(), (T)0, (T)0);
+    }
+
+    /**
+     * @brief 全ての要素を平行移動
+     * @param v: 平行移動量
+     */
+    void translate(const Vector2<T> &v)
+    {
+        ArrayKernel::add(x.data(), size(), v.x);
+        ArrayKernel::add(y.data(), size(), v.y);
+    }
+
+    /**
+     * @brief 全ての要素を剛体変換（pose.thetaだけ回転した後に(pose.x, pose.y)だけ平行移動し，角度成分にpose.thetaを加算）
+     * @param pose: 座標変換（ロボットの位置姿勢など）
+     * @attention 角度成分の正規化は行わない
+     */
+    void transform(const Pose2D<T> &pose)
+    {
+        ArrayKernel::transform(x.data(), y.data(), size(), (T)std::cos(pose.theta), (T)std::sin(pose.theta), pose.x, pose.y);
+        ArrayKernel::add(theta.data(), size(), pose.theta);
+    }
+
+    /**
+     * @brief 全ての要素を剛体変換
+     * @param tf: 剛体変換
+     */
+    void transform(const Transform2D<T> &tf)
+    {
+        ArrayKernel::transform(x.data(), y.data(), size(), tf.rotation.cos(), tf.rotation.sin(), tf.translation.x, tf.translation.y);
+        ArrayKernel::add(theta.data(), size(), tf.rotation.getAngle());
+    }
+
+    /**
+     * @brief 全ての要素と指定点との距離を求める
+     * @param p: 指定点
+     * @param out: 距離の出力先（要素数は自動で合わせる）
+     */
+    void getDistance(const Vector2<T> &p, std::vector<T> &out) const
+    {
+        out.resize(size());
+        ArrayKernel::distance(x.data(), y.data(), size(), p.x, p.y, out.data());
+    }
+
+    /**
+     * @brief 全ての要素の位置と指定ベクトルとの内積を求める
+     * @param v: 指定ベクトル
+     * @param out: 内積の出力先（要素数は自動で合わせる）
+     */
+    void getDot(const Vector2<T> &v, std::vector<T> &out) const
+    {
+        out.resize(size());
+        ArrayKernel::dot(x.data(), y.data(), size(), v.x, v.y, out.data());
+    }
+
+    /**
+     * @brief 全ての要素の位置と指定ベクトルとの外積の大きさを求める
+     * @param v: 指定ベクトル
+     * @param out: 外積の出力先（要素数は自動で合わせる）
+     */
+    void getCross(const Vector2<T> &v, std::vector<T> &out) const
+    {
+        out.resize(size());
+        ArrayKernel::cross(x.data(), y.data(), size(), v.x, v.y, out.data());
+    }
+};
+}
@@ -0,0 +1,104 @@
+/**
+ * @file ray_caster.h
+ * @brief 線分の地図に対するレイキャストでレーザースキャンをシミュレーションする
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./pose_2D.h"
+#include "./line_2D_index.h"
+#include "./../realtime/thread_pool.h"
+
+namespace nut_ros {
+/**
+ * @brief 線分の地図に対するレイキャストでレーザースキャンをシミュレーションする
+ * @details 地図はLine2DIndexの他，同じ形式のgetRayDistance()を持つOccupancyGridViewも使用できる
+ *          レイの相対角度のcos, sinは生成時に一度だけ計算し，センサの向きの分だけ回転して使用する
+ *          出力はsensor_msgs::LaserScan::rangesと同じstd::vector<float>で，当たらないレイは無限大となる
+ * @code
+ * nut_ros::RayCaster<double> caster(scan.angle_min, scan.angle_increment, scan.ranges.size(), scan.range_max);
+ * caster.cast(index, sensor_pose, expected_scan.ranges);
+ * @endcode
+**/
+template <typename T>
+class RayCaster
+{
+public:
+    /**
+     * @brief コンストラクタ
+     * @param angle_min: 最初のレイの角度[rad]（センサ座標系）
+     * @param angle_increment: レイの角度の間隔[rad]
+     * @param count: レイの本数
+     * @param range_max: 最大距離
+     */
+    RayCaster(T angle_min, T angle_increment, size_t count, T range_max)
+        : _range_max(range_max), _cos(count), _sin(count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const T angle = angle_min + angle_increment * (T)i;
+            _cos[i] = std::cos(angle);
+            _sin[i] = std::sin(angle);
+        }
+    }
+
+    /**
+     * @brief レイの本数を返す
+     * @return レイの本数
+     */
+    size_t size() const { return _cos.size(); }
+
+    /**
+     * @brief 1つのセンサ位置からのスキャンをシミュレーション
+     * @param index: 地図（Line2DIndex, OccupancyGridViewなどgetRayDistance()を持つ型）
+     * @param pose: センサの位置姿勢（地図座標系）
+     * @param ranges: 各レイの距離の出力先（要素数は自動で合わせる）
+     */
+    template <class Map>
+    void cast(const Map &index, const Pose2D<T> &pose, std::vector<float> &ranges) const
+    {
+        ranges.resize(size());
+        cast(index, pose, ranges.data());
+    }
+
+    /**
+     * @brief 1つのセンサ位置からのスキャンをシミュレーション
+     * @param index: 地図（Line2DIndex, OccupancyGridViewなどgetRayDistance()を持つ型）
+     * @param pose: センサの位置姿勢（地図座標系）
+     * @param ranges: 各レイの距離の出力先（size()個の領域が必要）
+     */
+    template <class Map>
+    void cast(const Map &index, const Pose2D<T> &pose, float *ranges) const
+    {
+        const T c = std::cos(pose.theta);
+        const T s = std::sin(pose.theta);
+        for (size_t i = 0; i < size(); ++i)
+        {
+            const T dir_x = c * _cos[i] - s * _sin[i];
+            const T dir_y = s * _cos[i] + c * _sin[i];
+            ranges[i] = (float)index.getRayDistance(pose.x, pose.y, dir_x, dir_y, _range_max);
+        }
+    }
+
+    /**
+     * @brief 複数のセンサ位置（パーティクルなど）からのスキャンを並列にシミュレーション
+     * @param index: 地図（Line2DIndex, OccupancyGridViewなどgetRayDistance()を持つ型）
+     * @param poses: センサの位置姿勢（地図座標系）
+     * @param ranges: 各レイの距離の出力先（poses.size() * size()個，i番目の位置のj番目のレイは[i * size() + j]）
+     * @param pool: 並列処理に使用するスレッドプール（呼び出しごとのスレッドの生成は行わない）
+     */
+    template <class Map>
+    void cast(const Map &index, const std::vector<Pose2D<T>> &poses, std::vector<float> &ranges, ThreadPool &pool) const
+    {
+        ranges.resize(poses.size() * size());
+        pool.parallelFor(poses.size(), [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                cast(index, poses[i], ranges.data() + i * size());
+        });
+    }
+
+private:
+    T _range_max;
+    std::vector<T> _cos, _sin;
+};
+}
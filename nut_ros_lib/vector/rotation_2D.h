@@ -0,0 +1,106 @@
+/**
+ * @file rotation_2D.h
+ * @brief 2次元の回転を扱う
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+
+namespace nut_ros {
+/**
+ * @brief 2次元の回転を扱う
+ * @details 生成時にcos, sinを一度だけ計算して保持するため，同じ角度で多数の点を回転させる場合に三角関数の再計算が不要になる
+**/
+template <typename T>
+class Rotation2D
+{
+public:
+    /**
+     * @brief コンストラクタ（回転なし）
+     */
+    constexpr Rotation2D() : _angle(0), _cos(1), _sin(0) {}
+
+    /**
+     * @brief コンストラクタ 回転角度で初期化
+     * @param angle: 回転角度[rad]
+     */
+    explicit Rotation2D(T angle) : _angle(angle), _cos(std::cos(angle)), _sin(std::sin(angle)) {}
+
+    /**
+     * @brief 回転角度を設定
+     * @param angle: 回転角度[rad]
+     */
+    void set(T angle)
+    {
+        _angle = angle;
+        _cos = std::cos(angle);
+        _sin = std::sin(angle);
+    }
+
+    /**
+     * @brief 回転角度を返す
+     * @return 回転角度[rad]（合成した場合は各角度の和）
+     */
+    constexpr T getAngle() const { return _angle; }
+
+    /**
+     * @brief 回転角度のcosを返す
+     * @return 回転角度のcos
+     */
+    constexpr T cos() const { return _cos; }
+
+    /**
+     * @brief 回転角度のsinを返す
+     * @return 回転角度のsin
+     */
+    constexpr T sin() const { return _sin; }
+
+    /**
+     * @brief 逆回転を返す
+     * @return 逆回転
+     */
+    constexpr Rotation2D inverse() const
+    {
+        return Rotation2D(-_angle, _cos, -_sin);
+    }
+
+    /**
+     * @brief 座標(x, y)を原点中心に回転
+     * @param x: x座標（入出力）
+     * @param y: y座標（入出力）
+     */
+    template <typename U>
+    void apply(U &x, U &y) const
+    {
+        const U tmp_x = x;
+        const U tmp_y = y;
+        x = (U)(_cos * tmp_x - _sin * tmp_y);
+        y = (U)(_sin * tmp_x + _cos * tmp_y);
+    }
+
+    /**
+     * @brief 回転の合成（rを適用した後にこの回転を適用する回転）
+     * @details 三角関数は再計算せず加法定理で求める
+     */
+    constexpr Rotation2D operator*(const Rotation2D &r) const
+    {
+        return Rotation2D(_angle + r._angle, _cos * r._cos - _sin * r._sin, _sin * r._cos + _cos * r._sin);
+    }
+
+    /**
+     * @brief 回転の合成を代入
+     */
+    Rotation2D &operator*=(const Rotation2D &r)
+    {
+        *this = *this * r;
+        return *this;
+    }
+
+private:
+    T _angle;
+    T _cos;
+    T _sin;
+
+    constexpr Rotation2D(T angle, T c, T s) : _angle(angle), _cos(c), _sin(s) {}
+};
+}
@@ -0,0 +1,158 @@
+/**
+ * @file scan_projector.h
+ * @brief レーザースキャンを直交座標の点群（Vector2Array）に変換する
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./array_kernel.h"
+#include "./pose_2D.h"
+#include "./vector2_array.h"
+
+namespace nut_ros {
+/**
+ * @brief レーザースキャンを直交座標の点群（Vector2Array）に変換する
+ * @details 各ビームの角度のcos, sinの表を(angle_min, angle_increment, 本数)ごとに一度だけ計算して保持し，
+ *          変換時は距離の配列との積和のみを行う（ArrayKernel::polarToCartesian()によりSIMDで計算）
+ *          range_min以上range_max以下の距離のみを出力し（範囲の判定は変換と同じループで行う），センサの位置姿勢による座標変換も同時に適用する
+ *          出力先のVector2Arrayは使い回すことで，スキャンごとの領域の確保を避けられる
+ * @code
+ * nut_ros::ScanProjector<float> projector;
+ * nut_ros::Vector2Array<float> points;
+ * // スキャンを受信するたび
+ * projector.project(*scan_msg, laser_pose, points);
+ * @endcode
+**/
+template <typename T>
+class ScanProjector
+{
+public:
+    /**
+     * @brief コンストラクタ
+     */
+    ScanProjector() = default;
+
+    /**
+     * @brief コンストラクタ ビームの角度で初期化
+     * @param angle_min: 最初のビームの角度[rad]（センサ座標系）
+     * @param angle_increment: ビームの角度の間隔[rad]
+     * @param count: ビームの本数
+     */
+    ScanProjector(T angle_min, T angle_increment, size_t count)
+    {
+        setAngles(angle_min, angle_increment, count);
+    }
+
+    /**
+     * @brief ビームの角度を設定する
+     * @details 前回と同じ場合は表を計算し直さない
+     * @param angle_min: 最初のビームの角度[rad]（センサ座標系）
+     * @param angle_increment: ビームの角度の間隔[rad]
+     * @param count: ビームの本数
+     * @return 表を計算し直したかどうか
+     */
+    bool setAngles(T angle_min, T angle_increment, size_t count)
+    {
+        if (angle_min == _angle_min && angle_increment == _angle_increment && count == _cos.size())
+            return false;
+        _angle_min = angle_min;
+        _angle_increment = angle_increment;
+        _cos.resize(count);
+        _sin.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const double angle = (double)angle_min + (double)angle_increment * (double)i;
+            _cos[i] = (T)std::cos(angle);
+            _sin[i] = (T)std::sin(angle);
+        }
+        return true;
+    }
+
+    /**
+     * @brief スキャンをセンサ座標系の点群に変換する
+     * @param scan: sensor_msgs::LaserScan（angle_min, angle_increment, range_min, range_max, rangesを持つ型）
+     * @param points: 点群の出力先（有効な距離のビームのみ）
+     * @param indices: 各点の元のビームの番号の出力先（nullptrの場合は出力しない）
+     * @return 点の数
+     */
+    template <class Scan>
+    size_t project(const Scan &scan, Vector2Array<T> &points, std::vector<uint32_t> *indices = nullptr)
+    {
+        return project(scan, Pose2D<T>(0, 0, 0), points, indices);
+    }
+
+    /**
+     * @brief スキャンを点群に変換し，センサの位置姿勢で座標変換する
+     * @param scan: sensor_msgs::LaserScan（angle_min, angle_increment, range_min, range_max, rangesを持つ型）
+     * @param pose: センサの位置姿勢（出力する座標系での）
+     * @param points: 点群の出力先（有効な距離のビームのみ）
+     * @param indices: 各点の元のビームの番号の出力先（nullptrの場合は出力しない）
+     * @return 点の数
+     */
+    template <class Scan>
+    size_t project(const Scan &scan, const Pose2D<T> &pose, Vector2Array<T> &points, std::vector<uint32_t> *indices = nullptr)
+    {
+        setAngles((T)scan.angle_min, (T)scan.angle_increment, scan.ranges.size());
+        return project(scan.ranges.data(), scan.ranges.size(), (T)scan.range_min, (T)scan.range_max, pose, points, indices);
+    }
+
+    /**
+     * @brief 距離の配列を点群に変換し，センサの位置姿勢で座標変換する
+     * @param ranges: 各ビームの距離
+     * @param n: ビームの本数（setAngles()で設定した本数と同じであること）
+     * @param range_min: 有効な距離の最小値
+     * @param range_max: 有効な距離の最大値
+     * @param pose: センサの位置姿勢（出力する座標系での）
+     * @param points: 点群の出力先（有効な距離のビームのみ）
+     * @param indices: 各点の元のビームの番号の出力先（nullptrの場合は出力しない）
+     * @return 点の数
+     */
+    size_t project(const float *ranges, size_t n, T range_min, T range_max, const Pose2D<T> &pose,
+                   Vector2Array<T> &points, std::vector<uint32_t> *indices = nullptr) const
+    {
+        n = std::min(n, _cos.size());
+        points.resize(n);
+        if (indices)
+            indices->resize(n);
+        const size_t count = ArrayKernel::polarToCartesian(ranges, _cos.data(), _sin.data(), n, range_min, range_max,
+                                                           (T)std::cos(pose.theta), (T)std::sin(pose.theta), pose.x, pose.y,
+                                                           points.x.data(), points.y.data(), indices ? indices->data() : nullptr);
+        points.resize(count);
+        if (indices)
+            indices->resize(count);
+        return count;
+    }
+
+    /**
+     * @brief ビームの本数を返す
+     * @return ビームの本数
+     */
+    size_t size() const
+    {
+        return _cos.size();
+    }
+
+    /**
+     * @brief 各ビームの角度のcosの表を返す
+     * @return cosの表
+     */
+    const std::vector<T> &getCosTable() const
+    {
+        return _cos;
+    }
+
+    /**
+     * @brief 各ビームの角度のsinの表を返す
+     * @return sinの表
+     */
+    const std::vector<T> &getSinTable() const
+    {
+        return _sin;
+    }
+
+private:
+    T _angle_min = 0;
+    T _angle_increment = 0;
+    std::vector<T> _cos, _sin;
+};
+}
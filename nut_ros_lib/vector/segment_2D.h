@@ -0,0 +1,57 @@
+/**
+ * @file segment_2D.h
+ * @brief 大量に保持するための省メモリな2次元の線分
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./vector2.h"
+
+namespace nut_ros {
+/**
+ * @brief 大量に保持するための省メモリな2次元の線分
+ * @details 始点と終点の座標のみを保持する（Line2Dのような角度成分や事前計算した係数は持たない）
+ *          地図の線分群などの保存用で，計算にはLine2Dに変換して使用する
+**/
+template <typename T>
+struct Segment2D
+{
+    T x1 = 0; /**< 始点のx座標 */
+    T y1 = 0; /**< 始点のy座標 */
+    T x2 = 0; /**< 終点のx座標 */
+    T y2 = 0; /**< 終点のy座標 */
+
+    /**
+     * @brief コンストラクタ
+     */
+    Segment2D() = default;
+
+    /**
+     * @brief コンストラクタ 直交座標で初期化
+     * @param _x1: 始点のx座標
+     * @param _y1: 始点のy座標
+     * @param _x2: 終点のx座標
+     * @param _y2: 終点のy座標
+     */
+    constexpr Segment2D(T _x1, T _y1, T _x2, T _y2) : x1(_x1), y1(_y1), x2(_x2), y2(_y2) {}
+
+    /**
+     * @brief コンストラクタ Vector2で初期化
+     * @param start: 始点
+     * @param end: 終点
+     */
+    Segment2D(const Vector2<T> &start, const Vector2<T> &end) : x1(start.x), y1(start.y), x2(end.x), y2(end.y) {}
+
+    /**
+     * @brief 始点を返す
+     * @return 始点
+     */
+    Vector2<T> getStart() const { return Vector2<T>(x1, y1); }
+
+    /**
+     * @brief 終点を返す
+     * @return 終点
+     */
+    Vector2<T> getEnd() const { return Vector2<T>(x2, y2); }
+};
+}
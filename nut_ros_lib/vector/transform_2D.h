@@ -0,0 +1,121 @@
+/**
+ * @file transform_2D.h
+ * @brief 2次元の剛体変換（SE2）を扱う
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./rotation_2D.h"
+#include "./vector2.h"
+#include "./pose_2D.h"
+
+namespace nut_ros {
+/**
+ * @brief 2次元の剛体変換（SE2）を扱う
+ * @details 点pに対してR*p + tを計算する．回転のcos, sinは生成時に一度だけ計算される
+**/
+template <typename T>
+class Transform2D
+{
+public:
+    Rotation2D<T> rotation; /**< 回転成分 */
+    Vector2<T> translation; /**< 並進成分 */
+
+    /**
+     * @brief コンストラクタ（恒等変換）
+     */
+    Transform2D() = default;
+
+    /**
+     * @brief コンストラクタ 回転と並進で初期化
+     * @param _rotation: 回転成分
+     * @param _translation: 並進成分
+     */
+    Transform2D(const Rotation2D<T> &_rotation, const Vector2<T> &_translation)
+        : rotation(_rotation), translation(_translation) {}
+
+    /**
+     * @brief コンストラクタ 座標(x, y, theta)で初期化
+     * @details thetaだけ回転した後に(x, y)だけ平行移動する変換となる（poseの座標系からその親座標系への変換）
+     * @param pose: 座標
+     */
+    explicit Transform2D(const Pose2D<T> &pose)
+        : rotation(pose.theta), translation(pose.x, pose.y) {}
+
+    /**
+     * @brief 変換をPose2Dで返す
+     * @return 変換を表すPose2D（x, y, theta）
+     */
+    Pose2D<T> toPose2D() const
+    {
+        return Pose2D<T>(translation.x, translation.y, rotation.getAngle());
+    }
+
+    /**
+     * @brief 座標(x, y)を変換
+     * @param x: x座標（入出力）
+     * @param y: y座標（入出力）
+     */
+    template <typename U>
+    void apply(U &x, U &y) const
+    {
+        rotation.apply(x, y);
+        x += (U)translation.x;
+        y += (U)translation.y;
+    }
+
+    /**
+     * @brief 逆変換を返す
+     * @return 逆変換
+     */
+    Transform2D inverse() const
+    {
+        Transform2D inv;
+        inv.rotation = rotation.inverse();
+        inv.translation = -translation;
+        inv.rotation.apply(inv.translation.x, inv.translation.y);
+        return inv;
+    }
+
+    /**
+     * @brief 変換の合成（tfを適用した後にこの変換を適用する変換）
+     */
+    Transform2D operator*(const Transform2D &tf) const
+    {
+        Transform2D result;
+        result.rotation = rotation * tf.rotation;
+        result.translation = tf.translation;
+        apply(result.translation.x, result.translation.y);
+        return result;
+    }
+
+    /**
+     * @brief 変換の合成を代入
+     */
+    Transform2D &operator*=(const Transform2D &tf)
+    {
+        *this = *this * tf;
+        return *this;
+    }
+
+    /**
+     * @brief ベクトルを変換
+     */
+    Vector2<T> operator*(const Vector2<T> &v) const
+    {
+        Vector2<T> result = v;
+        apply(result.x, result.y);
+        return result;
+    }
+
+    /**
+     * @brief 座標を変換（角度成分には回転角度が加算される）
+     */
+    Pose2D<T> operator*(const Pose2D<T> &pose) const
+    {
+        Pose2D<T> result(pose.x, pose.y, pose.theta + rotation.getAngle());
+        apply(result.x, result.y);
+        return result;
+    }
+};
+}
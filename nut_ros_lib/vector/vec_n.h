@@ -0,0 +1,367 @@
+/**
+ * @file vec_n.h
+ * @brief 要素数が固定のベクトルの共通の演算（Vector2, Pose2D, Vector3の基底）
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+
+namespace nut_ros {
+/**
+ * @brief 要素数が固定のベクトルの共通の演算（CRTP）
+ * @details 派生クラスはoperator[]で各要素を返すだけでよく，四則演算，比較，内積，距離，線形補間などをここで一度だけ実装する
+ *          要素数はコンパイル時に決まるため，ループは全て展開されてx, yなどのメンバを直接扱うコードになる（一時オブジェクトも残らない）
+ *          sqrt, atan2を使用しない演算は全てconstexprで，コンパイル時に座標のテーブルを計算できる
+ * @tparam Derived: 派生クラス（Vector2<T>など）
+ * @tparam T: 要素の型
+ * @tparam N: 要素数（四則演算，比較，線形補間の対象）
+ * @tparam M: 長さ，内積，距離の計算に使用する先頭からの要素数（Pose2Dではx, yのみの2）
+**/
+template <class Derived, typename T, size_t N, size_t M = N>
+class VecBase
+{
+    static_assert(M <= N, "M must not exceed N");
+
+public:
+    using value_type = T;                  /**< 要素の型 */
+    static constexpr size_t SIZE = N;      /**< 要素数 */
+    static constexpr size_t DIMENSION = M; /**< 長さ，内積，距離の計算に使用する要素数 */
+
+    /**
+     * @brief 指定されたベクトルがこのベクトルと等しい場合にtrueを返す
+     * @param v: 指定するベクトル
+     */
+    constexpr bool equals(const Derived &v) const noexcept
+    {
+        return derived() == v;
+    }
+
+    /**
+     * @brief このベクトルの長さを返す
+     * @return このベクトルの長さ
+     */
+    T length() const
+    {
+        return magnitude();
+    }
+
+    /**
+     * @brief このベクトルの長さを返す
+     * @return このベクトルの長さ
+     */
+    T magnitude() const
+    {
+        return std::sqrt(sqrMagnitude());
+    }
+
+    /**
+     * @brief このベクトルの長さの2乘を返す
+     * @return このベクトルの長さ2乘
+     */
+    constexpr T sqrLength() const noexcept
+    {
+        return sqrMagnitude();
+    }
+
+    /**
+     * @brief このベクトルの長さの2乘を返す
+     * @return このベクトルの長さ2乘
+     */
+    constexpr T sqrMagnitude() const noexcept
+    {
+        return getDot(derived(), derived());
+    }
+
+    /**
+     * @brief 2つのベクトルの内積を返す
+     * @param a: 1つ目のベクトル
+     * @param b: 2つ目のベクトル
+     * @return 2つのベクトルの内積
+     */
+    static constexpr T getDot(const Derived &a, const Derived &b) noexcept
+    {
+        T sum = 0;
+        for (size_t i = 0; i < M; ++i)
+            sum += a[i] * b[i];
+        return sum;
+    }
+
+    /**
+     * @brief 2つのベクトルの外積の大きさを返す（2次元のみ）
+     * @param a: 1つ目のベクトル
+     * @param b: 2つ目のベクトル
+     * @return 2つのベクトルの外積の大きさ
+     */
+    static constexpr T getCross(const Derived &a, const Derived &b) noexcept
+    {
+        static_assert(M == 2, "getCross() returning a scalar is only defined for 2D vectors");
+        return a[0] * b[1] - a[1] * b[0];
+    }
+
+    /**
+     * @brief 2つのベクトルのなす角を弧度法で返す（2次元のみ）
+     * @param a: 1つ目のベクトル
+     * @param b: 2つ目のベクトル
+     * @return 2つのベクトルのなす角[rad]
+     */
+    static T getAngle(const Derived &a, const Derived &b)
+    {
+        static_assert(M == 2, "getAngle() is only defined for 2D vectors");
+        return std::atan2(b[1] - a[1], b[0] - a[0]);
+    }
+
+    /**
+     * @brief 2つのベクトルの距離の2乗を返す
+     * @param a: 1つ目のベクトル
+     * @param b: 2つ目のベクトル
+     * @return 2つのベクトルの距離の2乗
+     */
+    static constexpr T getSqrDistance(const Derived &a, const Derived &b) noexcept
+    {
+        T sum = 0;
+        for (size_t i = 0; i < M; ++i)
+            sum += (b[i] - a[i]) * (b[i] - a[i]);
+        return sum;
+    }
+
+    /**
+     * @brief 2つのベクトルの距離を返す
+     * @param a: 1つ目のベクトル
+     * @param b: 2つ目のベクトル
+     * @return 2つのベクトルの距離を返す
+     */
+    static T getDistance(const Derived &a, const Derived &b)
+    {
+        return std::sqrt(getSqrDistance(a, b));
+    }
+
+    /**
+     * @brief ベクトルaとbの間をtで線形補間
+     * @param a: 1つ目のベクトル
+     * @param b: 2つ目のベクトル
+     * @param t: 媒介変数（0～1に制限する）
+     * @return 補間点
+     */
+    static constexpr Derived lerp(const Derived &a, const Derived &b, T t) noexcept
+    {
+        t = t < 0 ? 0 : (t > 1 ? 1 : t);
+        Derived v = a;
+        for (size_t i = 0; i < N; ++i)
+            v[i] += (b[i] - a[i]) * t;
+        return v;
+    }
+
+    /**
+     * @brief ベクトルaとbの中点を返す
+     * @param a: 1つ目のベクトル
+     * @param b: 2つ目のベクトル
+     * @return 中点
+     */
+    static constexpr Derived getMidpoint(const Derived &a, const Derived &b) noexcept
+    {
+        return lerp(a, b, (T)0.5);
+    }
+
+    /**
+     * @brief 全ての要素にスカラ加算
+     */
+    constexpr Derived operator+() const noexcept
+    {
+        return derived();
+    }
+
+    /**
+     * @brief 全ての要素にスカラ減算
+     */
+    constexpr Derived operator-() const noexcept
+    {
+        Derived v = derived();
+        for (size_t i = 0; i < N; ++i)
+            v[i] = -v[i];
+        return v;
+    }
+
+    /**
+     * @brief ベクトルの要素同士の和
+     */
+    constexpr Derived operator+(const Derived &v) const noexcept
+    {
+        Derived r = derived();
+        r += v;
+        return r;
+    }
+
+    /**
+     * @brief ベクトルの要素同士の差
+     */
+    constexpr Derived operator-(const Derived &v) const noexcept
+    {
+        Derived r = derived();
+        r -= v;
+        return r;
+    }
+
+    /**
+     * @brief 全ての要素にスカラ乗算
+     * @attention ベクトル同士の乗算は未定義，内積の計算はgetDot()を使用
+     */
+    constexpr Derived operator*(T s) const noexcept
+    {
+        Derived r = derived();
+        r *= s;
+        return r;
+    }
+
+    /**
+     * @brief 全ての要素にスカラ除算
+     * @attention ベクトル同士の除算は未定義
+     */
+    constexpr Derived operator/(T s) const noexcept
+    {
+        Derived r = derived();
+        r /= s;
+        return r;
+    }
+
+    /**
+     * @brief ベクトルの要素同士の和を代入
+     */
+    constexpr Derived &operator+=(const Derived &v) noexcept
+    {
+        for (size_t i = 0; i < N; ++i)
+            derived()[i] += v[i];
+        return derived();
+    }
+
+    /**
+     * @brief ベクトルの要素同士の差を代入
+     */
+    constexpr Derived &operator-=(const Derived &v) noexcept
+    {
+        for (size_t i = 0; i < N; ++i)
+            derived()[i] -= v[i];
+        return derived();
+    }
+
+    /**
+     * @brief 全ての要素に対してスカラ乗算して代入（ベクトル同士の乗算は未定義）
+     */
+    constexpr Derived &operator*=(T s) noexcept
+    {
+        for (size_t i = 0; i < N; ++i)
+            derived()[i] *= s;
+        return derived();
+    }
+
+    /**
+     * @brief 全ての要素に対してスカラ除算して代入（ベクトル同士の除算は未定義）
+     */
+    constexpr Derived &operator/=(T s) noexcept
+    {
+        for (size_t i = 0; i < N; ++i)
+            derived()[i] /= s;
+        return derived();
+    }
+
+    /**
+     * @brief 2つのベクトルが等しい場合にtrueを返す
+     */
+    constexpr bool operator==(const Derived &v) const noexcept
+    {
+        for (size_t i = 0; i < N; ++i)
+            if (!(derived()[i] == v[i]))
+                return false;
+        return true;
+    }
+
+    /**
+     * @brief 2つのベクトルが等しい場合にfalseを返す
+     */
+    constexpr bool operator!=(const Derived &v) const noexcept
+    {
+        return !(derived() == v);
+    }
+
+protected:
+    constexpr const Derived &derived() const noexcept
+    {
+        return static_cast<const Derived &>(*this);
+    }
+
+    constexpr Derived &derived() noexcept
+    {
+        return static_cast<Derived &>(*this);
+    }
+};
+
+/**
+ * @brief 要素数が固定の汎用のベクトル
+ * @details 要素を配列で保持する．x, yなどの名前付きの要素が必要な場合はVector2, Pose2D, Vector3を使用する
+ * @code
+ * constexpr nut_ros::VecN<double, 4> a(1, 2, 3, 4);
+ * constexpr auto b = a * 2.0 - a; // コンパイル時に計算される
+ * @endcode
+**/
+template <typename T, size_t N>
+class VecN : public VecBase<VecN<T, N>, T, N>
+{
+public:
+    T data[N] = {}; /**< 要素 */
+
+    /**
+     * @brief コンストラクタ（全要素ゼロ）
+     */
+    constexpr VecN() = default;
+
+    /**
+     * @brief コンストラクタ 各要素の値で初期化
+     * @param values: N個の要素の値
+     */
+    template <typename... Args, typename std::enable_if<sizeof...(Args) == N && N != 0, int>::type = 0>
+    constexpr VecN(Args... values) noexcept : data{(T)values...}
+    {
+    }
+
+    /**
+     * @brief 要素を返す
+     * @param i: 要素の番号
+     * @return 要素
+     */
+    constexpr T &operator[](size_t i) noexcept
+    {
+        return data[i];
+    }
+
+    /**
+     * @brief 要素を返す
+     * @param i: 要素の番号
+     * @return 要素
+     */
+    constexpr const T &operator[](size_t i) const noexcept
+    {
+        return data[i];
+    }
+
+    /**
+     * @brief 要素数を返す
+     * @return 要素数
+     */
+    static constexpr size_t size() noexcept
+    {
+        return N;
+    }
+};
+
+template <typename Char, typename T, size_t N>
+inline std::basic_ostream<Char> &operator<<(std::basic_ostream<Char> &os, const VecN<T, N> &v)
+{
+    os << Char('(');
+    for (size_t i = 0; i < N; ++i)
+    {
+        if (i > 0)
+            os << Char(',') << Char(' ');
+        os << v[i];
+    }
+    return os << Char(')');
+}
+}
@@ -6,14 +6,20 @@
 **/
 #pragma once
 
-#include "./../nut_generic.h"
+#include "./../nut_generic_core.h"
+#include "./rotation_2D.h"
+#include "./vec_n.h"
 
 namespace nut_ros {
+template <typename T>
+class Transform2D;
+
 /**
  * @brief 2要素のベクトル
+ * @details 四則演算，比較，長さ，内積，外積，距離，線形補間はVecBaseで実装する
 **/
 template <typename T>
-class Vector2
+class Vector2 : public VecBase<Vector2<T>, T, 2>
 {
 public:
     T x = 0; /**< 2次元直交座標におけるx成分 */
@@ -30,12 +36,23 @@ public:
     constexpr Vector2(T _x, T _y) : x(_x), y(_y) {}
 
     /**
-     * @brief 指定されたベクトルがこのベクトルと等しい場合にtrueを返す
-     * @param v: 指定するベクトル
+     * @brief 要素を返す
+     * @param i: 要素の番号（0: x, 1: y）
+     * @return 要素
+     */
+    constexpr T &operator[](size_t i) noexcept
+    {
+        return i == 0 ? x : y;
+    }
+
+    /**
+     * @brief 要素を返す
+     * @param i: 要素の番号（0: x, 1: y）
+     * @return 要素
      */
-    bool equals(const Vector2 &v)
+    constexpr const T &operator[](size_t i) const noexcept
     {
-        return *this == v;
+        return i == 0 ? x : y;
     }
 
     /**
@@ -43,7 +60,7 @@ public:
      */
     void normalize()
     {
-        *this /= length();
+        *this /= this->length();
     }
 
     /**
@@ -73,8 +90,16 @@ public:
      */
     void rotate(T angle)
     {
-        x = x * cos(angle) - y * sin(angle);
-        y = x * sin(angle) + y * cos(angle);
+        rotate(Rotation2D<T>(angle));
+    }
+
+    /**
+     * @brief このベクトルを原点中心に回転
+     * @param rotation: 回転（cos, sinは計算済みのものを使用）
+     */
+    void rotate(const Rotation2D<T> &rotation)
+    {
+        rotation.apply(x, y);
     }
 
     /**
@@ -94,41 +119,41 @@ public:
      * @param o: 回転中心の座標
      * @param angle: 回転させる角度[rad]
      */
-    void rotate(Vector2 o, T angle)
+    void rotate(const Vector2 &o, T angle)
     {
-        Vector2 p(x - o.x, y - o.y);
-        p.rotate(angle);
-        p.x += o.x;
-        p.y += o.y;
-        x = p.x;
-        y = p.y;
+        rotate(o, Rotation2D<T>(angle));
     }
 
     /**
-     * @brief このベクターをフォーマットした文字列を返す
-     * @return フォーマットした文字列
+     * @brief 座標oを中心に回転
+     * @param o: 回転中心の座標
+     * @param rotation: 回転（cos, sinは計算済みのものを使用）
      */
-    std::string toString()
+    void rotate(const Vector2 &o, const Rotation2D<T> &rotation)
     {
-        return '(' + std::to_string(x) + ", " + std::to_string(y) + ')';
+        x -= o.x;
+        y -= o.y;
+        rotation.apply(x, y);
+        x += o.x;
+        y += o.y;
     }
 
     /**
-     * @brief このベクトルの長さを返す
-     * @return このベクトルの長さ
+     * @brief このベクトルを剛体変換（回転した後に平行移動）
+     * @param tf: 剛体変換（vector/transform_2D.h）
      */
-    T length() const
+    void transform(const Transform2D<T> &tf)
     {
-        return magnitude();
+        tf.apply(x, y);
     }
 
     /**
-     * @brief このベクトルの長さを返す
-     * @return このベクトルの長さ
+     * @brief このベクターをフォーマットした文字列を返す
+     * @return フォーマットした文字列
      */
-    T magnitude() const
+    std::string toString()
     {
-        return std::sqrt(sqrMagnitude());
+        return '(' + std::to_string(x) + ", " + std::to_string(y) + ')';
     }
 
     /**
@@ -137,86 +162,7 @@ public:
      */
     Vector2 normalized() const
     {
-        return *this / length();
-    }
-
-    /**
-     * @brief このベクトルの長さの2乘を返す
-     * @return このベクトルの長さ2乘
-     */
-    constexpr T sqrLength() const
-    {
-        return sqrMagnitude();
-    }
-
-    /**
-     * @brief このベクトルの長さの2乘を返す
-     * @return このベクトルの長さ2乘
-     */
-    constexpr T sqrMagnitude() const
-    {
-        return x * x + y * y;
-    }
-
-    /**
-     * @brief 2つのベクトルの内積を返す
-     * @param a: 1つ目のベクトル
-     * @param b: 2つ目のベクトル
-     * @return 2つのベクトルの内積
-     */
-    static T getDot(Vector2 a, Vector2 b)
-    {
-        return (a.x * b.x + a.y * b.y);
-    }
-
-    /**
-     * @brief 2つのベクトルの外積の大きさを返す
-     * @param a: 1つ目のベクトル
-     * @param b: 2つ目のベクトル
-     * @return 2つのベクトルの外積の大きさ
-     */
-    static T getCross(Vector2 a, Vector2 b)
-    {
-        return (a.x * b.y - a.y * b.x);
-    }
-
-    /**
-     * @brief 2つのベクトルのなす角を弧度法で返す
-     * @param a: 1つ目のベクトル
-     * @param b: 2つ目のベクトル
-     * @return 2つのベクトルのなす角[rad]
-     */
-    static T getAngle(Vector2 a, Vector2 b)
-    {
-        return std::atan2(b.y - a.y, b.x - a.x);
-    }
-
-    /**
-     * @brief 2つのベクトルの距離を返す
-     * @param a: 1つ目のベクトル
-     * @param b: 2つ目のベクトル
-     * @return 2つのベクトルの距離を返す
-     */
-    static T getDistance(Vector2 a, Vector2 b)
-    {
-        Vector2 v = (b - a);
-        return v.magnitude();
-    }
-
-    /**
-     * @brief ベクトルaとbの間をtで線形補間
-     * @param a: 1つ目のベクトル
-     * @param b: 2つ目のベクトル
-     * @param t: 媒介変数
-     * @return 補間点
-     */
-    static Vector2 lerp(Vector2 a, Vector2 b, T t)
-    {
-        t = Generic::guard(t, 0.0, 1.0);
-        Vector2 v = a;
-        v.x += (b.x - a.x) * t;
-        v.y += (b.y - a.y) * t;
-        return v;
+        return *this / this->length();
     }
 
     /**
@@ -229,112 +175,6 @@ public:
         return *this;
     }
 
-    /**
-     * @brief 全ての要素にスカラ加算
-     */
-    constexpr Vector2 operator+() const
-    {
-        return *this;
-    }
-
-    /**
-     * @brief 全ての要素にスカラ減算
-     */
-    constexpr Vector2 operator-() const
-    {
-        return {-x, -y};
-    }
-
-    /**
-     * @brief ベクトルの要素同士の和
-     */
-    constexpr Vector2 operator+(const Vector2 &v) const
-    {
-        return {x + v.x, y + v.y};
-    }
-
-    /**
-     * @brief ベクトルの要素同士の差
-     */
-    constexpr Vector2 operator-(const Vector2 &v) const
-    {
-        return {x - v.x, y - v.y};
-    }
-
-    /**
-     * @brief 全ての要素にスカラ乗算
-     * @attention ベクトル同士の乗算は未定義，内積の計算はgetDot()を使用
-     */
-    constexpr Vector2 operator*(T s) const
-    {
-        return {x * s, y * s};
-    }
-
-    /**
-     * @brief 全ての要素にスカラ除算
-     * @attention ベクトル同士の除算は未定義
-     */
-    constexpr Vector2 operator/(T s) const
-    {
-        return {x / s, y / s};
-    }
-
-    /**
-     * @brief ベクトルの要素同士の和を代入（スカラとの和の場合は全ての要素に対して加算）
-     */
-    Vector2 &operator+=(const Vector2 &v)
-    {
-        x += v.x;
-        y += v.y;
-        return *this;
-    }
-
-    /**
-     * @brief ベクトルの要素同士の差を代入（スカラとの和の場合は全ての要素に対して減算）
-     */
-    Vector2 &operator-=(const Vector2 &v)
-    {
-        x -= v.x;
-        y -= v.y;
-        return *this;
-    }
-
-    /**
-     * @brief 全ての要素に対してスカラ乗算して代入（ベクトル同士の乗算は未定義）
-     */
-    Vector2 &operator*=(T s)
-    {
-        x *= s;
-        y *= s;
-        return *this;
-    }
-
-    /**
-     * @brief 全ての要素に対してスカラ除算して代入（ベクトル同士の除算は未定義）
-     */
-    Vector2 &operator/=(T s)
-    {
-        x /= s;
-        y /= s;
-        return *this;
-    }
-
-    /**
-     * @brief 2つのベクトルが等しい場合にtrueを返す
-     */
-    bool operator==(const Vector2 &v) const
-    {
-        return (x == v.x && (y == v.y));
-    }
-
-    /**
-     * @brief 2つのベクトルが等しい場合にfalseを返す
-     */
-    bool operator!=(const Vector2 &v) const
-    {
-        return !(x == v.x && (y == v.y));
-    }
-
 private:
 };
 
@@ -0,0 +1,116 @@
+/**
+ * @file vector3.h
+ * @brief 3要素のベクトル
+**/
+#pragma once
+
+#include "./../nut_generic_core.h"
+#include "./vec_n.h"
+
+namespace nut_ros {
+/**
+ * @brief 3要素のベクトル
+ * @details 四則演算，比較，長さ，内積，距離，線形補間はVecBaseで実装する（外積はベクトルを返す）
+**/
+template <typename T>
+class Vector3 : public VecBase<Vector3<T>, T, 3>
+{
+public:
+    T x = 0; /**< 3次元直交座標におけるx成分 */
+    T y = 0; /**< 3次元直交座標におけるy成分 */
+    T z = 0; /**< 3次元直交座標におけるz成分 */
+
+    /**
+     * @brief コンストラクタ
+     */
+    constexpr Vector3() = default;
+
+    /**
+     * @brief コンストラクタ 直交座標(_x, _y, _z)で初期化
+     */
+    constexpr Vector3(T _x, T _y, T _z) : x(_x), y(_y), z(_z) {}
+
+    /**
+     * @brief 要素を返す
+     * @param i: 要素の番号（0: x, 1: y, 2: z）
+     * @return 要素
+     */
+    constexpr T &operator[](size_t i) noexcept
+    {
+        return i == 0 ? x : (i == 1 ? y : z);
+    }
+
+    /**
+     * @brief 要素を返す
+     * @param i: 要素の番号（0: x, 1: y, 2: z）
+     * @return 要素
+     */
+    constexpr const T &operator[](size_t i) const noexcept
+    {
+        return i == 0 ? x : (i == 1 ? y : z);
+    }
+
+    /**
+     * @brief 直交座標形式でこのベクトルを設定
+     * @param _x: x成分
+     * @param _y: y成分
+     * @param _z: z成分
+     */
+    void set(T _x, T _y, T _z)
+    {
+        x = _x;
+        y = _y;
+        z = _z;
+    }
+
+    /**
+     * @brief このベクトルの大きさを1にする
+     */
+    void normalize()
+    {
+        *this /= this->length();
+    }
+
+    /**
+     * @brief 大きさが1のこのベクトルを返す
+     * @return 大きさが1のこのベクトル
+     */
+    Vector3 normalized() const
+    {
+        return *this / this->length();
+    }
+
+    /**
+     * @brief このベクターをフォーマットした文字列を返す
+     * @return フォーマットした文字列
+     */
+    std::string toString() const
+    {
+        return '(' + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ')';
+    }
+
+    /**
+     * @brief 2つのベクトルの外積を返す
+     * @param a: 1つ目のベクトル
+     * @param b: 2つ目のベクトル
+     * @return 2つのベクトルの外積
+     */
+    static constexpr Vector3 getCross(const Vector3 &a, const Vector3 &b) noexcept
+    {
+        return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    }
+};
+
+template <typename Char, typename T>
+inline std::basic_ostream<Char> &operator<<(std::basic_ostream<Char> &os, const Vector3<T> &v)
+{
+    return os << Char('(') << v.x << Char(',') << Char(' ') << v.y << Char(',') << Char(' ') << v.z << Char(')');
+}
+
+template <typename Char, typename T>
+inline std::basic_istream<Char> &operator>>(std::basic_istream<Char> &is, Vector3<T> &v)
+{
+    Char unused;
+    return is >> unused >> v.x >> unused >> v.y >> unused >> v.z >> unused;
+}
+}